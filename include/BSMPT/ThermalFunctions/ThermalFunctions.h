@@ -12,6 +12,7 @@
 #define INCLUDE_BSMPT_THERMALFUNCTIONS_THERMALFUNCTIONS_H_
 
 #include <BSMPT/utility/spline/spline.h>
+#include <Eigen/Dense>
 namespace BSMPT
 {
 namespace ThermalFunctions
@@ -71,27 +72,38 @@ double JbosonNumericalIntegration(const double &x, int diff = 0);
  * c.f. Eq. (2.38) in the manual
  * @param x The ratio m^2/T^2
  * @param n The order of the taylor expansion
- * @param diff Returns the expansion for diff = 0 and its derivative for diff =
- * 1
+ * @param diff Returns the expansion for diff = 0, its first derivative for diff
+ * = 1 and its second derivative for diff = 2. The second derivative diverges
+ * for x -> 0.
  */
 double JbosonInterpolatedLow(const double &x, const int &n, int diff = 0);
 /**
  * Using linear interpolation with data points to interpolate the thermal
  * integral for bosons for x=m^2/T^2 < 0
  * @param x The ratio m^2/T^2
- * @param diff Returns the interpolation of J_- for diff = 0 and for dJ_-/dx for
- * diff = 1
+ * @param diff Returns the interpolation of J_- for diff = 0, dJ_-/dx for diff =
+ * 1 and d^2J_-/dx^2 for diff = 2
  */
 double JbosonInterpolatedNegative(const double &x, int diff = 0);
 
 /**
  * Puts together the separate interpolations for J_-
  * @param x The ratio m^2/T^2
- * @param diff Returns the interpolation of J_- for diff = 0 and for dJ_-/dx for
- * diff = 1
+ * @param diff Returns the interpolation of J_- for diff = 0, dJ_-/dx for diff =
+ * 1 and d^2J_-/dx^2 for diff = 2. The derivatives are those of the
+ * interpolation itself, so they are consistent with the value for diff = 0.
  */
 double JbosonInterpolated(const double &x, int diff = 0);
 
+/**
+ * Evaluates JbosonInterpolated(x) for all entries of x. The expansions for x
+ * >= 0 are evaluated as array expressions over all entries, only the entries
+ * with x < 0 are looked up one by one in the spline.
+ * @param x The ratios m^2/T^2
+ * @return J_- for each entry of x
+ */
+Eigen::ArrayXd JbosonInterpolatedBatch(const Eigen::ArrayXd &x);
+
 /**
  * Integrand of the thermic integral for the fermions \f$ J_+(x) =
  * \int\limits_{0}^{\infty} \,\mathrm{d}k \, k^2 \log\left[ 1 + \exp\left(
@@ -119,18 +131,27 @@ double JfermionNumericalIntegration(const double &x, int diff = 0);
  * see J_{+,s} in Eq. (2.37) in the manual
  * @param x The ratio m^2/T^2
  * @param n The order of the taylor expansion
- * @param diff Returns the expansion for diff = 0 and dJ_+/dx for diff = 1
+ * @param diff Returns the expansion for diff = 0, dJ_+/dx for diff = 1 and
+ * d^2J_+/dx^2 for diff = 2. The second derivative diverges for x -> 0.
  */
 double JfermionInterpolatedLow(const double &x, const int &n, int diff = 0);
 /**
  * Puts together the separate interpolations for J_+, see Eq. (2.44) in the
  * manual
  * @param x The ratio m^2/T^2
- * @param diff Returns the interpolation of J_+ for diff = 0 and dJ_+/dx for
- * diff = 1
+ * @param diff Returns the interpolation of J_+ for diff = 0, dJ_+/dx for diff =
+ * 1 and d^2J_+/dx^2 for diff = 2. The derivatives are those of the
+ * interpolation itself, so they are consistent with the value for diff = 0.
  */
 double JfermionInterpolated(const double &x, int diff = 0);
 
+/**
+ * Evaluates JfermionInterpolated(x) for all entries of x as array expressions
+ * @param x The ratios m^2/T^2
+ * @return J_+ for each entry of x
+ */
+Eigen::ArrayXd JfermionInterpolatedBatch(const Eigen::ArrayXd &x);
+
 /**
  * Expansion for large x = m^2/T^2 of the thermal integrals, \f$ J_{\pm,l}(x,n)
  * = -\exp\left(x^{1/2}\right) \left( \frac{\pi}{2} x^{3/2} \right)^{1/2}
@@ -138,8 +159,8 @@ double JfermionInterpolated(const double &x, int diff = 0);
  * x^{-l/2} \f$, cf. Eq. (2.41) in the manual
  * @param x The ratio m^2/T^2
  * @param n The order of the expansion
- * @param diff Returns the expansion for diff = 0 and for its derivative for
- * diff = 1
+ * @param diff Returns the expansion for diff = 0, its first derivative for diff
+ * = 1 and its second derivative for diff = 2
  */
 double JInterpolatedHigh(const double &x, const int &n, int diff = 0);
 
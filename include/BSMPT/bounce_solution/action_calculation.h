@@ -311,6 +311,27 @@ public:
       double T_In,
       int MaxPathIntegrations_in);
 
+  /**
+   * @brief Construct a new Bounce Action Int object
+   *
+   * @param init_path is the initial path guess
+   * @param TrueVacuumIn is the true vacuum candidate of the potential
+   * @param FalseVacuumIn is the false vacuum
+   * @param V is the class potential
+   * @param dV is the class gradient
+   * @param Hessian is the class Hessian
+   */
+  BounceActionInt(
+      std::vector<std::vector<double>> InitPath_In,
+      std::vector<double> TrueVacuum_In,
+      std::vector<double> FalseVacuum_In,
+      std::function<double(std::vector<double>)> &V_In,
+      std::function<std::vector<double>(std::vector<double>)> &dV_In,
+      std::function<std::vector<std::vector<double>>(std::vector<double>)>
+          &Hessian_In,
+      double T_In,
+      int MaxPathIntegrations_in);
+
   /**
    * @brief Construct a new Bounce Action Int object
    *
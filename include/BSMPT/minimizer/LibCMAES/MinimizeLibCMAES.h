@@ -20,6 +20,7 @@ class Class_Potential_Origin;
 namespace Minimizer
 {
 struct PointerContainerMinPlane;
+class MinimizerBudgetTracker;
 namespace LibCMAES
 {
 
@@ -32,15 +33,65 @@ struct LibCMAESReturn
   int CMAESStatus;
 };
 
+/**
+ * @brief The CMAESRestartStrategy enum decides if and how CMA-ES is restarted
+ * after it converged
+ */
+enum class CMAESRestartStrategy
+{
+  /**
+   * @brief None single run with the default population size
+   */
+  None,
+  /**
+   * @brief IPOP restarts with doubled population size
+   */
+  IPOP,
+  /**
+   * @brief BIPOP alternates between restarts with doubled population size and
+   * restarts with small populations and step sizes, giving both regimes the
+   * same number of evaluations
+   */
+  BIPOP
+};
+
+/**
+ * @brief The LibCMAESSettings struct collects the settings of
+ * min_cmaes_gen_all
+ */
+struct LibCMAESSettings
+{
+  /**
+   * @brief ParallelPopulation The candidates of each generation are always
+   * evaluated together with VEffBatch. If set they are split into one batch
+   * per thread of the global thread pool.
+   */
+  bool ParallelPopulation{true};
+  /**
+   * @brief Restarts restart strategy after the first run
+   */
+  CMAESRestartStrategy Restarts{CMAESRestartStrategy::None};
+  /**
+   * @brief MaxRestarts number of restarts for IPOP and BIPOP
+   */
+  int MaxRestarts{9};
+};
+
 /**
  * Calculating the global minimum with libcmaes in the 2HDM for the parameter
  * point par and counterterms parCT and write the solution in sol. The initial
  * guess is given in start.
+ * @param Settings parallel evaluation and restart strategy
+ * @param Budget limits the evaluations and the time, nullptr for no limit.
+ * Once it is exhausted the best candidate found so far is returned.
  * @return the libcmaes run_status of the system
  */
-LibCMAESReturn min_cmaes_gen_all(const Class_Potential_Origin &model,
-                                 const double &Temp,
-                                 const std::vector<double> &VevMinimum);
+LibCMAESReturn
+min_cmaes_gen_all(const Class_Potential_Origin &model,
+                  const double &Temp,
+                  const std::vector<double> &VevMinimum,
+                  const LibCMAESSettings &Settings = LibCMAESSettings(),
+                  MinimizerBudgetTracker *Budget   = nullptr);
 
 /**
  * Finds a candidate for the local minimum using the CMAES algorithm.
@@ -6,6 +6,7 @@
 #ifndef MINIMIZENLOPT_H
 #define MINIMIZENLOPT_H
 
+#include <BSMPT/minimizer/MinimizerBudget.h>
 #include <memory>
 #include <nlopt.hpp>
 #include <vector>
@@ -31,10 +32,16 @@ struct ShareInformationNLOPT
 {
   const Class_Potential_Origin &model;
   double Temp;
+  /**
+   * @brief Budget counts the evaluations, nullptr for no limit
+   */
+  MinimizerBudgetTracker *Budget{nullptr};
   ShareInformationNLOPT(const Class_Potential_Origin &modelIn,
-                        const double &TempIn)
+                        const double &TempIn,
+                        MinimizerBudgetTracker *BudgetIn = nullptr)
       : model{modelIn}
       , Temp{TempIn}
+      , Budget{BudgetIn}
   {
   }
 };
@@ -79,11 +86,15 @@ NLOPTVEff(const std::vector<double> &x, std::vector<double> &grad, void *data);
  * LN_COBYLA algorithm
  * @param model model reference
  * @param Temp Temperature at which the potential should be minimized
+ * @param Budget replaces the default limit of 1000 evaluations and the
+ * tolerance if set. If it is exhausted the best point found so far is returned
+ * as a successful result.
  * @return A ShareInformationNLOPT with the global minimum, the potential value
  * and the nlopt::result of the minimization
  */
 NLOPTReturnType MinimizeUsingNLOPT(const Class_Potential_Origin &model,
-                                   const double &Temp);
+                                   const double &Temp,
+                                   MinimizerBudgetTracker *Budget = nullptr);
 
 /**
  * @brief MinimizePlaneUsingNLOPT minimizes the effective potential in a given
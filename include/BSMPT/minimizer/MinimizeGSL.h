@@ -11,6 +11,8 @@
 #ifndef MINIMIZEGSL_H_
 #define MINIMIZEGSL_H_
 
+#include <BSMPT/minimizer/MinimizerBudget.h>
+#include <Eigen/Dense>
 #include <cmath>
 #include <gsl/gsl_vector_double.h> // for gsl_vector
 #include <memory>
@@ -27,6 +29,110 @@ namespace Minimizer
  */
 const double GSL_Tolerance = std::pow(10, -4);
 
+/**
+ * @brief The GSLSeedingStrategy enum decides how the starting points of the
+ * local minimizations in GSL_Minimize_gen_all are generated
+ */
+enum class GSLSeedingStrategy
+{
+  /**
+   * @brief Random uniformly distributed random points
+   */
+  Random,
+  /**
+   * @brief Halton Halton sequence, randomly shifted with the seed
+   */
+  Halton,
+  /**
+   * @brief Sobol Sobol sequence, randomly shifted with the seed. Falls back to
+   * the Halton sequence above 40 dimensions
+   */
+  Sobol
+};
+
+/**
+ * @brief The GSL_MultistartOptions struct collects the options for the
+ * starting points of GSL_Minimize_gen_all and for the clustering of its
+ * solutions. The warm starts, the tree-level vacuum and its symmetry images are
+ * tried before the generated points.
+ */
+struct GSL_MultistartOptions
+{
+  /**
+   * @brief Strategy used to generate the starting points in [-500, 500]^nVEV
+   */
+  GSLSeedingStrategy Strategy{GSLSeedingStrategy::Random};
+  /**
+   * @brief WarmStarts starting points in the minimizer (VEV) dimension, e.g.
+   * the minima found at the previous temperature
+   */
+  std::vector<std::vector<double>> WarmStarts;
+  /**
+   * @brief UseTreeLevelVacuum Start from the tree-level vacuum and its images
+   * under SymmetryElements
+   */
+  bool UseTreeLevelVacuum{false};
+  /**
+   * @brief SymmetryElements discrete symmetries of the potential acting on the
+   * VEV dimension, see MinimumTracer::GroupElements
+   */
+  std::vector<Eigen::MatrixXd> SymmetryElements;
+  /**
+   * @brief ClusterMinima Merge solutions which are closer than BasinTolerance
+   * to an already found minimum or one of its images under SymmetryElements.
+   * MaxSol then counts the distinct minima.
+   */
+  bool ClusterMinima{false};
+  /**
+   * @brief BasinTolerance distance in GeV below which two solutions belong to
+   * the same minimum
+   */
+  double BasinTolerance{1};
+  /**
+   * @brief MaxStartsWithoutNewMinimum Stop after this number of consecutive
+   * starting points which did not give a new minimum, 0 disables the check
+   */
+  std::size_t MaxStartsWithoutNewMinimum{0};
+  /**
+   * @brief DeterministicOrder Process the solutions in the order of their
+   * starting points, so that the result does not depend on the number of
+   * threads. Otherwise they are processed in the order in which they finish,
+   * which avoids waiting for slow local minimizations.
+   */
+  bool DeterministicOrder{true};
+};
+
+/**
+ * @brief GSL_MinimumDistance calculates the distance between two minima modulo
+ * the discrete symmetries of the potential
+ * @param a first minimum in the VEV dimension
+ * @param b second minimum in the VEV dimension
+ * @param SymmetryElements discrete symmetries acting on the VEV dimension
+ * @return smallest distance between b and a or one of its images
+ */
+double
+GSL_MinimumDistance(const std::vector<double> &a,
+                    const std::vector<double> &b,
+                    const std::vector<Eigen::MatrixXd> &SymmetryElements);
+
+/**
+ * @brief GSL_StartingPoints generates the starting points of
+ * GSL_Minimize_gen_all. The result only depends on the arguments, not on the
+ * number of threads used for the minimization.
+ * @param model model reference
+ * @param seed seed for the random points or the random shift of the
+ * low-discrepancy sequences
+ * @param Multistart options of the multistart
+ * @param NumberOfPoints number of generated points, the warm starts and the
+ * tree-level vacuum with its images are added in front of them
+ * @return list of starting points in the minimizer (VEV) dimension
+ */
+std::vector<std::vector<double>>
+GSL_StartingPoints(const Class_Potential_Origin &model,
+                   const int &seed,
+                   const GSL_MultistartOptions &Multistart,
+                   const std::size_t &NumberOfPoints);
+
 /**
  * struct containing the required Parameters of the model for the gsl interface
  */
@@ -34,9 +140,24 @@ struct GSL_params
 {
   const Class_Potential_Origin &model;
   double Temp;
-  GSL_params(const Class_Potential_Origin &modelIN, const double &temperature)
+  /**
+   * @brief UseGradient Use GSL_Minimize_Gradient_From_S_gen_all instead of
+   * GSL_Minimize_From_S_gen_all for the local minimizations
+   */
+  bool UseGradient{false};
+  /**
+   * @brief Budget counts the evaluations of the potential and stops the local
+   * minimizations once it is exhausted, nullptr for no limit
+   */
+  MinimizerBudgetTracker *Budget{nullptr};
+  GSL_params(const Class_Potential_Origin &modelIN,
+             const double &temperature,
+             bool UseGradientIN              = false,
+             MinimizerBudgetTracker *BudgetIN = nullptr)
       : model{modelIN}
-      , Temp{temperature} {};
+      , Temp{temperature}
+      , UseGradient{UseGradientIN}
+      , Budget{BudgetIN} {};
 };
 
 /**
@@ -45,14 +166,41 @@ struct GSL_params
  */
 double GSL_VEFF_gen_all(const gsl_vector *v, void *p);
 
+/**
+ * Calculates the gradient of the effective potential w.r.t. the vevs at the
+ * vev v and temperature p->Temp for the gsl interface
+ */
+void GSL_VEFF_Gradient_gen_all(const gsl_vector *v, void *p, gsl_vector *df);
+
+/**
+ * Calculates the value and the gradient of the effective potential at the vev
+ * v and temperature p->Temp for the gsl interface
+ */
+void GSL_VEFF_fdf_gen_all(const gsl_vector *v,
+                          void *p,
+                          double *f,
+                          gsl_vector *df);
+
 /**
  * Calculates the next local minimum in the model from the point start
- * @returns The final status of the gsl minimization process.
+ * @returns The final status of the gsl minimization process. If the budget of
+ * p ran out it is GSL_CONTINUE and sol is the last point of the simplex.
  */
 int GSL_Minimize_From_S_gen_all(struct GSL_params &p,
                                 std::vector<double> &sol,
                                 const std::vector<double> &start);
 
+/**
+ * Calculates the next local minimum in the model from the point start with the
+ * BFGS algorithm of gsl, using the analytic gradient of the effective
+ * potential
+ * @returns The final status of the gsl minimization process. If the budget of
+ * p ran out it is GSL_CONTINUE and sol is the last point of the line search.
+ */
+int GSL_Minimize_Gradient_From_S_gen_all(struct GSL_params &p,
+                                         std::vector<double> &sol,
+                                         const std::vector<double> &start);
+
 /**
  * Minimize the Potential from different random starting points and choose the
  * local minimum with the deepest potential value as the candidate for the
@@ -63,6 +211,8 @@ int GSL_Minimize_From_S_gen_all(struct GSL_params &p,
  * optimisations
  * @param UseMultiThreading Decides if the algorithm should use multithreading
  * or not
+ * @param UseGradient Use the gradient based BFGS algorithm for the local
+ * minimizations instead of the Nelder-Mead simplex
  * @return first: vector with candidate for the global minimum, second: True if
  * a candidate for the global minimum is found and false otherwise
  */
@@ -70,7 +220,8 @@ std::pair<std::vector<double>, bool>
 GSL_Minimize_gen_all(const Class_Potential_Origin &model,
                      const double &Temp,
                      const int &seed,
-                     bool UseMultiThreading = true);
+                     bool UseMultiThreading = true,
+                     bool UseGradient       = false);
 
 /**
  * Minimize the Potential from different random starting points and choose the
@@ -83,6 +234,8 @@ GSL_Minimize_gen_all(const Class_Potential_Origin &model,
  * @param MaxSol numbers of local minima to find
  * @param UseMultiThreading Decides if the algorithm should use multithreading
  * or not
+ * @param UseGradient Use the gradient based BFGS algorithm for the local
+ * minimizations instead of the Nelder-Mead simplex
  * @return first: vector with candidate for the global minimum, second: True if
  * a candidate for the global minimum is found and false otherwise
  */
@@ -91,7 +244,8 @@ GSL_Minimize_gen_all(const Class_Potential_Origin &model,
                      const double &Temp,
                      const int &seed,
                      const std::size_t &MaxSol,
-                     bool UseMultiThreading = true);
+                     bool UseMultiThreading = true,
+                     bool UseGradient       = false);
 
 /**
  * Minimize the Potential from different random starting points and choose the
@@ -105,6 +259,45 @@ GSL_Minimize_gen_all(const Class_Potential_Origin &model,
  * @param MaxSol numbers of local minima to find
  * @param UseMultiThreading Decides if the algorithm should use multithreading
  * or not
+ * @param UseGradient Use the gradient based BFGS algorithm for the local
+ * minimizations instead of the Nelder-Mead simplex
+ * @return first: vector with the solution, second: True if a candidate for the
+ * global minimum is found and false otherwise
+ */
+std::pair<std::vector<double>, bool>
+GSL_Minimize_gen_all(const Class_Potential_Origin &model,
+                     const double &Temp,
+                     const int &seed,
+                     std::vector<std::vector<double>> &saveAllMinima,
+                     const std::size_t &MaxSol,
+                     bool UseMultiThreading = true,
+                     bool UseGradient       = false);
+
+/**
+ * Minimize the Potential from the starting points given by Multistart and
+ * choose the local minimum with the deepest potential value as the candidate
+ * for the global minimum. The threads take the starting points from a shared
+ * atomic index and write the solutions into separate slots, see
+ * GSL_MultistartOptions::DeterministicOrder for the order of the results.
+ * @param model model reference
+ * @param Temp Temperature at which to minimise the parameter point
+ * @param seed seed used to find the starting points for the local
+ * optimisations
+ * @param Multistart strategy for the starting points, additional warm starts
+ * and the clustering of the solutions
+ * @param saveAllMinima List of all local minima. Each row contains the minimum,
+ * its EWSB VEV, the potential value and the number of solutions merged into
+ * the minimum.
+ * @param MaxSol numbers of local minima to find, distinct ones if
+ * Multistart.ClusterMinima is set
+ * @param UseMultiThreading Decides if the algorithm should use multithreading
+ * or not
+ * @param UseGradient Use the gradient based BFGS algorithm for the local
+ * minimizations instead of the Nelder-Mead simplex
+ * @param Budget limits the number of evaluations and the time, nullptr for no
+ * limit. Once it is exhausted no further starts are minimized and the
+ * interrupted local minimizations contribute their last point, so the result
+ * is the best point found so far.
  * @return first: vector with the solution, second: True if a candidate for the
  * global minimum is found and false otherwise
  */
@@ -112,9 +305,12 @@ std::pair<std::vector<double>, bool>
 GSL_Minimize_gen_all(const Class_Potential_Origin &model,
                      const double &Temp,
                      const int &seed,
+                     const GSL_MultistartOptions &Multistart,
                      std::vector<std::vector<double>> &saveAllMinima,
                      const std::size_t &MaxSol,
-                     bool UseMultiThreading = true);
+                     bool UseMultiThreading          = true,
+                     bool UseGradient                = false,
+                     MinimizerBudgetTracker *Budget = nullptr);
 
 } // namespace Minimizer
 } // namespace BSMPT
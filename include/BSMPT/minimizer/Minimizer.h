@@ -12,9 +12,10 @@
 #define MINIMIZER_H_
 
 #include <BSMPT/config.h>
+#include <BSMPT/minimizer/MinimizeGSL.h>
+#include <BSMPT/minimizer/StationaryPoint.h>
 #include <BSMPT/models/IncludeAllModels.h>
 #include <memory>
-#include <thread>
 #include <vector> // for vector
 
 namespace BSMPT
@@ -48,7 +49,11 @@ const bool UseNLoptDefault = true;
 const bool UseNLoptDefault = false;
 #endif
 
-const std::size_t Num_threads = std::thread::hardware_concurrency();
+/**
+ * @brief UseGSLGradientDefault Use the GSL minimizer with the analytic gradient
+ * of the effective potential in the default settings
+ */
+const bool UseGSLGradientDefault = false;
 
 /**
  * @brief CalcWhichMinimizer Calculates the WhichMinimizer value with the given
@@ -56,14 +61,17 @@ const std::size_t Num_threads = std::thread::hardware_concurrency();
  * @param UseGSL Should GSL be used?
  * @param UseCMAES Should CMAES be used?
  * @param UseNLopt Should NLopt be used?
+ * @param UseGSLGradient Should GSL use the BFGS algorithm with the analytic
+ * gradient instead of the Nelder-Mead simplex?
  * @return
  */
-constexpr int CalcWhichMinimizer(bool UseGSL   = UseGSLDefault,
-                                 bool UseCMAES = UseLibCMAESDefault,
-                                 bool UseNLopt = UseNLoptDefault)
+constexpr int CalcWhichMinimizer(bool UseGSL         = UseGSLDefault,
+                                 bool UseCMAES       = UseLibCMAESDefault,
+                                 bool UseNLopt       = UseNLoptDefault,
+                                 bool UseGSLGradient = UseGSLGradientDefault)
 {
   return static_cast<int>(UseCMAES) + 2 * static_cast<int>(UseGSL) +
-         4 * static_cast<int>(UseNLopt);
+         4 * static_cast<int>(UseNLopt) + 8 * static_cast<int>(UseGSLGradient);
 }
 
 /**
@@ -74,10 +82,15 @@ struct MinimizersToUse
   bool UseCMAES{UseLibCMAESDefault};
   bool UseGSL{UseGSLDefault};
   bool UseNLopt{UseNLoptDefault};
-  MinimizersToUse(bool useCMAES, bool useGSL, bool useNLopt)
+  bool UseGSLGradient{UseGSLGradientDefault};
+  MinimizersToUse(bool useCMAES,
+                  bool useGSL,
+                  bool useNLopt,
+                  bool useGSLGradient = UseGSLGradientDefault)
       : UseCMAES{useCMAES}
       , UseGSL{useGSL}
       , UseNLopt{useNLopt}
+      , UseGSLGradient{useGSLGradient}
   {
   }
 };
@@ -101,6 +114,12 @@ constexpr int WhichMinimizerDefault = CalcWhichMinimizer();
  * a given Temperature Temp and writes the solution in the std::vector sol. The
  * Minimization Debugging Options are written in the std::vector Check. The
  * std::vector Start gives the start value for the CMA-ES Minimization.
+ * GSLOptions decides how the starting points of the GSL minimizations are
+ * chosen. Budget limits the evaluations and the time shared by all
+ * minimizers, nullptr for no limit. If it is exhausted the deepest point found
+ * so far is returned and Budget->GetStatus() tells which limit was reached.
+ * The deepest point is polished with RefineStationaryPoint and the last entry
+ * of Check is its StationaryPointType.
  */
 std::vector<double>
 Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
@@ -108,7 +127,10 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
                  std::vector<double> &Check,
                  const std::vector<double> &start,
                  const int &WhichMinimizer = WhichMinimizerDefault,
-                 bool UseMultithreading    = true);
+                 bool UseMultithreading    = true,
+                 const GSL_MultistartOptions &GSLOptions =
+                     GSL_MultistartOptions(),
+                 MinimizerBudgetTracker *Budget = nullptr);
 
 /**
  * @brief The MinimizerStatus enum for the Statusflags of the minimizer
@@ -152,14 +174,17 @@ struct EWPTReturnType
 /**
  * Uses a bisection method between the Temperature TempStart and TempEnde to
  * find the phase transition in the Model and writes the solution in the vector
- * sol.
+ * sol. In each step the broken and the symmetric phase are followed from the
+ * neighbouring temperatures with local minimisations, the global minimisation
+ * is only used if one of the phases disappears.
  *  @param modelPointer shared_ptr to the parameter point
  *  @param TempStart Low temperature for the starting interval of the bisection
  * method
  *  @param TempEnd High temperature for the starting interval of the bisection
  * method
  *  @param WhichMinimizer Which minimizers should be taken? 1 = CMAES, 2 = GSL,
- * 4 = NLOPT, to use multiple add the numbers
+ * 4 = NLOPT, 8 = GSL with the analytic gradient, to use multiple add the
+ * numbers
  *  @return The information are returned in a EWPTReturnType struct
  */
 EWPTReturnType
@@ -177,7 +202,7 @@ PTFinder_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
  * @param Check Vector to safe the error flags during the minimization
  * @param start Starting point for the minimization
  * @param WhichMinimizer Which minimizers should be taken? 1 = CMAES, 2 = GSL, 4
- * = NLOPT, to use multiple add the numbers
+ * = NLOPT, 8 = GSL with the analytic gradient, to use multiple add the numbers
  * @return the global minimum
  */
 [[deprecated("Will call Minimize_gen_all_tree_level with GetSMConstants(). "
@@ -202,7 +227,7 @@ Minimize_gen_all_tree_level(const ModelID::ModelIDs &Model,
  * @param Check Vector to safe the error flags during the minimization
  * @param start Starting point for the minimization
  * @param WhichMinimizer Which minimizers should be taken? 1 = CMAES, 2 = GSL, 4
- * = NLOPT, to use multiple add the numbers
+ * = NLOPT, 8 = GSL with the analytic gradient, to use multiple add the numbers
  * @return the global minimum
  */
 std::vector<double>
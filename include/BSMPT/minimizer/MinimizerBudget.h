@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @file
+ * Evaluation and time budget shared by the minimizers
+ */
+namespace BSMPT
+{
+namespace Minimizer
+{
+
+/**
+ * @brief The MinimizerBudget struct limits the effort spent on a minimization.
+ * A value of 0 means no limit or, for the tolerance, the default of each
+ * minimizer.
+ */
+struct MinimizerBudget
+{
+  /**
+   * @brief MaxEvaluations maximal number of evaluations of the effective
+   * potential, summed over all minimizers
+   */
+  std::size_t MaxEvaluations{0};
+  /**
+   * @brief MaxSeconds maximal wall-clock time in seconds
+   */
+  double MaxSeconds{0};
+  /**
+   * @brief TargetTolerance convergence tolerance of the local minimizations,
+   * i.e. the simplex size or gradient norm of GSL, the relative step size of
+   * NLopt and the function tolerance of CMA-ES
+   */
+  double TargetTolerance{0};
+};
+
+/**
+ * @brief The MinimizerBudgetStatus enum tells if a minimization was stopped by
+ * its budget
+ */
+enum class MinimizerBudgetStatus
+{
+  /**
+   * @brief WithinBudget the minimizers converged before the budget ran out
+   */
+  WithinBudget,
+  /**
+   * @brief EvaluationsExhausted stopped after MaxEvaluations evaluations, the
+   * result is the best minimum found so far
+   */
+  EvaluationsExhausted,
+  /**
+   * @brief TimeExhausted stopped after MaxSeconds seconds, the result is the
+   * best minimum found so far
+   */
+  TimeExhausted
+};
+
+/**
+ * @brief The MinimizerBudgetTracker class counts the evaluations and the time
+ * spent since its construction. One tracker is shared by all minimizers and
+ * threads working on the same minimization, the minimizers stop and return
+ * their best point as soon as Exhausted() is true.
+ */
+class MinimizerBudgetTracker
+{
+public:
+  explicit MinimizerBudgetTracker(const MinimizerBudget &BudgetIn)
+      : Budget{BudgetIn}
+      , StartTime{std::chrono::steady_clock::now()}
+  {
+  }
+
+  /**
+   * @brief Count adds NumberOfEvaluations evaluations of the potential
+   */
+  void Count(std::size_t NumberOfEvaluations = 1)
+  {
+    Evaluations += NumberOfEvaluations;
+  }
+
+  /**
+   * @brief Exhausted checks the budget and remembers the first limit which is
+   * reached
+   * @return true if the minimizers should stop
+   */
+  bool Exhausted()
+  {
+    if (Status != MinimizerBudgetStatus::WithinBudget) return true;
+    if (Budget.MaxEvaluations > 0 and Evaluations >= Budget.MaxEvaluations)
+    {
+      SetStatus(MinimizerBudgetStatus::EvaluationsExhausted);
+      return true;
+    }
+    if (Budget.MaxSeconds > 0 and GetElapsedSeconds() >= Budget.MaxSeconds)
+    {
+      SetStatus(MinimizerBudgetStatus::TimeExhausted);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief GetStatus status of the minimization, not WithinBudget once a
+   * minimizer was stopped by the budget
+   */
+  MinimizerBudgetStatus GetStatus() const { return Status; }
+
+  /**
+   * @brief GetBudget the limits of this tracker
+   */
+  const MinimizerBudget &GetBudget() const { return Budget; }
+
+  /**
+   * @brief GetEvaluations number of evaluations counted so far
+   */
+  std::size_t GetEvaluations() const { return Evaluations; }
+
+  /**
+   * @brief GetRemainingEvaluations evaluations left, 0 without a limit. With a
+   * limit it is at least 1, as 0 switches off the limits of NLopt.
+   */
+  std::size_t GetRemainingEvaluations() const
+  {
+    if (Budget.MaxEvaluations == 0) return 0;
+    const std::size_t Used = Evaluations;
+    return Used < Budget.MaxEvaluations ? Budget.MaxEvaluations - Used : 1;
+  }
+
+  /**
+   * @brief GetElapsedSeconds wall-clock time since the construction
+   */
+  double GetElapsedSeconds() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         StartTime)
+        .count();
+  }
+
+  /**
+   * @brief GetRemainingSeconds time left, 0 without a limit
+   */
+  double GetRemainingSeconds() const
+  {
+    if (Budget.MaxSeconds <= 0) return 0;
+    // A non-positive value would switch off the limit of the callers
+    return std::max(Budget.MaxSeconds - GetElapsedSeconds(), 1e-3);
+  }
+
+private:
+  void SetStatus(MinimizerBudgetStatus NewStatus)
+  {
+    auto Expected = MinimizerBudgetStatus::WithinBudget;
+    Status.compare_exchange_strong(Expected, NewStatus);
+  }
+
+  const MinimizerBudget Budget;
+  const std::chrono::steady_clock::time_point StartTime;
+  std::atomic<std::size_t> Evaluations{0};
+  std::atomic<MinimizerBudgetStatus> Status{
+      MinimizerBudgetStatus::WithinBudget};
+};
+
+} // namespace Minimizer
+} // namespace BSMPT
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file
+ * Newton refinement of the solutions of the minimizers and classification of
+ * stationary points by the spectrum of the Hessian of the effective potential
+ */
+namespace BSMPT
+{
+class Class_Potential_Origin;
+namespace Minimizer
+{
+
+/**
+ * @brief The StationaryPointType enum classifies a stationary point by the
+ * signs of the eigenvalues of the Hessian
+ */
+enum class StationaryPointType
+{
+  /**
+   * @brief Minimum all eigenvalues are positive
+   */
+  Minimum,
+  /**
+   * @brief Saddle positive and negative eigenvalues
+   */
+  Saddle,
+  /**
+   * @brief Maximum all eigenvalues are negative
+   */
+  Maximum,
+  /**
+   * @brief Degenerate no negative but at least one vanishing eigenvalue, i.e.
+   * a flat direction or an inflection point
+   */
+  Degenerate
+};
+
+/**
+ * @brief The StationaryPointSettings struct collects the settings of
+ * RefineStationaryPoint
+ */
+struct StationaryPointSettings
+{
+  /**
+   * @brief MaxIterations maximal number of Newton steps, 0 only classifies the
+   * point
+   */
+  std::size_t MaxIterations{10};
+  /**
+   * @brief StepTolerance the refinement stops once the Newton step is smaller
+   * than this, in GeV
+   */
+  double StepTolerance{1e-6};
+  /**
+   * @brief EigenvalueTolerance eigenvalues below EigenvalueTolerance times the
+   * largest absolute eigenvalue are treated as zero
+   */
+  double EigenvalueTolerance{1e-4};
+};
+
+/**
+ * @brief The StationaryPoint struct is the result of RefineStationaryPoint
+ */
+struct StationaryPoint
+{
+  /**
+   * @brief Point the refined point, of dimension nVEV
+   */
+  std::vector<double> Point;
+  /**
+   * @brief PotVal value of the effective potential at Point
+   */
+  double PotVal{0};
+  /**
+   * @brief GradientNorm euclidean norm of the gradient in the VEV directions at
+   * Point
+   */
+  double GradientNorm{0};
+  /**
+   * @brief Eigenvalues of the Hessian in the VEV directions in ascending order
+   */
+  std::vector<double> Eigenvalues;
+  /**
+   * @brief Type classification of the point by the eigenvalues
+   */
+  StationaryPointType Type{StationaryPointType::Degenerate};
+  /**
+   * @brief Iterations number of accepted Newton steps
+   */
+  std::size_t Iterations{0};
+  /**
+   * @brief Converged true if the last Newton step was below the StepTolerance
+   */
+  bool Converged{false};
+};
+
+/**
+ * @brief ClassifyStationaryPoint classifies a stationary point
+ * @param Eigenvalues eigenvalues of the Hessian at the point
+ * @param Tolerance eigenvalues below Tolerance times the largest absolute
+ * eigenvalue are treated as zero
+ */
+StationaryPointType ClassifyStationaryPoint(const Eigen::VectorXd &Eigenvalues,
+                                            double Tolerance);
+
+/**
+ * @brief HessianVEVSpace restricts the analytic Hessian of the effective
+ * potential, see Class_Potential_Origin::VEffHessian, to the VEV directions
+ * @param model the parameter point
+ * @param Point point of dimension nVEV
+ * @param Temp temperature
+ * @return nVEV x nVEV Hessian
+ */
+Eigen::MatrixXd HessianVEVSpace(const Class_Potential_Origin &model,
+                                const std::vector<double> &Point,
+                                double Temp);
+
+/**
+ * @brief RefineStationaryPoint polishes a solution of the minimizers with
+ * Newton steps and classifies it by the spectrum of the Hessian. The Hessian is
+ * only recalculated if the gradient does not decrease fast enough with the
+ * previous one. Newton steps are only taken if the Hessian is positive
+ * definite, so a saddle point is not pulled onto the saddle but returned
+ * unchanged with its classification. Each step is halved until the gradient
+ * decreases.
+ * @param model the parameter point
+ * @param Point starting point of dimension nVEV
+ * @param Temp temperature
+ * @param Settings refinement settings
+ */
+StationaryPoint RefineStationaryPoint(
+    const Class_Potential_Origin &model,
+    const std::vector<double> &Point,
+    double Temp,
+    const StationaryPointSettings &Settings = StationaryPointSettings());
+
+} // namespace Minimizer
+} // namespace BSMPT
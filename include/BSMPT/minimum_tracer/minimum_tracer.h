@@ -273,6 +273,23 @@ struct Minimum
   bool operator<(const Minimum &a) const { return temp < a.temp; }
 };
 
+/**
+ * @brief struct to store a predictor step along a phase
+ * @param point predicted minimum at the end of the step
+ * @param error error estimate of the embedded Runge-Kutta step in GeV
+ * @param ev_start smallest non-flat eigenvalue of the Hessian at the start of
+ * the step
+ * @param ev_end smallest non-flat eigenvalue of the Hessian at the predicted
+ * minimum
+ */
+struct PhasePrediction
+{
+  std::vector<double> point;
+  double error    = 0;
+  double ev_start = 0;
+  double ev_end   = 0;
+};
+
 class MinimumTracer
 {
 private:
@@ -299,6 +316,30 @@ public:
    */
   double HessianDiagonalShift = 1e-3;
 
+  /**
+   * @brief Use the predictor-corrector mode in TrackPhase. The minimum at the
+   * next temperature is predicted by integrating \f$ d\phi/dT = - H^{-1}
+   * \partial_T \nabla V \f$ with an embedded Runge-Kutta step and corrected by
+   * Newton steps in LocateMinimum, usually a single one. The temperature step
+   * adapts to the error estimate of the predictor and to the smallest
+   * eigenvalue of the Hessian approaching zero at the end of the phase.
+   *
+   */
+  bool UsePredictorCorrector = false;
+
+  /**
+   * @brief Tolerance of the error estimate of a predictor step in GeV
+   *
+   */
+  double PredictorTolerance = 1e-2;
+
+  /**
+   * @brief Maximal temperature step of the predictor-corrector mode in units
+   * of the initial step of TrackPhase
+   *
+   */
+  double PredictorMaxStepFactor = 20;
+
   /**
    * @brief Minimum found in IsThereEWSymmetryRestoration()
    *
@@ -354,7 +395,8 @@ public:
    * @brief get global minimum of effective potential
    * @param Temp temperature
    * @param check storage for minimization debugging options
-   * @param start start value for CMA-ES minimization
+   * @param start start value for CMA-ES minimization, also used as warm start
+   * for GSL if it has the VEV dimension
    * @return global minimum at temperature Temp
    */
   std::vector<double> GetGlobalMinimum(const double &Temp,
@@ -421,6 +463,79 @@ public:
       const std::function<std::vector<std::vector<double>>(std::vector<double>)>
           &Hessian);
 
+  /**
+   * @brief PotentialVEVSpace effective potential in the VEV directions, see
+   * Class_Potential_Origin::VEff
+   * @param vev point of dimension nVEV
+   * @param T temperature
+   * @return effective potential
+   */
+  double PotentialVEVSpace(const std::vector<double> &vev, const double &T);
+
+  /**
+   * @brief GradientVEVSpace analytic gradient of the effective potential in
+   * the VEV directions, see Class_Potential_Origin::VEffGradient
+   * @param vev point of dimension nVEV
+   * @param T temperature
+   * @param Normalisation the gradient is divided by Normalisation
+   * @return gradient of dimension nVEV
+   */
+  std::vector<double> GradientVEVSpace(const std::vector<double> &vev,
+                                       const double &T,
+                                       const double &Normalisation = 1);
+
+  /**
+   * @brief HessianVEVSpace analytic Hessian of the effective potential in the
+   * VEV directions, see Class_Potential_Origin::VEffHessian
+   * @param vev point of dimension nVEV
+   * @param T temperature
+   * @param Normalisation the Hessian is divided by Normalisation
+   * @return nVEV x nVEV Hessian
+   */
+  std::vector<std::vector<double>>
+  HessianVEVSpace(const std::vector<double> &vev,
+                  const double &T,
+                  const double &Normalisation = 1);
+
+  /**
+   * @brief PhaseTangent calculates \f$ d\phi/dT = - H^{-1} \partial_T \nabla V
+   * \f$ along a phase. Flat directions with vanishing eigenvalues of the
+   * Hessian are left out.
+   * @param point point of dimension nVEV
+   * @param T temperature
+   * @param SmallestEV set to the smallest non-flat eigenvalue of the Hessian
+   * @return tangent of the phase of dimension nVEV
+   */
+  std::vector<double> PhaseTangent(const std::vector<double> &point,
+                                   const double &T,
+                                   double &SmallestEV);
+
+  /**
+   * @brief PredictMinimum integrates the phase from point at T to T + dT with
+   * the embedded Bogacki-Shampine Runge-Kutta method of third order
+   * @param point minimum at T
+   * @param T temperature of point
+   * @param dT temperature step
+   * @return predicted minimum with error estimate
+   */
+  PhasePrediction PredictMinimum(const std::vector<double> &point,
+                                 const double &T,
+                                 const double &dT);
+
+  /**
+   * @brief PredictorStep next temperature step of the predictor-corrector
+   * mode. It follows the error estimate of the last prediction and approaches
+   * the linearly extrapolated zero of the smallest eigenvalue of the Hessian in
+   * fractions.
+   * @param dT last temperature step
+   * @param prediction last prediction
+   * @param MaxStep maximal absolute temperature step
+   * @return next temperature step, with the sign of dT
+   */
+  double PredictorStep(const double &dT,
+                       const PhasePrediction &prediction,
+                       const double &MaxStep);
+
   /**
    * @brief FindZeroSmallestEigenvalue
    * @param point_1 first point
@@ -637,6 +752,18 @@ struct Phase
    */
   std::vector<Minimum> MinimumPhaseVector;
 
+  /**
+   * @brief Temperature derivatives dphi/dT of the minima in
+   * MinimumPhaseVector, entries are calculated when they are first needed
+   */
+  std::vector<std::vector<double>> TangentVector;
+
+  /**
+   * @brief Tolerance in GeV of the interpolation error estimate above which
+   * Get traces the phase to the requested temperature
+   */
+  double InterpolationTolerance = 1e-2;
+
   /**
    * @brief MinTracer object
    */
@@ -651,13 +778,32 @@ struct Phase
 
   /**
    * @brief Calculates the minimum of the phase at temperature T. This function
-   * assumes that T is inside the temperature range of the phase.
+   * assumes that T is inside the temperature range of the phase. The stored
+   * minima are interpolated and the phase is only traced to T if the error
+   * estimate exceeds InterpolationTolerance.
    *
    * @param T temperature
    * @return Minimum at temperature T for the corresponding phase
    */
   Minimum Get(double T);
 
+  /**
+   * @brief Interpolates the phase between the stored minima. The location is
+   * a cubic Hermite interpolant using dphi/dT, the potential a monotone cubic
+   * interpolant.
+   *
+   * @param T temperature inside the temperature range of the phase
+   * @param error estimated error of the location in GeV
+   * @return interpolated minimum at temperature T
+   */
+  Minimum Interpolate(double T, double &error);
+
+  /**
+   * @brief Returns dphi/dT of the k-th stored minimum and caches it in
+   * TangentVector
+   */
+  const std::vector<double> &Tangent(std::size_t k);
+
   /**
    * @brief empty constructor
    */
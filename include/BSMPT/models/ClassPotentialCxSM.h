@@ -108,6 +108,7 @@ public:
   void set_gen(const std::vector<double> &par) override;
   void set_CT_Pot_Par(const std::vector<double> &par) override;
   void write() const override;
+  std::unique_ptr<Class_Potential_Origin> clone() const override;
 
   void TripleHiggsCouplings() override;
   std::vector<double> calc_CT() const override;
@@ -16,7 +16,10 @@
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/models/SMparam.h>
 #include <BSMPT/utility/settings.h>
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 namespace BSMPT
@@ -44,6 +47,25 @@ const double C_CWcbGB = 5.0 / 6.0;
  */
 const double C_CWcbHiggs = 1.5;
 
+/**
+ * @brief The PackedCoupling struct stores one non-vanishing entry of a
+ * curvature tensor in packed form. All entries of the original tensor which
+ * contribute to the same term, i.e. which only differ by a permutation of
+ * symmetric indices, are summed up into Value together with the combinatorial
+ * prefactor of that term.
+ */
+template <std::size_t Rank> struct PackedCoupling
+{
+  /**
+   * @brief Index index tuple of the term
+   */
+  std::array<std::size_t, Rank> Index;
+  /**
+   * @brief Value coupling including the combinatorial prefactor
+   */
+  double Value;
+};
+
 /**
  * @brief The Class_Potential_Origin class
  * Base class for all models. This class contains all numerical calculations on
@@ -378,13 +400,221 @@ protected:
    * gauge bosons
    */
   std::vector<std::vector<double>> DebyeGauge;
+
+  /**
+   * @brief FlatCurvatureDone Used to check if FlattenCurvatureArrays has been
+   * called after the tensors were set
+   */
+  bool FlatCurvatureDone = false;
+  /**
+   * @brief PackedHiggs_L1 Terms of the tree-level potential linear in the
+   * fields, used in VTree
+   */
+  std::vector<PackedCoupling<1>> PackedHiggs_L1;
+  /**
+   * @brief PackedHiggs_L2 Terms of the tree-level potential quadratic in the
+   * fields with i <= j, used in VTree
+   */
+  std::vector<PackedCoupling<2>> PackedHiggs_L2;
+  /**
+   * @brief PackedHiggs_L3 Terms of the tree-level potential cubic in the
+   * fields with i <= j <= k, used in VTree
+   */
+  std::vector<PackedCoupling<3>> PackedHiggs_L3;
+  /**
+   * @brief PackedHiggs_L4 Terms of the tree-level potential quartic in the
+   * fields with i <= j <= k <= l, used in VTree
+   */
+  std::vector<PackedCoupling<4>> PackedHiggs_L4;
+  /**
+   * @brief PackedHiggs_CT_L1 Same as PackedHiggs_L1 for the counterterm
+   * potential
+   */
+  std::vector<PackedCoupling<1>> PackedHiggs_CT_L1;
+  /**
+   * @brief PackedHiggs_CT_L2 Same as PackedHiggs_L2 for the counterterm
+   * potential
+   */
+  std::vector<PackedCoupling<2>> PackedHiggs_CT_L2;
+  /**
+   * @brief PackedHiggs_CT_L3 Same as PackedHiggs_L3 for the counterterm
+   * potential
+   */
+  std::vector<PackedCoupling<3>> PackedHiggs_CT_L3;
+  /**
+   * @brief PackedHiggs_CT_L4 Same as PackedHiggs_L4 for the counterterm
+   * potential
+   */
+  std::vector<PackedCoupling<4>> PackedHiggs_CT_L4;
+  /**
+   * @brief MassHiggs_L2 L_{(S)}^{ij} as contiguous matrix
+   */
+  Eigen::MatrixXd MassHiggs_L2;
+  /**
+   * @brief MassHiggs_L3 Non-vanishing L_{(S)}^{ijk} with i <= j, contributing
+   * L_{(S)}^{ijk} v_k to the Higgs mass matrix
+   */
+  std::vector<PackedCoupling<3>> MassHiggs_L3;
+  /**
+   * @brief MassHiggs_L4 Non-vanishing L_{(S)}^{ijkl} with i <= j and k <= l,
+   * contributing Value * v_k v_l to the Higgs mass matrix
+   */
+  std::vector<PackedCoupling<4>> MassHiggs_L4;
+  /**
+   * @brief MassGauge_G2H2 Non-vanishing G^{abij} with a <= b and i <= j,
+   * contributing Value * v_i v_j to the gauge mass matrix
+   */
+  std::vector<PackedCoupling<4>> MassGauge_G2H2;
+  /**
+   * @brief MassDebyeHiggs DebyeHiggs as contiguous matrix
+   */
+  Eigen::MatrixXd MassDebyeHiggs;
+  /**
+   * @brief MassDebyeGauge DebyeGauge as contiguous matrix
+   */
+  Eigen::MatrixXd MassDebyeGauge;
+  /**
+   * @brief MassQuark_F2 Y^{IJ} for Quarks as contiguous matrix
+   */
+  Eigen::MatrixXcd MassQuark_F2;
+  /**
+   * @brief MassQuark_F2H1 Y^{IJk} for Quarks, one contiguous matrix for each
+   * Higgs field k
+   */
+  std::vector<Eigen::MatrixXcd> MassQuark_F2H1;
+  /**
+   * @brief MassQuark_Fields Higgs fields k with a non-vanishing Y^{IJk} for
+   * Quarks
+   */
+  std::vector<std::size_t> MassQuark_Fields;
+  /**
+   * @brief MassLepton_F2 Y^{IJ} for Leptons as contiguous matrix
+   */
+  Eigen::MatrixXcd MassLepton_F2;
+  /**
+   * @brief MassLepton_F2H1 Y^{IJk} for Leptons, one contiguous matrix for each
+   * Higgs field k
+   */
+  std::vector<Eigen::MatrixXcd> MassLepton_F2H1;
+  /**
+   * @brief MassLepton_Fields Higgs fields k with a non-vanishing Y^{IJk} for
+   * Leptons
+   */
+  std::vector<std::size_t> MassLepton_Fields;
+
+  /**
+   * @brief VEffBatchBlock calculates VEffBatch for one block of field
+   * configurations
+   * @param Fields the column i holds v_i of all configurations in the block
+   * @param Temp temperature at which the potential should be evaluated
+   * @param Order 0 for the tree level and 1 for the NLO potential
+   * @return the potential of each configuration in the block
+   */
+  Eigen::ArrayXd
+  VEffBatchBlock(const Eigen::ArrayXXd &Fields, double Temp, int Order) const;
+
   /**
    * @brief VevOrder Stores the matching order used in MinimizeOrderVEV, set in
    * the constructor of the model
    */
   std::vector<std::size_t> VevOrder;
 
+  /**
+   * @brief UseMassCache Enables the cache of the mass spectra, see
+   * SetUseMassCache
+   */
+  bool UseMassCache = false;
+  /**
+   * @brief MassCacheSize Number of spectra kept per thread
+   */
+  std::size_t MassCacheSize = 64;
+  /**
+   * @brief MassCacheGeneration Identifies the current couplings in the mass
+   * spectrum cache. Copies of a model share it, every change of the couplings
+   * draws a new one.
+   */
+  std::uint64_t MassCacheGeneration;
+  /**
+   * @brief InvalidateMassCache has to be called whenever the couplings
+   * entering the mass matrices change
+   */
+  void InvalidateMassCache();
+  /**
+   * @brief FindInMassCache looks up a spectrum in the cache of the calling
+   * thread
+   * @param Sector 0 Higgs, 1 gauge bosons, 2 quarks, 3 leptons
+   * @param v field configuration
+   * @param Temp temperature
+   * @param res the cached spectrum if found
+   * @return true if the spectrum was found
+   */
+  bool FindInMassCache(int Sector,
+                       const std::vector<double> &v,
+                       double Temp,
+                       std::vector<double> &res) const;
+  /**
+   * @brief StoreInMassCache stores a spectrum in the cache of the calling
+   * thread and drops the least recently used one if the cache is full
+   * @param Sector 0 Higgs, 1 gauge bosons, 2 quarks, 3 leptons
+   * @param v field configuration
+   * @param Temp temperature
+   * @param res spectrum to store
+   */
+  void StoreInMassCache(int Sector,
+                        const std::vector<double> &v,
+                        double Temp,
+                        const std::vector<double> &res) const;
+
+  /**
+   * @brief FillHiggsMassMatrix writes the Higgs mass matrix into res, which can
+   * be a fixed-size or a dynamic Eigen matrix
+   * @param res the mass matrix
+   * @param v field configuration of size NHiggs
+   * @param Temp temperature
+   */
+  template <typename MatrixType>
+  void FillHiggsMassMatrix(MatrixType &res,
+                           const std::vector<double> &v,
+                           double Temp) const;
+  /**
+   * @brief FillGaugeMassMatrix writes the gauge boson mass matrix into res,
+   * which can be a fixed-size or a dynamic Eigen matrix
+   * @param res the mass matrix
+   * @param v field configuration of size NHiggs
+   * @param Temp temperature
+   */
+  template <typename MatrixType>
+  void FillGaugeMassMatrix(MatrixType &res,
+                           const std::vector<double> &v,
+                           double Temp) const;
+  /**
+   * @brief FillQuarkMassMatrix writes the quark mass matrix into res, which
+   * can be a fixed-size or a dynamic Eigen matrix
+   * @param res the mass matrix
+   * @param v field configuration of size NHiggs
+   */
+  template <typename MatrixType>
+  void FillQuarkMassMatrix(MatrixType &res, const std::vector<double> &v) const;
+  /**
+   * @brief FillLeptonMassMatrix writes the lepton mass matrix into res, which
+   * can be a fixed-size or a dynamic Eigen matrix
+   * @param res the mass matrix
+   * @param v field configuration of size NHiggs
+   */
+  template <typename MatrixType>
+  void FillLeptonMassMatrix(MatrixType &res,
+                            const std::vector<double> &v) const;
+
 public:
+  /**
+   * @brief MassCacheStatistics Hit and miss counters of the mass spectrum
+   * cache
+   */
+  struct MassCacheStatistics
+  {
+    std::size_t Hits{0};
+    std::size_t Misses{0};
+  };
   [[deprecated("Will call Class_Potential_Origin with GetSMConstants(). "
                "Please use the "
                "detailed overload "
@@ -664,6 +894,53 @@ public:
                       double Temp = 0,
                       int diff    = 0,
                       int Order   = 1) const;
+  /**
+   * @brief VEffGradient calculates the gradient of the effective potential
+   * w.r.t. all Higgs fields in a single pass. Every mass matrix is only
+   * diagonalised once instead of once per field direction as in
+   * VEff(v,Temp,i+1,Order).
+   * @param v vev configuration at which the gradient should be evaluated
+   * @param Temp temperature at which the gradient should be evaluated
+   * @param Order 0 returns the gradient of the tree level potential and 1 the
+   * gradient of the NLO potential. Default value is the NLO potential
+   * @return vector of dimension NHiggs with the entry i being the derivative
+   * w.r.t. v_i
+   */
+  std::vector<double> VEffGradient(const std::vector<double> &v,
+                                   double Temp = 0,
+                                   int Order   = 1) const;
+  /**
+   * @brief VEffHessian calculates the Hessian of the effective potential w.r.t.
+   * all Higgs fields analytically. Every mass matrix is diagonalised once, see
+   * V1LoopHessian for the one-loop part.
+   * @param v vev configuration at which the Hessian should be evaluated
+   * @param Temp temperature at which the Hessian should be evaluated
+   * @param Order 0 returns the Hessian of the tree level potential and 1 the
+   * Hessian of the NLO potential. Default value is the NLO potential
+   * @return NHiggs x NHiggs matrix with the entry (i,j) being the second
+   * derivative w.r.t. v_i and v_j
+   */
+  Eigen::MatrixXd VEffHessian(const std::vector<double> &v,
+                              double Temp = 0,
+                              int Order   = 1) const;
+  /**
+   * @brief VEffBatch calculates the effective potential for many field
+   * configurations at the same temperature. The mass matrices of all
+   * configurations are assembled together in a structure-of-arrays layout and
+   * the thermal functions are evaluated species by species over all
+   * configurations.
+   * @param points field configurations of dimension NHiggs stored one after
+   * another, i.e. v_i of the configuration p is points[p * NHiggs + i]
+   * @param Temp temperature at which the potential should be evaluated
+   * @param out is resized to the number of configurations, the entry p is
+   * VEff(v_p, Temp, 0, Order)
+   * @param Order 0 returns the tree level potential and 1 the NLO potential.
+   * Default value is the NLO potential
+   */
+  void VEffBatch(const std::vector<double> &points,
+                 double Temp,
+                 std::vector<double> &out,
+                 int Order = 1) const;
   /**
    * Calculates the tree-level potential and its derivatives.
    * @param v the configuration of all VEVs at which the potential should be
@@ -699,6 +976,59 @@ public:
    * @return the value of the one-loop part of the effective potential
    */
   double V1Loop(const std::vector<double> &v, double Temp, int diff) const;
+  /**
+   * @brief MassSpectrumBuffers holds the mass spectra needed by V1Loop. Reusing
+   * it between calls avoids all heap allocations of the one-loop potential.
+   */
+  struct MassSpectrumBuffers
+  {
+    std::vector<double> Higgs, HiggsZeroTemp, Gauge, GaugeZeroTemp, Quark,
+        Lepton;
+  };
+  /**
+   * @brief V1Loop calculates the Coleman-Weinberg and temperature-dependent
+   * 1-loop part of the effective potential, the mass spectra are written into
+   * Buffers. V1Loop(v, Temp, 0) calls this with buffers kept per thread.
+   * @param v the configuration of all VEVs at which the potential should be
+   * calculated
+   * @param Temp the temperature at which the potential should be evaluated
+   * @param Buffers storage for the mass spectra
+   * @return the value of the one-loop part of the effective potential
+   */
+  double V1Loop(const std::vector<double> &v,
+                double Temp,
+                MassSpectrumBuffers &Buffers) const;
+  /**
+   * @brief V1LoopGradient calculates the gradient of the Coleman-Weinberg and
+   * temperature-dependent 1-loop part of the effective potential w.r.t. all
+   * Higgs fields
+   * @param v the configuration of all VEVs at which the gradient should be
+   * calculated
+   * @param Temp the temperature at which the gradient should be evaluated
+   * @return vector of dimension NHiggs with the entry i being the derivative
+   * of V1Loop w.r.t. v_i
+   */
+  std::vector<double> V1LoopGradient(const std::vector<double> &v,
+                                     double Temp) const;
+  /**
+   * @brief V1LoopHessian calculates the Hessian of the Coleman-Weinberg and
+   * temperature-dependent 1-loop part of the effective potential w.r.t. all
+   * Higgs fields. For each mass matrix M with eigenvalues m_k^2 and
+   * eigenvectors U the contribution of sum_k f(m_k^2) is given by second-order
+   * perturbation theory as
+   * \f$ \sum_k f'(m_k^2) (U^\dagger M_{ij} U)_{kk} + \sum_{k,l} f^{[1]}(m_k^2,
+   * m_l^2) \mathrm{Re}[(U^\dagger M_i U)_{kl} (U^\dagger M_j U)_{lk}] \f$
+   * with the divided difference \f$ f^{[1]}(a,b) = (f'(a) - f'(b))/(a-b) \f$.
+   * For (nearly) degenerate eigenvalues the divided difference is replaced by
+   * the second derivative f'' at their mean, calculated by central differences
+   * of f', so repeated eigenvalues are treated safely.
+   * @param v the configuration of all VEVs at which the Hessian should be
+   * calculated
+   * @param Temp the temperature at which the Hessian should be evaluated
+   * @return NHiggs x NHiggs matrix of the second derivatives of V1Loop
+   */
+  Eigen::MatrixXd V1LoopHessian(const std::vector<double> &v,
+                                double Temp) const;
 
   /**
    * This function calculates the EW breaking VEV from all contributing field
@@ -760,6 +1090,59 @@ public:
    */
   virtual void write() const = 0;
 
+  /**
+   * @brief clone creates an independent copy of the model including its
+   * parameters, counterterms and curvature tensors.
+   * This has to be specified in the model file, usually as a call of the copy
+   * constructor.
+   * @return copy of the model
+   */
+  virtual std::unique_ptr<Class_Potential_Origin> clone() const = 0;
+
+  /**
+   * @brief Prepare returns an immutable snapshot of the current parameter
+   * point.
+   *
+   * All const member functions, in particular VEff, VEffGradient, VEffBatch
+   * and the mass spectra, only read the model and keep their intermediate
+   * results on the stack. The snapshot can therefore be evaluated from any
+   * number of threads without locking, while the original model may be set to
+   * the next parameter point.
+   * @return read-only copy of the model
+   * @throw std::runtime_error if the model has not been initialised
+   */
+  std::shared_ptr<const Class_Potential_Origin> Prepare() const;
+
+  /**
+   * @brief SetUseMassCache enables or disables the cache of the mass spectra.
+   *
+   * If enabled, HiggsMassesSquared, GaugeMassesSquared, QuarkMassesSquared
+   * and LeptonMassesSquared store their eigenvalues (diff = 0) for the last
+   * evaluated pairs of field configuration and temperature and return them on
+   * an exact match instead of diagonalising the mass matrix again. Each thread
+   * has its own least recently used cache, so no locking is needed. Entries
+   * are invalidated when the couplings of the model change. Disabled by
+   * default.
+   * @param enable enables the cache
+   * @param size number of spectra kept per thread
+   */
+  void SetUseMassCache(bool enable, std::size_t size = 64);
+  /**
+   * @brief GetUseMassCache
+   * @return true if the mass spectrum cache is enabled
+   */
+  bool GetUseMassCache() const { return UseMassCache; }
+  /**
+   * @brief GetMassCacheStatistics
+   * @return hits and misses of the mass spectrum cache of the calling thread
+   */
+  static MassCacheStatistics GetMassCacheStatistics();
+  /**
+   * @brief ResetMassCacheStatistics sets the counters of the calling thread to
+   * zero and empties its cache
+   */
+  static void ResetMassCacheStatistics();
+
   void set_All(const std::vector<double> &par,
                const std::vector<double> &parCT);
 
@@ -814,6 +1197,15 @@ public:
    * CalculateDebyeGaugeSimplified() the runtime can be reduced.
    */
   void CalculateDebyeGauge();
+  /**
+   * @brief FlattenCurvatureArrays copies the curvature tensors and the Debye
+   * corrections into the flat and packed storage used by VTree, CounterTerm
+   * and the mass matrices. Only the non-vanishing couplings are kept. This is
+   * called by initModel, set_All and resetScale and has to be called again if
+   * the tensors are changed by other means. CalculateDebye and
+   * CalculateDebyeGauge update the flat Debye corrections themselves.
+   */
+  void FlattenCurvatureArrays();
   /**
    * Sets a tensor needed to calculate the contribution of the counterterm
    * potential to the triple Higgs couplings.
@@ -873,6 +1265,33 @@ public:
   std::vector<double> HiggsMassesSquared(const std::vector<double> &v,
                                          const double &Temp = 0,
                                          const int &diff    = 0) const;
+  /**
+   * @brief HiggsMassesSquared writes the eigenvalues of the Higgs mass matrix
+   * into res. For a v of size NHiggs this needs no heap allocation once res
+   * holds NHiggs entries.
+   * @param res Vector in which the eigenvalues m^2 of the mass matrix will be
+   * stored
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   * @param Temp The temperature at which the Debye corrected masses should be
+   * calculated
+   */
+  void HiggsMassesSquared(std::vector<double> &res,
+                          const std::vector<double> &v,
+                          const double &Temp) const;
+  /**
+   * @brief HiggsMassesSquaredGradient calculates the eigenvalues of the Higgs
+   * mass matrix and their derivatives w.r.t. all Higgs fields
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   * @param Temp The temperature at which the Debye corrected masses should be
+   * calculated
+   * @return vector of NHiggs+1 entries, the first one holds the eigenvalues m^2
+   * and the entry i+1 their derivatives w.r.t. v_i
+   */
+  std::vector<std::vector<double>>
+  HiggsMassesSquaredGradient(const std::vector<double> &v,
+                             const double &Temp = 0) const;
 
   /**
    * @brief HiggsMassMatrix calculates the Higgs mass matrix
@@ -888,6 +1307,17 @@ public:
                                   double Temp = 0,
                                   int diff    = 0) const;
 
+  /**
+   * @brief GaugeMassMatrix calculates the gauge boson mass matrix
+   * @param v the configuration of all VEVs at which the Mass Matrix should be
+   * evaluated
+   * @param Temp The temperature at which the Debye corrected masses should be
+   * calculated
+   * @return the gauge boson mass matrix
+   */
+  Eigen::MatrixXd GaugeMassMatrix(const std::vector<double> &v,
+                                  const double &Temp = 0) const;
+
   /**
    * Calculates the gauge mass matrix and saves all eigenvalues
    * @param v the configuration of all VEVs at which the eigenvalues should be
@@ -902,6 +1332,33 @@ public:
   std::vector<double> GaugeMassesSquared(const std::vector<double> &v,
                                          const double &Temp = 0,
                                          const int &diff    = 0) const;
+  /**
+   * @brief GaugeMassesSquared writes the eigenvalues of the gauge boson mass
+   * matrix into res. For a v of size NHiggs this needs no heap allocation once
+   * res holds NGauge entries.
+   * @param res Vector in which the eigenvalues m^2 of the mass matrix will be
+   * stored
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   * @param Temp The temperature at which the Debye corrected masses should be
+   * calculated
+   */
+  void GaugeMassesSquared(std::vector<double> &res,
+                          const std::vector<double> &v,
+                          const double &Temp) const;
+  /**
+   * @brief GaugeMassesSquaredGradient calculates the eigenvalues of the gauge
+   * mass matrix and their derivatives w.r.t. all Higgs fields
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   * @param Temp The temperature at which the Debye corrected masses should be
+   * calculated
+   * @return vector of NHiggs+1 entries, the first one holds the eigenvalues m^2
+   * and the entry i+1 their derivatives w.r.t. v_i
+   */
+  std::vector<std::vector<double>>
+  GaugeMassesSquaredGradient(const std::vector<double> &v,
+                             const double &Temp = 0) const;
   /**
    * Calculates the quark mass matrix and saves all eigenvalues, this assumes
    * the same masses for different colours.
@@ -914,6 +1371,26 @@ public:
    */
   std::vector<double> QuarkMassesSquared(const std::vector<double> &v,
                                          const int &diff = 0) const;
+  /**
+   * @brief QuarkMassesSquared writes the eigenvalues of the squared quark mass
+   * matrix into res. For a v of size NHiggs this needs no heap allocation once
+   * res holds NQuarks entries.
+   * @param res Vector in which the eigenvalues m^2 will be stored
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   */
+  void QuarkMassesSquared(std::vector<double> &res,
+                          const std::vector<double> &v) const;
+  /**
+   * @brief QuarkMassesSquaredGradient calculates the eigenvalues of the quark
+   * mass matrix and their derivatives w.r.t. all Higgs fields
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   * @return vector of NHiggs+1 entries, the first one holds the eigenvalues m^2
+   * and the entry i+1 their derivatives w.r.t. v_i
+   */
+  std::vector<std::vector<double>>
+  QuarkMassesSquaredGradient(const std::vector<double> &v) const;
   /**
    * Calculates the lepton mass matrix and saves all eigenvalues
    * @param v the configuration of all VEVs at which the eigenvalues should be
@@ -925,6 +1402,59 @@ public:
    */
   std::vector<double> LeptonMassesSquared(const std::vector<double> &v,
                                           const int &diff = 0) const;
+  /**
+   * @brief LeptonMassesSquared writes the eigenvalues of the squared lepton
+   * mass matrix into res. For a v of size NHiggs this needs no heap allocation
+   * once res holds NLepton entries.
+   * @param res Vector in which the eigenvalues m^2 will be stored
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   */
+  void LeptonMassesSquared(std::vector<double> &res,
+                           const std::vector<double> &v) const;
+  /**
+   * @brief LeptonMassesSquaredGradient calculates the eigenvalues of the
+   * lepton mass matrix and their derivatives w.r.t. all Higgs fields
+   * @param v the configuration of all VEVs at which the eigenvalues should be
+   * evaluated
+   * @return vector of NHiggs+1 entries, the first one holds the eigenvalues m^2
+   * and the entry i+1 their derivatives w.r.t. v_i
+   */
+  std::vector<std::vector<double>>
+  LeptonMassesSquaredGradient(const std::vector<double> &v) const;
+
+  /**
+   * @brief HiggsMassMatrixDerivatives calculates the derivatives of the Higgs
+   * mass matrix w.r.t. all Higgs fields, which do not depend on the
+   * temperature
+   * @return vector of NHiggs matrices, the entry i is the derivative w.r.t. v_i
+   */
+  std::vector<Eigen::MatrixXcd>
+  HiggsMassMatrixDerivatives(const std::vector<double> &v) const;
+  /**
+   * @brief GaugeMassMatrixDerivatives calculates the derivatives of the gauge
+   * boson mass matrix w.r.t. all Higgs fields, which do not depend on the
+   * temperature
+   * @return vector of NHiggs matrices, the entry i is the derivative w.r.t. v_i
+   */
+  std::vector<Eigen::MatrixXcd>
+  GaugeMassMatrixDerivatives(const std::vector<double> &v) const;
+  /**
+   * @brief QuarkMassMatrixDerivatives calculates the derivatives of the squared
+   * quark mass matrix w.r.t. all Higgs fields
+   * @param MIJ the quark mass matrix QuarkMassMatrix(v)
+   * @return vector of NHiggs matrices, the entry i is the derivative w.r.t. v_i
+   */
+  std::vector<Eigen::MatrixXcd>
+  QuarkMassMatrixDerivatives(const Eigen::MatrixXcd &MIJ) const;
+  /**
+   * @brief LeptonMassMatrixDerivatives calculates the derivatives of the
+   * squared lepton mass matrix w.r.t. all Higgs fields
+   * @param MIJ the lepton mass matrix LeptonMassMatrix(v)
+   * @return vector of NHiggs matrices, the entry i is the derivative w.r.t. v_i
+   */
+  std::vector<Eigen::MatrixXcd>
+  LeptonMassMatrixDerivatives(const Eigen::MatrixXcd &MIJ) const;
 
   /**
    * Calculates the quark mass matrix and saves all eigenvalues, this assumes
@@ -1113,6 +1643,19 @@ public:
   std::vector<double>
   FirstDerivativeOfEigenvalues(const Eigen::Ref<Eigen::MatrixXcd> M,
                                const Eigen::Ref<Eigen::MatrixXcd> MDiff) const;
+  /**
+   * Calculates the first derivatives of the eigenvalues of a given matrix
+   * w.r.t. several parameters. The matrix is only diagonalised once.
+   * @param M : the original matrix
+   * @param MDiff : the element-wise first derivatives of the matrix M, one
+   * matrix for each parameter you want to consider
+   * @return vector of MDiff.size()+1 entries, the first one holds the
+   * eigenvalues and the entry i+1 their derivatives w.r.t. the i-th parameter
+   */
+  std::vector<std::vector<double>>
+  FirstDerivativeOfEigenvalues(
+      const Eigen::Ref<Eigen::MatrixXcd> M,
+      const std::vector<Eigen::MatrixXcd> &MDiff) const;
   /**
    * This function calculates the second derivatives of all eigenvalues.
    * The matrix must not have a repeated eigenvalue for this!
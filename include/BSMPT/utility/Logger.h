@@ -9,6 +9,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <vector>
 
 /**
@@ -36,6 +37,7 @@ enum class LoggingLevel
   ProgDetailed,
   EWBGDetailed,
   Debug,
+  Profile,
   Complete
 };
 
@@ -70,6 +72,7 @@ private:
     auto pos = mCurrentSetup.find(level);
     if (pos != mCurrentSetup.end() and pos->second)
     {
+      std::lock_guard<std::mutex> lock(mWriteMutex);
       if (not file.empty())
       {
         mOstream << "file: " << file << "; ";
@@ -88,6 +91,10 @@ private:
 
   std::ostream mOstream;
   std::ofstream mfilestream;
+  /**
+   * @brief mWriteMutex keeps messages written from different threads apart
+   */
+  std::mutex mWriteMutex;
 
   const std::map<LoggingLevel, bool> mDefaultSetup{
       {LoggingLevel::Default, true},
@@ -98,7 +105,8 @@ private:
       {LoggingLevel::TransitionDetailed, false},
       {LoggingLevel::BounceDetailed, false},
       {LoggingLevel::GWDetailed, false},
-      {LoggingLevel::Debug, false}};
+      {LoggingLevel::Debug, false},
+      {LoggingLevel::Profile, false}};
 
   std::map<LoggingLevel, bool> mCurrentSetup = mDefaultSetup;
 };
@@ -139,7 +147,9 @@ public:
 
   static bool GetLoggingLevelStatus(LoggingLevel level)
   {
-    return Instance().mCurrentSetup[level];
+    const auto &Setup = Instance().mCurrentSetup;
+    auto pos          = Setup.find(level);
+    return pos != Setup.end() and pos->second;
   }
 
   static void Disable() { Instance().Disable(); }
@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <BSMPT/utility/ThreadPool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * Driver to calculate the parameter points of an input file in parallel
+ */
+namespace BSMPT
+{
+
+/**
+ * @brief ProcessLinesParallel calculates the lines FirstLine to LastLine of
+ * Input with NumberOfThreads workers and hands the results to Commit in the
+ * order of the input file.
+ *
+ * Each worker calls CreateProcessor once and keeps the returned function, and
+ * with it its own model instance, for all the lines it calculates. An idle
+ * worker takes the next unread line, so expensive points do not stall the
+ * others. At most MaxPendingLines lines are read ahead of the oldest line which
+ * is not yet committed, which bounds the memory for arbitrarily long input
+ * files. Commit is never called concurrently. The first exception thrown by a
+ * worker or by Commit stops the calculation and is rethrown.
+ *
+ * The workers are tasks of the global ThreadPool, so at most
+ * ThreadPool::Global().GetConcurrency() lines are calculated at the same time
+ * and the minimizers called by the workers share the same threads. For
+ * NumberOfThreads <= 1 everything runs on the calling thread.
+ *
+ * @param Input input stream, the next line read has the number LineNumber
+ * @param LineNumber line number of the next line in Input
+ * @param FirstLine first line which is calculated
+ * @param LastLine last line which is calculated
+ * @param NumberOfThreads number of worker threads
+ * @param CreateProcessor creates the function calculating a single line. It is
+ * called with the line number and the line.
+ * @param Commit receives the line number and the result of each line
+ * @param MaxPendingLines maximal number of lines in flight, 0 uses four times
+ * the number of threads
+ */
+template <typename Result>
+void ProcessLinesParallel(
+    std::istream &Input,
+    int LineNumber,
+    int FirstLine,
+    int LastLine,
+    std::size_t NumberOfThreads,
+    const std::function<std::function<Result(int, const std::string &)>()>
+        &CreateProcessor,
+    const std::function<void(int, Result &&)> &Commit,
+    std::size_t MaxPendingLines = 0)
+{
+  // Reads the next line to calculate, returns false if there is none left
+  auto ReadLine = [&](std::string &linestr, int &linecounter)
+  {
+    while (LineNumber <= LastLine and std::getline(Input, linestr))
+    {
+      linecounter = LineNumber++;
+      if (linecounter >= FirstLine) return true;
+    }
+    return false;
+  };
+
+  if (NumberOfThreads <= 1)
+  {
+    auto Processor = CreateProcessor();
+    std::string linestr;
+    int linecounter;
+    while (ReadLine(linestr, linecounter))
+    {
+      Commit(linecounter, Processor(linecounter, linestr));
+    }
+    return;
+  }
+
+  if (MaxPendingLines == 0) MaxPendingLines = 4 * NumberOfThreads;
+  MaxPendingLines = std::max(MaxPendingLines, NumberOfThreads);
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  bool InputDone{false}, Committing{false};
+  std::exception_ptr Error;
+  std::size_t Dispatched{0}, Committed{0};
+  std::map<std::size_t, std::pair<int, Result>> Finished;
+
+  auto Worker = [&]()
+  {
+    try
+    {
+      auto Processor = CreateProcessor();
+      std::string linestr;
+      int linecounter;
+      while (true)
+      {
+        std::unique_lock<std::mutex> lock(Mutex);
+        Condition.wait(lock,
+                       [&]
+                       {
+                         return Error or InputDone or
+                                Dispatched < Committed + MaxPendingLines;
+                       });
+        if (Error or InputDone) return;
+        if (not ReadLine(linestr, linecounter))
+        {
+          InputDone = true;
+          Condition.notify_all();
+          return;
+        }
+        const std::size_t ticket = Dispatched++;
+        lock.unlock();
+
+        Result result = Processor(linecounter, linestr);
+
+        lock.lock();
+        Finished.emplace(ticket,
+                         std::make_pair(linecounter, std::move(result)));
+        if (Committing) continue;
+        Committing = true;
+        while (not Error and not Finished.empty() and
+               Finished.begin()->first == Committed)
+        {
+          auto node = Finished.extract(Finished.begin());
+          lock.unlock();
+          Commit(node.mapped().first, std::move(node.mapped().second));
+          lock.lock();
+          Committed++;
+        }
+        Committing = false;
+        Condition.notify_all();
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      if (not Error) Error = std::current_exception();
+      Condition.notify_all();
+    }
+  };
+
+  TaskGroup Workers;
+  for (std::size_t i = 0; i < NumberOfThreads; i++)
+  {
+    Workers.Run(Worker);
+  }
+  Workers.Wait();
+  if (Error) std::rethrow_exception(Error);
+}
+
+} // namespace BSMPT
@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <BSMPT/config.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file
+ * Evaluation counters and stage timers. The macros BSMPT_PROFILE_COUNT and
+ * BSMPT_PROFILE_STAGE only record something if BSMPT was configured with
+ * -DBSMPTEnableProfiling=ON, otherwise they expand to nothing.
+ */
+namespace BSMPT
+{
+namespace Profiler
+{
+
+/**
+ * @brief The Counter enum lists the counted functions
+ */
+enum class Counter
+{
+  VEff,
+  VEffGradient,
+  HiggsMassesSquared,
+  CalculateDebye,
+  JbosonInterpolated,
+  JfermionInterpolated,
+  NumberOfCounters
+};
+
+/**
+ * @brief The Stage enum lists the timed stages of a calculation. Counts are
+ * attributed to the innermost stage of the thread, tasks of the thread pool
+ * inherit the stage of the thread submitting them.
+ */
+enum class Stage
+{
+  Other,
+  Minimizer,
+  MinimumTracer,
+  TransitionTracer,
+  Bounce,
+  GravitationalWaves,
+  NumberOfStages
+};
+
+constexpr std::size_t NumberOfCounters =
+    static_cast<std::size_t>(Counter::NumberOfCounters);
+constexpr std::size_t NumberOfStages =
+    static_cast<std::size_t>(Stage::NumberOfStages);
+
+/**
+ * @brief The Profile struct holds the counts and times of all stages
+ */
+struct Profile
+{
+  /**
+   * @brief Counts number of calls of each counter in each stage
+   */
+  std::array<std::array<std::uint64_t, NumberOfCounters>, NumberOfStages>
+      Counts{};
+  /**
+   * @brief Entries number of times each stage was entered
+   */
+  std::array<std::uint64_t, NumberOfStages> Entries{};
+  /**
+   * @brief Seconds wall-clock time spent in each stage including the nested
+   * stages, summed over all threads
+   */
+  std::array<double, NumberOfStages> Seconds{};
+};
+
+/**
+ * @brief ThreadProfile counts of the calling thread. Every thread writes only
+ * to its own counters, the relaxed atomics allow the report to read them while
+ * the thread is running.
+ */
+struct ThreadProfile
+{
+  ThreadProfile();
+  ~ThreadProfile();
+  ThreadProfile(const ThreadProfile &)            = delete;
+  ThreadProfile &operator=(const ThreadProfile &) = delete;
+
+  void Add(Profile &Total) const;
+
+  std::array<std::array<std::atomic<std::uint64_t>, NumberOfCounters>,
+             NumberOfStages>
+      Counts{};
+  std::array<std::atomic<std::uint64_t>, NumberOfStages> Entries{};
+  std::array<std::atomic<double>, NumberOfStages> Seconds{};
+  Stage CurrentStage{Stage::Other};
+};
+
+/**
+ * @brief GetThreadProfile returns the counters of the calling thread
+ */
+inline ThreadProfile &GetThreadProfile()
+{
+  thread_local ThreadProfile Thread;
+  return Thread;
+}
+
+/**
+ * @brief Count increases the counter in the current stage of the calling
+ * thread
+ */
+inline void Count(Counter counter)
+{
+  auto &Thread = GetThreadProfile();
+  auto &Value  = Thread.Counts[static_cast<std::size_t>(Thread.CurrentStage)]
+                             [static_cast<std::size_t>(counter)];
+  Value.store(Value.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+}
+
+/**
+ * @brief GetCurrentStage innermost stage of the calling thread
+ */
+inline Stage GetCurrentStage()
+{
+  return GetThreadProfile().CurrentStage;
+}
+
+/**
+ * @brief The StageGuard class sets the current stage of the calling thread
+ * for its lifetime without timing it
+ */
+class StageGuard
+{
+public:
+  explicit StageGuard(Stage stage)
+      : Thread{GetThreadProfile()}
+      , Previous{Thread.CurrentStage}
+  {
+    Thread.CurrentStage = stage;
+  }
+  ~StageGuard() { Thread.CurrentStage = Previous; }
+  StageGuard(const StageGuard &)            = delete;
+  StageGuard &operator=(const StageGuard &) = delete;
+
+private:
+  ThreadProfile &Thread;
+  const Stage Previous;
+};
+
+/**
+ * @brief The ScopedTimer class enters a stage and adds the time until its
+ * destruction to it. A timer inside the same stage only counts the outermost
+ * entry, so recursive calls are not timed twice.
+ */
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(Stage stage);
+  ~ScopedTimer();
+  ScopedTimer(const ScopedTimer &)            = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  const bool Nested;
+  StageGuard Guard;
+  const Stage TimedStage;
+  const std::chrono::steady_clock::time_point Start;
+};
+
+/**
+ * @brief GetProfile sums the counts and times of all threads, including the
+ * ones which have already finished
+ */
+Profile GetProfile();
+
+/**
+ * @brief Reset sets all counts and times to zero
+ */
+void Reset();
+
+/**
+ * @brief GetReport formats the profile as a table with one row per stage
+ */
+std::string GetReport(const Profile &profile = GetProfile());
+
+/**
+ * @brief GetJSON formats the profile as a JSON object with one entry per stage
+ */
+std::string GetJSON(const Profile &profile = GetProfile());
+
+/**
+ * @brief WriteJSON writes GetJSON(profile) to the file
+ */
+void WriteJSON(const std::string &file, const Profile &profile = GetProfile());
+
+/**
+ * @brief SetJSONOutput writes the profile to the file at the exit of the
+ * program, in addition to the report written with LoggingLevel::Profile
+ */
+void SetJSONOutput(const std::string &file);
+
+/**
+ * @brief IsEnabled true if BSMPT was configured with profiling
+ */
+constexpr bool IsEnabled()
+{
+#ifdef BSMPTEnableProfiling
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace Profiler
+} // namespace BSMPT
+
+#define BSMPT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define BSMPT_PROFILE_CONCAT(a, b) BSMPT_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef BSMPTEnableProfiling
+/**
+ * @brief BSMPT_PROFILE_COUNT counts a call of the given Profiler::Counter
+ */
+#define BSMPT_PROFILE_COUNT(counter)                                           \
+  BSMPT::Profiler::Count(BSMPT::Profiler::Counter::counter)
+/**
+ * @brief BSMPT_PROFILE_STAGE times the rest of the scope as the given
+ * Profiler::Stage
+ */
+#define BSMPT_PROFILE_STAGE(stage)                                             \
+  BSMPT::Profiler::ScopedTimer BSMPT_PROFILE_CONCAT(BSMPTProfileTimer,         \
+                                                    __LINE__)(                 \
+      BSMPT::Profiler::Stage::stage)
+#else
+#define BSMPT_PROFILE_COUNT(counter)                                           \
+  do                                                                           \
+  {                                                                            \
+  } while (false)
+#define BSMPT_PROFILE_STAGE(stage)                                             \
+  do                                                                           \
+  {                                                                            \
+  } while (false)
+#endif
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * Process-wide work-stealing thread pool shared by the minimizers, the tracers
+ * and the parallel calculation of parameter points
+ */
+namespace BSMPT
+{
+
+class TaskGroup;
+
+/**
+ * @brief GetNumberOfThreads resolves the thread count given by the user
+ * @param NumberOfThreads requested number of threads, values < 1 use all
+ * available cores
+ * @return number of threads, at least 1
+ */
+inline std::size_t GetNumberOfThreads(int NumberOfThreads)
+{
+  if (NumberOfThreads > 0) return static_cast<std::size_t>(NumberOfThreads);
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief The ThreadPool class executes the tasks of TaskGroups on a fixed set
+ * of worker threads.
+ *
+ * Every worker owns a deque of tasks. Tasks submitted from a worker are pushed
+ * to its own deque and taken from the back, tasks submitted from any other
+ * thread go to a shared injection queue. An idle worker steals from the front
+ * of the other deques. A thread waiting for a TaskGroup executes the pending
+ * tasks of this group itself, so nested parallel sections neither deadlock nor
+ * start additional threads. A pool with a concurrency of N therefore has N - 1
+ * workers, the N-th thread is the one waiting for the results.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief ThreadPool starts the worker threads
+   * @param Concurrency number of threads working on the tasks including the
+   * waiting thread, values < 1 use all available cores
+   */
+  explicit ThreadPool(int Concurrency);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &)            = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief GetConcurrency number of threads working on the tasks, the worker
+   * threads and the waiting thread
+   */
+  std::size_t GetConcurrency() const;
+
+  /**
+   * @brief Global returns the process-wide pool, which is created on first use
+   * with the concurrency set by SetGlobalConcurrency
+   */
+  static ThreadPool &Global();
+
+  /**
+   * @brief SetGlobalConcurrency sets the concurrency of the process-wide pool.
+   * An existing pool is replaced, which must not happen while tasks are
+   * running, so this should be called right after parsing the command line.
+   * @param Concurrency number of threads, values < 1 use all available cores
+   */
+  static void SetGlobalConcurrency(int Concurrency);
+
+private:
+  friend class TaskGroup;
+
+  struct Task
+  {
+    std::function<void()> Function;
+    TaskGroup *Group;
+    std::atomic<bool> Claimed{false};
+  };
+
+  struct TaskQueue
+  {
+    std::mutex Mutex;
+    std::deque<std::shared_ptr<Task>> Tasks;
+  };
+
+  /**
+   * @brief Submit pushes the task to the queue of the calling worker or to the
+   * injection queue and wakes up a sleeping worker
+   */
+  void Submit(const std::shared_ptr<Task> &task);
+
+  /**
+   * @brief TakeTask takes the next task for the worker with index
+   * WorkerIndex, first from its own queue, then from the injection queue and
+   * finally from the other workers
+   * @return the task or nullptr if all queues are empty
+   */
+  std::shared_ptr<Task> TakeTask(std::size_t WorkerIndex);
+
+  /**
+   * @brief Execute runs the task if no other thread has claimed it before
+   */
+  static void Execute(const std::shared_ptr<Task> &task);
+
+  void WorkerLoop(std::size_t WorkerIndex);
+
+  std::vector<std::unique_ptr<TaskQueue>> Queues;
+  TaskQueue InjectionQueue;
+  std::vector<std::thread> Workers;
+
+  std::mutex SleepMutex;
+  std::condition_variable Wakeup;
+  std::size_t QueuedTasks{0};
+  bool Stop{false};
+};
+
+/**
+ * @brief The TaskGroup class collects tasks which are waited for together.
+ *
+ * The first exception thrown by a task is rethrown by Wait. The destructor
+ * waits for all tasks which are still running and discards their exceptions.
+ */
+class TaskGroup
+{
+public:
+  explicit TaskGroup(ThreadPool &pool = ThreadPool::Global());
+  ~TaskGroup();
+  TaskGroup(const TaskGroup &)            = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  /**
+   * @brief Run submits Function to the pool
+   */
+  void Run(std::function<void()> Function);
+
+  /**
+   * @brief Wait executes the pending tasks of this group on the calling thread
+   * and waits until the tasks taken by the workers are finished
+   */
+  void Wait();
+
+  /**
+   * @brief GetConcurrency number of threads of the pool this group submits to
+   */
+  std::size_t GetConcurrency() const { return Pool.GetConcurrency(); }
+
+private:
+  friend class ThreadPool;
+
+  /**
+   * @brief Finish marks a task of this group as finished and stores the first
+   * exception
+   */
+  void Finish(std::exception_ptr TaskError);
+
+  ThreadPool &Pool;
+  std::mutex Mutex;
+  std::condition_variable Finished;
+  std::vector<std::shared_ptr<ThreadPool::Task>> Pending;
+  std::size_t Unfinished{0};
+  std::exception_ptr Error;
+};
+
+} // namespace BSMPT
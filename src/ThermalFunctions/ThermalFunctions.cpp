@@ -12,7 +12,9 @@
 #include <BSMPT/ThermalFunctions/ThermalFunctions.h>
 #include <BSMPT/ThermalFunctions/thermalcoefficientcalculator.h>
 #include <BSMPT/models/SMparam.h>
+#include <BSMPT/utility/Profiler.h>
 #include <complex>
+#include <limits>
 #include <map>
 
 #include <iostream>
@@ -69,6 +71,44 @@ ThermalCoefficientCalculator JInterpolatedHighCoefficientCalculator(
              gsl_sf_gamma(2.5 - l);
     },
     5);
+
+/**
+ * @brief LowExpansionBatch calculates the sum over l = 2 to n of Kl (-x /
+ * (4 pi^2))^l with the Horner scheme
+ */
+Eigen::ArrayXd LowExpansionBatch(const Eigen::ArrayXd &x,
+                                 const int &n,
+                                 const ThermalCoefficientCalculator &Calculator)
+{
+  const double Base = -1 / (4 * M_PI * M_PI);
+  Eigen::ArrayXd sum =
+      Eigen::ArrayXd::Constant(x.size(),
+                               Calculator.GetCoefficentAtOrder(n) *
+                                   std::pow(Base, n));
+  for (int l = n - 1; l >= 2; l--)
+  {
+    sum = sum * x + Calculator.GetCoefficentAtOrder(l) * std::pow(Base, l);
+  }
+  return sum * x.square();
+}
+
+/**
+ * @brief HighExpansionBatch calculates JInterpolatedHigh(x,n) for all entries
+ * of x
+ */
+Eigen::ArrayXd HighExpansionBatch(const Eigen::ArrayXd &x, const int &n)
+{
+  const Eigen::ArrayXd sqrtx = x.sqrt();
+  const Eigen::ArrayXd inv   = sqrtx.inverse();
+  Eigen::ArrayXd sum         = Eigen::ArrayXd::Constant(
+      x.size(), JInterpolatedHighCoefficientCalculator.GetCoefficentAtOrder(n));
+  for (int l = n - 1; l >= 0; l--)
+  {
+    sum = sum * inv +
+          JInterpolatedHighCoefficientCalculator.GetCoefficentAtOrder(l);
+  }
+  return -(-sqrtx).exp() * std::sqrt(M_PI / 2) * sqrtx * sqrtx.sqrt() * sum;
+}
 } // namespace
 
 double JbosonIntegrand(const double &x, const double &k, int diff)
@@ -187,6 +227,10 @@ double JfermionInterpolatedLow(const double &x, const int &n, int diff)
   {
     return pow(M_PI, 2) / 24;
   }
+  else if (x == 0 and diff == 2)
+  {
+    return -std::numeric_limits<double>::infinity();
+  }
   using std::log;
   using std::pow;
   double res = 0;
@@ -220,6 +264,20 @@ double JfermionInterpolatedLow(const double &x, const int &n, int diff)
     }
     res += sum;
   }
+  else if (diff == 2)
+  {
+    res = (-6 * cf + 3) / 96;
+    res += (log(x) + 1) / 16;
+    double sum = 0;
+    for (int l = 2; l <= n; l++)
+    {
+      double Kl =
+          FermionInterpolatedLowCoefficientCalculator.GetCoefficentAtOrder(l);
+      sum += Kl * pow(-x / 4.0, l - 1) * (l + 1) * l * pow(M_PI, 2 - 2 * l) /
+             4.0;
+    }
+    res += sum;
+  }
 
   return res;
 }
@@ -234,6 +292,10 @@ double JbosonInterpolatedLow(const double &x, const int &n, int diff)
   {
     return pow(M_PI, 2) / 12.0;
   }
+  else if (x == 0 and diff == 2)
+  {
+    return -std::numeric_limits<double>::infinity();
+  }
   using std::log;
   using std::pow;
   using std::sqrt;
@@ -269,6 +331,21 @@ double JbosonInterpolatedLow(const double &x, const int &n, int diff)
     }
     res += sum;
   }
+  else if (diff == 2)
+  {
+    res = (6 * cb - 3) / 96.0;
+    res += -(log(x) + 1) / 16.0;
+    res += -M_PI / (8 * sqrt(x));
+    double sum = 0;
+    for (int l = 2; l <= n; l++)
+    {
+      double Kl =
+          BosonInterpolatedLowCoefficientCalculator.GetCoefficentAtOrder(l);
+      sum += -Kl * pow(-x / 4.0, l - 1) * (l + 1) * l * pow(M_PI, 2 - 2 * l) /
+             4.0;
+    }
+    res += sum;
+  }
   return res;
 }
 
@@ -297,15 +374,29 @@ double JInterpolatedHigh(const double &x, const int &n, int diff)
     {
       double Kl =
           JInterpolatedHighCoefficientCalculator.GetCoefficentAtOrder(l);
-      sum += Kl * pow(x, (1 - l) / 2) * (2 * l + 2 * sqrt(x) - 3);
+      sum += Kl * pow(x, (1.0 - l) / 2) * (2 * l + 2 * sqrt(x) - 3);
     }
     res = exp(-sqrt(x)) * sqrt(2 * M_PI) / (8 * pow(x, 3.0 / 4.0)) * sum;
   }
+  else if (diff == 2)
+  {
+    double sum = 0;
+    for (int l = 0; l <= n; l++)
+    {
+      double Kl =
+          JInterpolatedHighCoefficientCalculator.GetCoefficentAtOrder(l);
+      double a = -0.25 - l / 2.0;
+      sum += Kl * pow(x, a - 1) *
+             ((a - sqrt(x) / 2) * (2 * l + 2 * sqrt(x) - 3) + sqrt(x));
+    }
+    res = exp(-sqrt(x)) * sqrt(2 * M_PI) / 8 * sum;
+  }
   return res;
 }
 
 double JfermionInterpolated(const double &x, int diff)
 {
+  BSMPT_PROFILE_COUNT(JfermionInterpolated);
   double res = 0;
   if (x >= C_FermionTheta)
   {
@@ -321,6 +412,7 @@ double JfermionInterpolated(const double &x, int diff)
 
 double JbosonInterpolated(const double &x, int diff)
 {
+  BSMPT_PROFILE_COUNT(JbosonInterpolated);
   double res = 0;
   if (x >= C_BosonTheta)
   {
@@ -338,6 +430,53 @@ double JbosonInterpolated(const double &x, int diff)
   return res;
 }
 
+Eigen::ArrayXd JbosonInterpolatedBatch(const Eigen::ArrayXd &x)
+{
+  using std::log;
+  using std::pow;
+  // Entries outside of the range of an expansion are moved into it, so that
+  // the discarded branch of the selection stays finite
+  const Eigen::ArrayXd xLow =
+      x.max(std::numeric_limits<double>::min()).min(C_BosonTheta);
+  const Eigen::ArrayXd xHigh = x.max(C_BosonTheta);
+
+  const double cb    = 1.5 + 2 * log(4 * M_PI) - 2 * C_euler_gamma;
+  Eigen::ArrayXd Low =
+      -pow(M_PI, 4) / 45.0 + pow(M_PI, 2) * xLow / 12.0 -
+      M_PI * xLow * xLow.sqrt() / 6 - xLow.square() * (xLow.log() - cb) / 32.0 +
+      pow(M_PI, 2) * xLow *
+          LowExpansionBatch(xLow, 3, BosonInterpolatedLowCoefficientCalculator);
+
+  Eigen::ArrayXd res =
+      (x >= C_BosonTheta)
+          .select(HighExpansionBatch(xHigh, 3) - C_BosonShift, Low);
+  for (Eigen::Index i = 0; i < x.size(); i++)
+  {
+    if (x(i) < 0) res(i) = JbosonInterpolatedNegative(x(i));
+  }
+  return res;
+}
+
+Eigen::ArrayXd JfermionInterpolatedBatch(const Eigen::ArrayXd &x)
+{
+  using std::log;
+  using std::pow;
+  const Eigen::ArrayXd xLow =
+      x.max(std::numeric_limits<double>::min()).min(C_FermionTheta);
+  const Eigen::ArrayXd xHigh = x.max(C_FermionTheta);
+
+  const double cf = 1.5 + 2 * log(4 * M_PI) - 2 * C_euler_gamma - 2 * log(4);
+  Eigen::ArrayXd Low =
+      -7 * pow(M_PI, 4) / 360.0 + pow(M_PI, 2) / 24 * xLow +
+      1 / 32.0 * xLow.square() * (xLow.log() - cf) -
+      pow(M_PI, 2) * xLow *
+          LowExpansionBatch(
+              xLow, 4, FermionInterpolatedLowCoefficientCalculator);
+
+  return (x >= C_FermionTheta)
+      .select(-HighExpansionBatch(xHigh, 3), -Low - C_FermionShift);
+}
+
 double JbosonInterpolatedNegative(const double &x, int diff)
 {
   if (x >= 0) return 0;
@@ -351,6 +490,10 @@ double JbosonInterpolatedNegative(const double &x, int diff)
   {
     PotVal = -JbosonNegativeSpline.deriv(1, -x);
   }
+  else if (diff == 2)
+  {
+    PotVal = JbosonNegativeSpline.deriv(2, -x);
+  }
 
   return PotVal;
 }
@@ -12,6 +12,7 @@
 #include <BSMPT/WallThickness/WallThicknessLib.h>
 #include <BSMPT/minimizer/MinimizePlane.h>
 #include <BSMPT/models/ClassPotentialOrigin.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/utility.h>
 
 #include <gsl/gsl_min.h>
@@ -21,18 +22,11 @@
 #include <fstream>
 #include <random>
 
-#include <atomic>
-#include <mutex>
-#include <queue>
-#include <thread>
-
 namespace BSMPT
 {
 namespace Wall
 {
 
-const std::size_t Num_threads = std::thread::hardware_concurrency();
-
 double calculate_wall_thickness_plane(
     const std::shared_ptr<Class_Potential_Origin> &modelPointer,
     const double &Temp,
@@ -51,10 +45,6 @@ double calculate_wall_thickness_plane(
   int maxstep     = 10;
   double Stepsize = 1.0 / (maxstep);
   std::vector<double> Data_min_negative(maxstep + 1);
-  std::vector<std::thread> Data_min_threads(Num_threads);
-
-  std::atomic<std::size_t> DataIndex{0};
-  std::mutex WriteLock;
 
   std::vector<std::pair<int, std::vector<double>>> BasePoints;
   for (int ncounter = 0; ncounter <= maxstep; ++ncounter)
@@ -69,57 +59,23 @@ double calculate_wall_thickness_plane(
     BasePoints.push_back(std::make_pair(ncounter, basepoint));
   }
 
-  auto thread_Job =
-      [](std::atomic<std::size_t> &mDataIndex,
-         std::vector<std::pair<int, std::vector<double>>> &a_BasePoints,
-         std::vector<double> &Data_min,
-         std::mutex &mWriteResultLock,
-         const std::vector<double> &a_vevsymmetric,
-         const std::vector<double> &a_vcritical,
-         std::shared_ptr<Class_Potential_Origin> a_modelPointer,
-         const double &a_Temp,
-         const int &a_WhichMinimizer)
-  {
-    while (mDataIndex < a_BasePoints.size())
-    {
-      const auto data         = a_BasePoints.at(mDataIndex++);
-      auto MinimumPlaneResult = Minimizer::MinimizePlane(data.second,
-                                                         a_vevsymmetric,
-                                                         a_vcritical,
-                                                         a_modelPointer,
-                                                         a_Temp,
-                                                         a_WhichMinimizer);
-      {
-        std::unique_lock<std::mutex> lock(mWriteResultLock);
-        Data_min.at(data.first) = -MinimumPlaneResult.PotVal;
-      }
-    }
-  };
-
-  for (auto &thr : Data_min_threads)
+  // Every plane is minimised as a task of the global thread pool
+  TaskGroup PlaneTasks;
+  for (const auto &data : BasePoints)
   {
-    thr = std::thread(
+    PlaneTasks.Run(
         [&]()
         {
-          thread_Job(DataIndex,
-                     BasePoints,
-                     Data_min_negative,
-                     WriteLock,
-                     vevsymmetric,
-                     vcritical,
-                     modelPointer,
-                     Temp,
-                     WhichMinimizer);
+          auto MinimumPlaneResult = Minimizer::MinimizePlane(data.second,
+                                                             vevsymmetric,
+                                                             vcritical,
+                                                             modelPointer,
+                                                             Temp,
+                                                             WhichMinimizer);
+          Data_min_negative.at(data.first) = -MinimumPlaneResult.PotVal;
         });
   }
-
-  for (auto &thr : Data_min_threads)
-  {
-    if (thr.joinable())
-    {
-      thr.join();
-    }
-  }
+  PlaneTasks.Wait();
 
   struct GSL_params spline;
   boost_cubic_b_spline<double> splinef(
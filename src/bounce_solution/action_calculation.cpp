@@ -9,6 +9,7 @@
 
 #include <BSMPT/bounce_solution/action_calculation.h>
 #include <BSMPT/utility/NumericalDerivatives.h>
+#include <BSMPT/utility/Profiler.h>
 
 namespace BSMPT
 {
@@ -42,6 +43,34 @@ BounceActionInt::BounceActionInt(
   SetPath(InitPath_In);
 }
 
+BounceActionInt::BounceActionInt(
+    std::vector<std::vector<double>> InitPath_In,
+    std::vector<double> TrueVacuum_In,
+    std::vector<double> FalseVacuum_In,
+    std::function<double(std::vector<double>)> &V_In,
+    std::function<std::vector<double>(std::vector<double>)> &dV_In,
+    std::function<std::vector<std::vector<double>>(std::vector<double>)>
+        &Hessian_In,
+    double T_In,
+    int MaxPathIntegrations_In)
+{
+  // Initialization of the class when the derivative and the Hessian are
+  // provided
+  this->dim    = InitPath_In.at(0).size();
+  this->Vfalse = V_In(FalseVacuum_In);
+  this->V = [&](std::vector<double> vev) { return V_In(vev) - this->Vfalse; };
+  // Use the provided derivatives
+  this->dV                  = dV_In;
+  this->Hessian             = Hessian_In;
+  this->TrueVacuum          = TrueVacuum_In;
+  this->FalseVacuum         = FalseVacuum_In;
+  this->InitPath            = InitPath_In;
+  this->T                   = T_In;
+  this->MaxPathIntegrations = MaxPathIntegrations_In;
+  // Set Spline path
+  SetPath(InitPath_In);
+}
+
 BounceActionInt::BounceActionInt(
     std::vector<std::vector<double>> InitPath_In,
     std::vector<double> TrueVacuum_In,
@@ -1546,6 +1575,7 @@ BounceActionInt::CalculatePotentialTermAction(const std::vector<double> &rho,
 void BounceActionInt::CalculateAction(
     double error) // Alpha = 2 at T > 0 and Alpha = 3 at T = 0
 {
+  BSMPT_PROFILE_STAGE(Bounce);
   std::stringstream ss;
   if (Calc_d2Vdl2(Spline.L) < 0)
   {
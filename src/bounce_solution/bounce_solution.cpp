@@ -8,6 +8,7 @@
  */
 
 #include <BSMPT/bounce_solution/bounce_solution.h>
+#include <BSMPT/utility/Profiler.h>
 
 namespace BSMPT
 {
@@ -163,6 +164,12 @@ void BounceSolution::GWInitialScan()
       // Potential wrapper
       return modelPointer->VEff(modelPointer->MinimizeOrderVEV(vev), T);
     };
+    std::function<std::vector<double>(std::vector<double>)> dV =
+        [&](std::vector<double> vev)
+    { return MinTracer->GradientVEVSpace(vev, T); };
+    std::function<std::vector<std::vector<double>>(std::vector<double>)>
+        Hessian = [&](std::vector<double> vev)
+    { return MinTracer->HessianVEVSpace(vev, T); };
     if (last_action < 0)
     {
       path = {TrueVacuum, FalseVacuum};
@@ -176,7 +183,7 @@ void BounceSolution::GWInitialScan()
                                  FalseVacuum);
     }
     BounceActionInt bc(
-        path, TrueVacuum, FalseVacuum, V, T, MaxPathIntegrations);
+        path, TrueVacuum, FalseVacuum, V, dV, Hessian, T, MaxPathIntegrations);
     bc.CalculateAction();
 
     last_path        = bc.Path;
@@ -203,6 +210,7 @@ void BounceSolution::GWInitialScan()
 
 void BounceSolution::CalculateActionAt(double T, bool smart)
 {
+  BSMPT_PROFILE_STAGE(Bounce);
   // Action outside allowed range
   if (T < Tm or T > Tc) return;
   Logger::Write(LoggingLevel::BounceDetailed, " T = " + std::to_string(T));
@@ -231,6 +239,12 @@ void BounceSolution::CalculateActionAt(double T, bool smart)
       // Potential wrapper
       return modelPointer->VEff(modelPointer->MinimizeOrderVEV(vev), T);
     };
+    std::function<std::vector<double>(std::vector<double>)> dV =
+        [&](std::vector<double> vev)
+    { return MinTracer->GradientVEVSpace(vev, T); };
+    std::function<std::vector<std::vector<double>>(std::vector<double>)>
+        Hessian = [&](std::vector<double> vev)
+    { return MinTracer->HessianVEVSpace(vev, T); };
     std::vector<std::vector<double>> path;
 
     if (smart)
@@ -243,7 +257,7 @@ void BounceSolution::CalculateActionAt(double T, bool smart)
       path = {TrueVacuum, FalseVacuum};
 
     BounceActionInt bc(
-        path, TrueVacuum, FalseVacuum, V, T, MaxPathIntegrations);
+        path, TrueVacuum, FalseVacuum, V, dV, Hessian, T, MaxPathIntegrations);
     bc.CalculateAction();
     if (bc.Action / T > 0)
     {
@@ -266,10 +280,16 @@ void BounceSolution::CalculateActionAt(double T, bool smart)
       // Potential wrapper
       return modelPointer->VEff(modelPointer->MinimizeOrderVEV(vev), T);
     };
+    std::function<std::vector<double>(std::vector<double>)> dV =
+        [&](std::vector<double> vev)
+    { return MinTracer->GradientVEVSpace(vev, T); };
+    std::function<std::vector<std::vector<double>>(std::vector<double>)>
+        Hessian = [&](std::vector<double> vev)
+    { return MinTracer->HessianVEVSpace(vev, T); };
     std::vector<std::vector<double>> path = {TrueVacuum, FalseVacuum};
 
     BounceActionInt bc(
-        path, TrueVacuum, FalseVacuum, V, T, MaxPathIntegrations);
+        path, TrueVacuum, FalseVacuum, V, dV, Hessian, T, MaxPathIntegrations);
     bc.CalculateAction();
     if (bc.Action / T > 0)
     {
@@ -8,6 +8,7 @@
  */
 
 #include <BSMPT/gravitational_waves/gw.h>
+#include <BSMPT/utility/Profiler.h>
 
 namespace BSMPT
 {
@@ -16,6 +17,7 @@ GravitationalWave::GravitationalWave(
     BounceSolution &BACalc,
     const TransitionTemperature &which_transition_temp)
 {
+  BSMPT_PROFILE_STAGE(GravitationalWaves);
   BACalc.SetAndCalculateGWParameters(which_transition_temp);
   data.transitionTemp = BACalc.GetTransitionTemp();
   data.reheatingTemp  = BACalc.GetReheatingTemp();
@@ -330,6 +332,7 @@ double GravitationalWave::CalcGWAmplitude(double f)
 double
 GravitationalWave::GetSNR(const double fmin, const double fmax, const double T)
 {
+  BSMPT_PROFILE_STAGE(GravitationalWaves);
   auto integral     = Nintegrate_SNR(*this, fmin, fmax);
   double res        = std::sqrt(86400 * 365.25 * T * integral.result);
   this->data.status = StatusGW::Success;
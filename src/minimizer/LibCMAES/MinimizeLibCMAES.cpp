@@ -10,16 +10,25 @@
 
 #include <BSMPT/minimizer/LibCMAES/MinimizeLibCMAES.h>
 #include <BSMPT/minimizer/MinimizePlane.h>
+#include <BSMPT/minimizer/MinimizerBudget.h>
 #include <BSMPT/models/ClassPotentialOrigin.h>
-
-#include <libcmaes/candidate.h>       // for Candidate
-#include <libcmaes/cmaes.h>           // for cmaes
-#include <libcmaes/cmaparameters.h>   // for CMAParameters
-#include <libcmaes/cmasolutions.h>    // for CMASolutions
-#include <libcmaes/esoptimizer.h>     // for aCMAES
-#include <libcmaes/esostrategy.h>     // for FitFunc
-#include <libcmaes/genopheno.h>       // for GenoPheno
-#include <libcmaes/noboundstrategy.h> // for libcmaes
+#include <BSMPT/utility/ThreadPool.h>
+
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <random>
+
+#include <libcmaes/acovarianceupdate.h> // for ACovarianceUpdate
+#include <libcmaes/candidate.h>         // for Candidate
+#include <libcmaes/cmaes.h>             // for cmaes
+#include <libcmaes/cmaparameters.h>     // for CMAParameters
+#include <libcmaes/cmasolutions.h>      // for CMASolutions
+#include <libcmaes/cmastrategy.h>       // for CMAStrategy
+#include <libcmaes/esoptimizer.h>       // for aCMAES
+#include <libcmaes/esostrategy.h>       // for FitFunc
+#include <libcmaes/genopheno.h>         // for GenoPheno
+#include <libcmaes/noboundstrategy.h>   // for libcmaes
 
 namespace BSMPT
 {
@@ -30,9 +39,51 @@ namespace LibCMAES
 
 using namespace libcmaes;
 
+namespace
+{
+/**
+ * @brief RunCMAES runs aCMA-ES generation by generation. The candidates of each
+ * generation are evaluated together by EvaluatePopulation before libcmaes asks
+ * for their values, func is only called for points outside of the population.
+ * The run ends early once the budget is exhausted.
+ */
+CMASolutions RunCMAES(
+    FitFunc &func,
+    const std::function<void(const dMat &, std::vector<double> &)>
+        &EvaluatePopulation,
+    CMAParameters<> &cmaparams,
+    MinimizerBudgetTracker *Budget)
+{
+  dMat Population;
+  std::vector<double> Values;
+  FitFunc PopulationValue = [&](const double *v, const int &N)
+  {
+    for (int r = 0; r < Population.cols(); r++)
+    {
+      if (std::equal(v, v + N, Population.col(r).data())) return Values.at(r);
+    }
+    return func(v, N);
+  };
+
+  ESOptimizer<CMAStrategy<ACovarianceUpdate>, CMAParameters<>> optim(
+      PopulationValue, cmaparams);
+  while (not optim.stop() and not(Budget and Budget->Exhausted()))
+  {
+    Population = optim.ask();
+    EvaluatePopulation(Population, Values);
+    optim.eval(Population);
+    optim.tell();
+    optim.inc_iter();
+  }
+  return optim.get_solutions();
+}
+} // namespace
+
 LibCMAESReturn min_cmaes_gen_all(const Class_Potential_Origin &model,
                                  const double &Temp,
-                                 const std::vector<double> &Start)
+                                 const std::vector<double> &Start,
+                                 const LibCMAESSettings &Settings,
+                                 MinimizerBudgetTracker *Budget)
 {
 
   const auto dim = model.get_nVEV();
@@ -44,19 +95,17 @@ LibCMAESReturn min_cmaes_gen_all(const Class_Potential_Origin &model,
 
   // sigma *= 0.5;//0.5;
   double ftol = 1e-5;
+  if (Budget and Budget->GetBudget().TargetTolerance > 0)
+  {
+    ftol = Budget->GetBudget().TargetTolerance;
+  }
 
-  // CMAParameters<> cmaparams(dim,&x0.front(),sigma);
-  CMAParameters<> cmaparams(x0, sigma);
-
-  // cmaparams.set_mt_feval(true);
-  cmaparams.set_algo(aCMAES);
-  // cmaparams.set_elitism(1);
-  // cmaparams.set_noisy();
-  cmaparams.set_ftolerance(ftol);
-
+  std::size_t NumberOfEvaluations = 0;
   FitFunc cmafunc = [&](const double *v, const int &N)
   {
     (void)N;
+    NumberOfEvaluations++;
+    if (Budget) Budget->Count();
     std::vector<double> vev;
     for (std::size_t i{0}; i < dim; ++i)
       vev.push_back(v[i]);
@@ -65,7 +114,108 @@ LibCMAESReturn min_cmaes_gen_all(const Class_Potential_Origin &model,
     return VeffVal;
   };
 
-  CMASolutions cmasols = cmaes<>(cmafunc, cmaparams);
+  auto EvaluatePopulation = [&](const dMat &Population,
+                                std::vector<double> &Values)
+  {
+    const std::size_t NumberOfCandidates = Population.cols();
+    const std::size_t NHiggs             = model.get_NHiggs();
+    NumberOfEvaluations += NumberOfCandidates;
+    if (Budget) Budget->Count(NumberOfCandidates);
+    std::vector<double> points;
+    points.reserve(NumberOfCandidates * NHiggs);
+    for (std::size_t r = 0; r < NumberOfCandidates; r++)
+    {
+      const double *v = Population.col(r).data();
+      const auto minOrdVEV =
+          model.MinimizeOrderVEV(std::vector<double>(v, v + dim));
+      points.insert(points.end(), minOrdVEV.begin(), minOrdVEV.end());
+    }
+    if (not Settings.ParallelPopulation)
+    {
+      model.VEffBatch(points, Temp, Values);
+      return;
+    }
+
+    // One batch per thread of the pool
+    Values.resize(NumberOfCandidates);
+    TaskGroup Evaluations;
+    const std::size_t NumberOfBatches =
+        std::min(NumberOfCandidates, Evaluations.GetConcurrency());
+    for (std::size_t batch = 0; batch < NumberOfBatches; batch++)
+    {
+      const std::size_t begin = batch * NumberOfCandidates / NumberOfBatches;
+      const std::size_t end =
+          (batch + 1) * NumberOfCandidates / NumberOfBatches;
+      Evaluations.Run(
+          [&, begin, end]()
+          {
+            std::vector<double> BatchValues;
+            model.VEffBatch(
+                std::vector<double>(points.begin() + begin * NHiggs,
+                                    points.begin() + end * NHiggs),
+                Temp,
+                BatchValues);
+            std::copy(
+                BatchValues.begin(), BatchValues.end(), Values.begin() + begin);
+          });
+    }
+    Evaluations.Wait();
+  };
+
+  auto Run = [&](int lambda, double RunSigma)
+  {
+    CMAParameters<> cmaparams(x0, RunSigma, lambda);
+    cmaparams.set_algo(aCMAES);
+    cmaparams.set_ftolerance(ftol);
+    return RunCMAES(cmafunc, EvaluatePopulation, cmaparams, Budget);
+  };
+
+  CMASolutions cmasols = Run(-1, sigma);
+
+  if (Settings.Restarts != CMAESRestartStrategy::None)
+  {
+    // BIPOP spends at most as many evaluations in the regime with small
+    // populations as in the one with growing populations
+    const int DefaultLambda =
+        4 + static_cast<int>(std::floor(3 * std::log(dim)));
+    int LargeLambda         = DefaultLambda;
+    std::size_t LargeBudget = NumberOfEvaluations, SmallBudget = 0;
+    std::default_random_engine randGen(dim);
+    std::uniform_real_distribution<double> Uniform(0, 1);
+    for (int i = 0;
+         i < Settings.MaxRestarts and not(Budget and Budget->Exhausted());
+         i++)
+    {
+      const bool SmallRegime =
+          Settings.Restarts == CMAESRestartStrategy::BIPOP and
+          SmallBudget < LargeBudget;
+      const std::size_t EvaluationsBefore = NumberOfEvaluations;
+      CMASolutions Restart;
+      if (SmallRegime)
+      {
+        const double u = Uniform(randGen);
+        const int lambda =
+            std::max(DefaultLambda,
+                     static_cast<int>(DefaultLambda *
+                                      std::pow(0.5 * LargeLambda /
+                                                   DefaultLambda,
+                                               u * u)));
+        Restart = Run(lambda, sigma * std::pow(10, -2 * u));
+        SmallBudget += NumberOfEvaluations - EvaluationsBefore;
+      }
+      else
+      {
+        LargeLambda *= 2;
+        Restart = Run(LargeLambda, sigma);
+        LargeBudget += NumberOfEvaluations - EvaluationsBefore;
+      }
+      if (Restart.best_candidate().get_fvalue() <
+          cmasols.best_candidate().get_fvalue())
+      {
+        cmasols = Restart;
+      }
+    }
+  }
 
   Candidate bcand = cmasols.best_candidate();
 
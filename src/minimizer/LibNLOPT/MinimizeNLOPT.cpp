@@ -9,6 +9,8 @@
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/utility/utility.h>
 
+#include <cmath>
+
 /**
  *@file
  */
@@ -23,15 +25,31 @@ double
 NLOPTVEff(const std::vector<double> &x, std::vector<double> &grad, void *data)
 {
   auto settings = *static_cast<ShareInformationNLOPT *>(data);
-  (void)grad;
+  if (settings.Budget)
+  {
+    // Ends the optimization, which keeps the best point found so far
+    if (settings.Budget->Exhausted()) throw nlopt::forced_stop();
+    settings.Budget->Count();
+  }
   auto PotVEV = settings.model.MinimizeOrderVEV(x);
+  if (not grad.empty())
+  {
+    // Gradient based algorithms request the derivatives w.r.t. the vevs
+    const auto Gradient  = settings.model.VEffGradient(PotVEV, settings.Temp);
+    const auto &VevOrder = settings.model.Get_VevOrder();
+    for (std::size_t i{0}; i < grad.size(); ++i)
+    {
+      grad.at(i) = Gradient.at(VevOrder.at(i));
+    }
+  }
   return settings.model.VEff(PotVEV, settings.Temp);
 }
 
 NLOPTReturnType MinimizeUsingNLOPT(const Class_Potential_Origin &model,
-                                   const double &Temp)
+                                   const double &Temp,
+                                   MinimizerBudgetTracker *Budget)
 {
-  ShareInformationNLOPT settings(model, Temp);
+  ShareInformationNLOPT settings(model, Temp, Budget);
   std::vector<double> VEV(model.get_nVEV());
 
   nlopt::opt opt(nlopt::GN_ORIG_DIRECT_L,
@@ -53,8 +71,17 @@ NLOPTReturnType MinimizeUsingNLOPT(const Class_Potential_Origin &model,
   opt.set_upper_bounds(UpperBound);
 
   opt.set_min_objective(NLOPTVEff, &settings);
-  opt.set_xtol_rel(1e-4);
-  opt.set_maxeval(1000);
+  double xtol         = 1e-4;
+  std::size_t MaxEval = 1000;
+  if (Budget)
+  {
+    const auto &Limits = Budget->GetBudget();
+    if (Limits.TargetTolerance > 0) xtol = Limits.TargetTolerance;
+    if (Limits.MaxEvaluations > 0) MaxEval = Budget->GetRemainingEvaluations();
+    if (Limits.MaxSeconds > 0) opt.set_maxtime(Budget->GetRemainingSeconds());
+  }
+  opt.set_xtol_rel(xtol);
+  opt.set_maxeval(static_cast<int>(MaxEval));
 
   double minf;
   try
@@ -63,9 +90,24 @@ NLOPTReturnType MinimizeUsingNLOPT(const Class_Potential_Origin &model,
     bool Success = (result == nlopt::SUCCESS) or
                    (result == nlopt::FTOL_REACHED) or
                    (result == nlopt::XTOL_REACHED);
+    // With a budget the limits of the evaluations and the time belong to it
+    if (Budget and (result == nlopt::MAXEVAL_REACHED or
+                    result == nlopt::MAXTIME_REACHED))
+    {
+      Success = Success or Budget->Exhausted();
+    }
     NLOPTReturnType res(VEV, minf, result, Success);
     return res;
   }
+  catch (nlopt::forced_stop &e)
+  {
+    (void)e;
+    // VEV holds the best point found before the budget was exhausted
+    const double BestValue = opt.last_optimum_value();
+    NLOPTReturnType res(
+        VEV, BestValue, nlopt::result::FORCED_STOP, std::isfinite(BestValue));
+    return res;
+  }
   catch (std::exception &e)
   {
     (void)e;
@@ -6,9 +6,9 @@
 
 /**
  * @file
- * Using the Nelder-Mead Simplex algorithm, implemented in gsl, to find multiple
- * local minima of the model and compare them to find a candidate for the global
- * minimum.
+ * Using the Nelder-Mead Simplex algorithm or the BFGS algorithm with the
+ * analytic gradient, implemented in gsl, to find multiple local minima of the
+ * model and compare them to find a candidate for the global minimum.
  */
 
 #include <BSMPT/minimizer/MinimizeGSL.h>
@@ -16,32 +16,176 @@
 
 #include <BSMPT/minimizer/Minimizer.h>
 #include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Potential_Origin
+#include <BSMPT/utility/ThreadPool.h>          // for TaskGroup
 #include <algorithm>                           // for copy, max
+#include <gsl/gsl_blas.h>                      // for gsl_blas_dnrm2
 #include <gsl/gsl_errno.h>                     // for gsl_set_error_handler...
 #include <gsl/gsl_multimin.h>                  // for gsl_multimin_fminimizer
+#include <gsl/gsl_qrng.h>                      // for gsl_qrng_sobol
 #include <gsl/gsl_vector_double.h>             // for gsl_vector_get, gsl_v...
 #include <iostream>                            // for operator<<, endl, bas...
 #include <limits>                              // for numeric_limits, numer...
 #include <memory>                              // for shared_ptr, __shared_...
 #include <random>                              // for default_random_engine
+#include <stdexcept>                           // for runtime_error
 #include <stdio.h>                             // for printf
 #include <time.h>                              // for time, NULL, std::size_t
 #include <vector>                              // for vector
 
 #include <atomic>
-#include <mutex>
-#include <queue>
-#include <thread>
 
 namespace BSMPT
 {
 namespace Minimizer
 {
 
+namespace
+{
+/**
+ * @brief StoppedByBudget true if a local minimization with the given status
+ * has to stop, or was stopped, because the budget of params is exhausted
+ */
+bool StoppedByBudget(const GSL_params &params, int status)
+{
+  return status == GSL_CONTINUE and params.Budget != nullptr and
+         params.Budget->Exhausted();
+}
+
+/**
+ * @brief LocalTolerance tolerance of the local minimizations, GSL_Tolerance
+ * unless the budget of params sets a target tolerance
+ */
+double LocalTolerance(const GSL_params &params)
+{
+  if (params.Budget and params.Budget->GetBudget().TargetTolerance > 0)
+  {
+    return params.Budget->GetBudget().TargetTolerance;
+  }
+  return GSL_Tolerance;
+}
+} // namespace
+
+std::vector<std::vector<double>>
+GSL_StartingPoints(const Class_Potential_Origin &model,
+                   const int &seed,
+                   const GSL_MultistartOptions &Multistart,
+                   const std::size_t &NumberOfPoints)
+{
+  const std::size_t dim = model.get_nVEV();
+  const double RNDMax   = 500;
+
+  std::vector<std::vector<double>> StartingPoints;
+  for (const auto &start : Multistart.WarmStarts)
+  {
+    if (start.size() != dim)
+    {
+      throw std::runtime_error(
+          "The warm start of GSL_Minimize_gen_all has " +
+          std::to_string(start.size()) + " instead of " + std::to_string(dim) +
+          " entries.");
+    }
+    StartingPoints.push_back(start);
+  }
+
+  if (Multistart.UseTreeLevelVacuum)
+  {
+    const auto TreeMin = model.get_vevTreeMin();
+    std::vector<std::vector<double>> Images{TreeMin};
+    const Eigen::Map<const Eigen::VectorXd> vTree(TreeMin.data(), dim);
+    for (const auto &Element : Multistart.SymmetryElements)
+    {
+      const Eigen::VectorXd image = Element * vTree;
+      std::vector<double> Image(image.data(), image.data() + image.size());
+      // Components which vanish give the same image for several elements
+      if (std::find(Images.begin(), Images.end(), Image) == Images.end())
+      {
+        Images.push_back(Image);
+      }
+    }
+    StartingPoints.insert(StartingPoints.end(), Images.begin(), Images.end());
+  }
+
+  std::default_random_engine randGen(seed);
+  auto RandomNumber = [&randGen]()
+  {
+    return std::generate_canonical<double,
+                                   std::numeric_limits<double>::digits>(
+        randGen);
+  };
+
+  if (Multistart.Strategy == GSLSeedingStrategy::Random)
+  {
+    for (std::size_t i{0}; i < NumberOfPoints; ++i)
+    {
+      std::vector<double> start(dim);
+      for (std::size_t j = 0; j < dim; ++j)
+      {
+        start.at(j) = RNDMax * (-1 + 2 * RandomNumber());
+      }
+      StartingPoints.push_back(start);
+    }
+    return StartingPoints;
+  }
+
+  gsl_qrng *Sequence = nullptr;
+  if (Multistart.Strategy == GSLSeedingStrategy::Sobol)
+  {
+    Sequence = gsl_qrng_alloc(gsl_qrng_sobol, dim);
+  }
+  if (Sequence == nullptr)
+  {
+    Sequence = gsl_qrng_alloc(gsl_qrng_halton, dim);
+  }
+  if (Sequence == nullptr)
+  {
+    throw std::runtime_error("No low-discrepancy sequence available for " +
+                             std::to_string(dim) + " dimensions.");
+  }
+
+  // The seed selects a random shift of the sequence on the unit torus, which
+  // keeps the low discrepancy of the points
+  std::vector<double> Shift(dim), x(dim);
+  for (auto &el : Shift)
+  {
+    el = RandomNumber();
+  }
+  for (std::size_t i{0}; i < NumberOfPoints; ++i)
+  {
+    gsl_qrng_get(Sequence, x.data());
+    std::vector<double> start(dim);
+    for (std::size_t j = 0; j < dim; ++j)
+    {
+      double u = x.at(j) + Shift.at(j);
+      if (u >= 1) u -= 1;
+      start.at(j) = RNDMax * (-1 + 2 * u);
+    }
+    StartingPoints.push_back(start);
+  }
+  gsl_qrng_free(Sequence);
+
+  return StartingPoints;
+}
+
+double
+GSL_MinimumDistance(const std::vector<double> &a,
+                    const std::vector<double> &b,
+                    const std::vector<Eigen::MatrixXd> &SymmetryElements)
+{
+  const Eigen::Map<const Eigen::VectorXd> va(a.data(), a.size());
+  const Eigen::Map<const Eigen::VectorXd> vb(b.data(), b.size());
+  double Distance = (va - vb).norm();
+  for (const auto &Element : SymmetryElements)
+  {
+    Distance = std::min(Distance, (Element * va - vb).norm());
+  }
+  return Distance;
+}
+
 double GSL_VEFF_gen_all(const gsl_vector *v, void *p)
 {
 
   struct GSL_params *params = static_cast<GSL_params *>(p);
+  if (params->Budget) params->Budget->Count();
 
   std::vector<double> vMin;
   auto nVEVs = params->model.get_nVEV();
@@ -58,6 +202,38 @@ double GSL_VEFF_gen_all(const gsl_vector *v, void *p)
   return res;
 }
 
+void GSL_VEFF_Gradient_gen_all(const gsl_vector *v, void *p, gsl_vector *df)
+{
+  double f;
+  GSL_VEFF_fdf_gen_all(v, p, &f, df);
+}
+
+void GSL_VEFF_fdf_gen_all(const gsl_vector *v,
+                          void *p,
+                          double *f,
+                          gsl_vector *df)
+{
+  struct GSL_params *params = static_cast<GSL_params *>(p);
+  if (params->Budget) params->Budget->Count();
+
+  auto nVEVs = params->model.get_nVEV();
+  std::vector<double> vMin(nVEVs);
+  for (std::size_t i = 0; i < nVEVs; i++)
+  {
+    vMin[i] = gsl_vector_get(v, i);
+  }
+
+  auto vIn = params->model.MinimizeOrderVEV(vMin);
+
+  *f             = params->model.VEff(vIn, params->Temp, 0);
+  const auto res = params->model.VEffGradient(vIn, params->Temp);
+  const auto &VevOrder = params->model.Get_VevOrder();
+  for (std::size_t i = 0; i < nVEVs; i++)
+  {
+    gsl_vector_set(df, i, res.at(VevOrder.at(i)));
+  }
+}
+
 int GSL_Minimize_From_S_gen_all(struct GSL_params &params,
                                 std::vector<double> &sol,
                                 const std::vector<double> &start)
@@ -70,7 +246,7 @@ int GSL_Minimize_From_S_gen_all(struct GSL_params &params,
   gsl_vector *ss, *x;
   gsl_multimin_function minex_func;
 
-  double ftol         = GSL_Tolerance;
+  double ftol         = LocalTolerance(params);
   std::size_t MaxIter = 600;
 
   std::size_t iter = 0;
@@ -103,9 +279,10 @@ int GSL_Minimize_From_S_gen_all(struct GSL_params &params,
     size   = gsl_multimin_fminimizer_size(s);
     status = gsl_multimin_test_size(size, ftol);
 
-  } while (status == GSL_CONTINUE && iter < MaxIter);
+  } while (status == GSL_CONTINUE && iter < MaxIter &&
+           not StoppedByBudget(params, status));
 
-  if (status == GSL_SUCCESS)
+  if (status == GSL_SUCCESS or StoppedByBudget(params, status))
   {
     for (std::size_t k = 0; k < dim; k++)
       sol.push_back(gsl_vector_get(s->x, k));
@@ -123,16 +300,97 @@ int GSL_Minimize_From_S_gen_all(struct GSL_params &params,
   return status;
 }
 
+int GSL_Minimize_Gradient_From_S_gen_all(struct GSL_params &params,
+                                         std::vector<double> &sol,
+                                         const std::vector<double> &start)
+{
+  gsl_set_error_handler_off();
+
+  const gsl_multimin_fdfminimizer_type *T =
+      gsl_multimin_fdfminimizer_vector_bfgs2;
+  gsl_multimin_fdfminimizer *s = nullptr;
+  gsl_vector *x;
+  gsl_multimin_function_fdf minex_func;
+
+  // Initial step size and accuracy of the line minimisations, 0.1 is the
+  // recommended value for bfgs2
+  double StepSize      = 1;
+  double LineTolerance = 0.1;
+  std::size_t MaxIter  = 200;
+  double Tolerance     = LocalTolerance(params);
+
+  std::size_t iter = 0;
+  int status;
+
+  std::size_t dim = params.model.get_nVEV();
+
+  /* Starting point */
+  x = gsl_vector_alloc(dim);
+  for (std::size_t k = 0; k < dim; k++)
+    gsl_vector_set(x, k, start.at(k));
+
+  /* Initialize method and iterate */
+  minex_func.n      = dim;
+  minex_func.f      = &GSL_VEFF_gen_all;
+  minex_func.df     = &GSL_VEFF_Gradient_gen_all;
+  minex_func.fdf    = &GSL_VEFF_fdf_gen_all;
+  minex_func.params = &params;
+  s                 = gsl_multimin_fdfminimizer_alloc(T, dim);
+  gsl_multimin_fdfminimizer_set(s, &minex_func, x, StepSize, LineTolerance);
+
+  do
+  {
+    iter++;
+    status = gsl_multimin_fdfminimizer_iterate(s);
+
+    if (status) break;
+
+    status = gsl_multimin_test_gradient(s->gradient, Tolerance);
+    if (status == GSL_CONTINUE and
+        gsl_blas_dnrm2(gsl_multimin_fdfminimizer_dx(s)) < Tolerance)
+    {
+      status = GSL_SUCCESS;
+    }
+
+  } while (status == GSL_CONTINUE && iter < MaxIter &&
+           not StoppedByBudget(params, status));
+
+  // No further progress of the line search means the minimum is reached within
+  // the numerical precision of the potential
+  if (status == GSL_ENOPROG and
+      gsl_multimin_test_gradient(s->gradient, 1) == GSL_SUCCESS)
+  {
+    status = GSL_SUCCESS;
+  }
+
+  if (status == GSL_SUCCESS or StoppedByBudget(params, status))
+  {
+    for (std::size_t k = 0; k < dim; k++)
+      sol.push_back(gsl_vector_get(s->x, k));
+  }
+  else
+  {
+    for (std::size_t k = 0; k < dim; k++)
+      sol.push_back(0);
+  }
+
+  gsl_vector_free(x);
+  gsl_multimin_fdfminimizer_free(s);
+
+  return status;
+}
+
 std::pair<std::vector<double>, bool>
 GSL_Minimize_gen_all(const Class_Potential_Origin &model,
                      const double &Temp,
                      const int &seed,
                      const std::size_t &MaxSol,
-                     bool UseMultiThreading)
+                     bool UseMultiThreading,
+                     bool UseGradient)
 {
   std::vector<std::vector<double>> saveAllMinima;
   auto result = GSL_Minimize_gen_all(
-      model, Temp, seed, saveAllMinima, MaxSol, UseMultiThreading);
+      model, Temp, seed, saveAllMinima, MaxSol, UseMultiThreading, UseGradient);
   return result;
 }
 
@@ -140,12 +398,13 @@ std::pair<std::vector<double>, bool>
 GSL_Minimize_gen_all(const Class_Potential_Origin &model,
                      const double &Temp,
                      const int &seed,
-                     bool UseMultiThreading)
+                     bool UseMultiThreading,
+                     bool UseGradient)
 {
   std::vector<std::vector<double>> saveAllMinima;
   std::size_t MaxSol = 20;
   auto result        = GSL_Minimize_gen_all(
-      model, Temp, seed, saveAllMinima, MaxSol, UseMultiThreading);
+      model, Temp, seed, saveAllMinima, MaxSol, UseMultiThreading, UseGradient);
   return result;
 }
 
@@ -155,124 +414,182 @@ GSL_Minimize_gen_all(const Class_Potential_Origin &model,
                      const int &seed,
                      std::vector<std::vector<double>> &saveAllMinima,
                      const std::size_t &MaxSol,
-                     bool UseMultiThreading)
+                     bool UseMultiThreading,
+                     bool UseGradient)
+{
+  return GSL_Minimize_gen_all(model,
+                              Temp,
+                              seed,
+                              GSL_MultistartOptions(),
+                              saveAllMinima,
+                              MaxSol,
+                              UseMultiThreading,
+                              UseGradient);
+}
+
+std::pair<std::vector<double>, bool>
+GSL_Minimize_gen_all(const Class_Potential_Origin &model,
+                     const double &Temp,
+                     const int &seed,
+                     const GSL_MultistartOptions &Multistart,
+                     std::vector<std::vector<double>> &saveAllMinima,
+                     const std::size_t &MaxSol,
+                     bool UseMultiThreading,
+                     bool UseGradient,
+                     MinimizerBudgetTracker *Budget)
 {
-  struct GSL_params params(model, Temp);
+  struct GSL_params params(model, Temp, UseGradient, Budget);
 
   std::size_t dim = model.get_nVEV();
 
-  std::default_random_engine randGen(seed);
-  double RNDMax        = 500;
   std::size_t MaxTries = 600; // 600;
-  std::size_t nCol     = dim + 2;
+  std::size_t nCol     = dim + 3;
 
-  std::queue<std::vector<double>> StartingPoints;
-  for (std::size_t i{0}; i < MaxTries; ++i)
-  {
-    std::vector<double> start(dim);
-    for (std::size_t j = 0; j < dim; ++j)
-    {
-      start.at(j) =
-          RNDMax *
-          (-1 +
-           2 * std::generate_canonical<double,
-                                       std::numeric_limits<double>::digits>(
-                   randGen));
-    }
-    StartingPoints.push(start);
-  }
+  const auto StartingPoints =
+      GSL_StartingPoints(model, seed, Multistart, MaxTries);
 
-  struct MinimizeParams
+  struct StartResult
   {
-    std::vector<double> start;
+    bool Success{false};
     std::vector<double> sol;
-    int GSL_status;
   };
 
-  std::atomic<std::size_t> FoundSolutions{0};
-  std::vector<std::thread> MinThreads;
-  std::mutex WriteResultLock;
-  std::queue<std::vector<double>> Results;
-
-  auto thread_Job = [](std::atomic<std::size_t> &mFoundSolutions,
-                       std::size_t mMaxSol,
-                       std::queue<std::vector<double>> &mStartingPoints,
-                       GSL_params &mparams,
-                       std::mutex &mWriteResultLock,
-                       std::queue<std::vector<double>> &mResults,
-                       bool UseLock = true)
+  // Every start writes its result into its own slot, the slots are processed
+  // in the order given by ProcessingOrder. Entry n holds the index + 1 of the
+  // n-th start to process and stays 0 until this start is finished.
+  const std::size_t NumberOfStarts = StartingPoints.size();
+  std::vector<StartResult> Results(NumberOfStarts);
+  std::vector<std::atomic<std::size_t>> ProcessingOrder(NumberOfStarts);
+  std::atomic<std::size_t> NextStart{0}, NumberOfFinishedStarts{0},
+      NextProcessed{0};
+  std::atomic<bool> Stop{false}, Processing{false};
+  // Only changed by the thread processing the results
+  std::size_t StartsWithoutNewMinimum{0};
+  // Distinct minima together with the number of solutions merged into them
+  std::vector<std::pair<std::vector<double>, std::size_t>> Minima;
+
+  auto AddSolution = [&](std::vector<double> &&sol)
   {
-    while (mFoundSolutions < mMaxSol and not mStartingPoints.empty())
+    if (Multistart.ClusterMinima)
     {
-      std::vector<double> start;
+      for (auto &Minimum : Minima)
       {
-        std::unique_lock<std::mutex> lock;
-        if (UseLock)
+        if (GSL_MinimumDistance(Minimum.first,
+                                sol,
+                                Multistart.SymmetryElements) <=
+            Multistart.BasinTolerance)
         {
-          lock = std::unique_lock<std::mutex>(mWriteResultLock);
+          Minimum.second++;
+          return false;
         }
-        start = mStartingPoints.front();
-        mStartingPoints.pop();
       }
+    }
+    Minima.emplace_back(std::move(sol), 1);
+    return true;
+  };
 
-      std::vector<double> sol;
-      auto status = GSL_Minimize_From_S_gen_all(mparams, sol, start);
-      if (status == GSL_SUCCESS)
+  // The thread which sets Processing clusters the finished starts and decides
+  // when to stop, all others go on with the next starting point. With
+  // Multistart.DeterministicOrder the starts are processed in the order of the
+  // starting points, so the minima and the point at which the search stops do
+  // not depend on the number of threads.
+  auto ProcessResults = [&]()
+  {
+    while (not Stop and not Processing.exchange(true))
+    {
+      std::size_t pos = NextProcessed;
+      while (not Stop and pos < NumberOfStarts and ProcessingOrder.at(pos) != 0)
       {
-        std::unique_lock<std::mutex> lock;
-        if (UseLock)
+        auto &Result = Results.at(ProcessingOrder.at(pos) - 1);
+        ++pos;
+        const bool NewMinimum =
+            Result.Success and AddSolution(std::move(Result.sol));
+        StartsWithoutNewMinimum =
+            NewMinimum ? 0 : StartsWithoutNewMinimum + 1;
+        if (Minima.size() == MaxSol or
+            (Multistart.MaxStartsWithoutNewMinimum > 0 and
+             StartsWithoutNewMinimum >= Multistart.MaxStartsWithoutNewMinimum))
         {
-          lock = std::unique_lock<std::mutex>(mWriteResultLock);
+          Stop = true;
         }
-        ++mFoundSolutions;
-        mResults.push(sol);
       }
+      NextProcessed = pos;
+      Processing    = false;
+      // A start finishing in the meantime could not take over the processing
+      if (pos == NumberOfStarts or ProcessingOrder.at(pos) == 0) break;
     }
   };
 
-  if (UseMultiThreading)
+  auto thread_Job = [&]()
   {
-
-    for (std::size_t i = 0; i < Num_threads; ++i)
+    while (not Stop and not(Budget and Budget->Exhausted()))
     {
-      MinThreads.push_back(std::thread(
-          [&]()
-          {
-            thread_Job(FoundSolutions,
-                       MaxSol,
-                       StartingPoints,
-                       params,
-                       WriteResultLock,
-                       Results);
-          }));
+      const std::size_t index = NextStart++;
+      if (index >= NumberOfStarts) break;
+
+      std::vector<double> sol;
+      const auto &start = StartingPoints.at(index);
+      auto status =
+          params.UseGradient
+              ? GSL_Minimize_Gradient_From_S_gen_all(params, sol, start)
+              : GSL_Minimize_From_S_gen_all(params, sol, start);
+
+      // A start interrupted by the budget contributes its best point
+      auto &Result = Results.at(index);
+      Result.Success =
+          (status == GSL_SUCCESS) or StoppedByBudget(params, status);
+      Result.sol     = std::move(sol);
+      const std::size_t pos =
+          Multistart.DeterministicOrder ? index : NumberOfFinishedStarts++;
+      ProcessingOrder.at(pos) = index + 1;
+      ProcessResults();
     }
+  };
 
-    for (auto &thr : MinThreads)
+  if (UseMultiThreading)
+  {
+    // One job per thread of the global pool, idle threads of nested calls
+    // take over the jobs of the busy ones
+    TaskGroup MinTasks;
+    for (std::size_t i = 0; i < MinTasks.GetConcurrency(); ++i)
     {
-      if (thr.joinable()) thr.join();
+      MinTasks.Run(thread_Job);
     }
+    MinTasks.Wait();
+    // Results which were finished after the last processing
+    ProcessResults();
   }
   else
   {
-    thread_Job(FoundSolutions,
-               MaxSol,
-               StartingPoints,
-               params,
-               WriteResultLock,
-               Results,
-               false);
+    thread_Job();
+  }
+
+  if (Budget and Budget->Exhausted())
+  {
+    Logger::Write(LoggingLevel::MinimizerDetailed,
+                  "The budget of the GSL minimization was exhausted after " +
+                      std::to_string(Budget->GetEvaluations()) +
+                      " evaluations at T = " + std::to_string(Temp));
+  }
+  else if (Stop and Minima.size() < MaxSol)
+  {
+    Logger::Write(LoggingLevel::MinimizerDetailed,
+                  "No new minimum in the last " +
+                      std::to_string(StartsWithoutNewMinimum) + " of " +
+                      std::to_string(NextProcessed) +
+                      " starting points at T = " + std::to_string(Temp));
   }
 
-  while (not Results.empty())
+  for (const auto &Minimum : Minima)
   {
-    auto res = Results.front();
-    Results.pop();
-    auto vpot = model.MinimizeOrderVEV(res);
+    const auto &res = Minimum.first;
+    auto vpot       = model.MinimizeOrderVEV(res);
     std::vector<double> row(nCol);
     for (std::size_t i = 0; i < dim; ++i)
       row.at(i) = res.at(i);
     row.at(dim)     = model.EWSBVEV(vpot);
     row.at(dim + 1) = model.VEff(vpot, Temp, 0);
+    row.at(dim + 2) = Minimum.second;
     saveAllMinima.push_back(row);
   }
 
@@ -164,7 +164,7 @@ MinimizePlane(const std::vector<double> &basepoint,
 
   auto dimensionnames = modelPointer->addLegendTemp();
 
-  if (UseMinimizer.UseGSL)
+  if (UseMinimizer.UseGSL or UseMinimizer.UseGSLGradient)
   {
     // Find the minimum provided by GSL
     auto GSLResult = GSL_Minimize_Plane_gen_all(params, 3, 50);
@@ -8,13 +8,15 @@
 #include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Potential_Origin
 #include <BSMPT/models/IncludeAllModels.h>     // for FChoose
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/Profiler.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for copy, max
-#include <iostream>  // for operator<<, cout, endl
-#include <math.h>    // for abs, log10
+#include <functional>
+#include <iostream> // for operator<<, cout, endl
+#include <math.h>   // for abs, log10
 #include <memory>
 #include <random>
-#include <thread>
 #include <time.h> // for time, NULL
 #include <vector>
 
@@ -68,6 +70,8 @@ MinimizersToUse GetMinimizers(int WhichMinimizer)
   bool UseGSL = (WhichMinimizer % 2 != 0);
   WhichMinimizer /= 2;
   bool UseNLopt = (WhichMinimizer % 2 != 0);
+  WhichMinimizer /= 2;
+  bool UseGSLGradient = (WhichMinimizer % 2 != 0);
 
 #ifndef libcmaes_FOUND
   UseCMAES = false;
@@ -77,7 +81,7 @@ MinimizersToUse GetMinimizers(int WhichMinimizer)
   UseNLopt = false;
 #endif
 
-  return MinimizersToUse(UseCMAES, UseGSL, UseNLopt);
+  return MinimizersToUse(UseCMAES, UseGSL, UseNLopt, UseGSLGradient);
 }
 
 std::vector<double>
@@ -86,8 +90,11 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
                  std::vector<double> &Check,
                  const std::vector<double> &start,
                  const int &WhichMinimizer,
-                 bool UseMultithreading)
+                 bool UseMultithreading,
+                 const GSL_MultistartOptions &GSLOptions,
+                 MinimizerBudgetTracker *Budget)
 {
+  BSMPT_PROFILE_STAGE(Minimizer);
   std::vector<double> PotValues;
   std::vector<std::vector<double>> Minima;
 
@@ -110,65 +117,53 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
   std::vector<double> solGSLMin, solGSLMinPot;
 
   bool gslMinSuc = false;
-  std::thread thread_GSL;
-  if (UseMinimizer.UseGSL)
-  {
 
-    if (UseMinimizer.UseCMAES or UseMinimizer.UseNLopt)
-    {
-      if (UseMultithreading)
-      {
-        thread_GSL = std::thread(
-            [&solGSLMin, &gslMinSuc, &modelPointer, &Temp]()
-            {
-              std::tie(solGSLMin, gslMinSuc) = GSL_Minimize_gen_all(
-                  *modelPointer,
-                  Temp,
-                  5); // If additionally CMAES is minimising
-                      // GSL does not need as much solutions
-            });
-      }
-      else
-      {
-        std::tie(solGSLMin, gslMinSuc) =
-            GSL_Minimize_gen_all(*modelPointer, Temp, 5, UseMultithreading);
-      }
-    }
+  // The minimizers run as tasks of the global thread pool, which is shared
+  // with the parallel local minimisations of GSL_Minimize_gen_all
+  TaskGroup MinimizerTasks;
+  auto RunMinimizer = [&](std::function<void()> Minimize)
+  {
+    if (UseMultithreading)
+      MinimizerTasks.Run(std::move(Minimize));
     else
-    {
-      std::size_t MaxSol = 50;
-      if (UseMultithreading)
-      {
-        thread_GSL = std::thread(
-            [&solGSLMin, &gslMinSuc, &modelPointer, &Temp, &MaxSol]()
-            {
-              std::tie(solGSLMin, gslMinSuc) =
-                  GSL_Minimize_gen_all(*modelPointer, Temp, 5, MaxSol);
-            });
-      }
-      else
-      {
-        std::tie(solGSLMin, gslMinSuc) = GSL_Minimize_gen_all(
-            *modelPointer, Temp, 5, MaxSol, UseMultithreading);
-      }
-    }
+      Minimize();
+  };
+
+  const bool UseGradient = UseMinimizer.UseGSLGradient;
+  if (UseMinimizer.UseGSL or UseGradient)
+  {
+    // If additionally CMAES or NLopt are minimising GSL does not need as much
+    // solutions
+    const std::size_t MaxSol =
+        (UseMinimizer.UseCMAES or UseMinimizer.UseNLopt) ? 20 : 50;
+    RunMinimizer(
+        [&]()
+        {
+          std::vector<std::vector<double>> saveAllMinima;
+          std::tie(solGSLMin, gslMinSuc) =
+              GSL_Minimize_gen_all(*modelPointer,
+                                   Temp,
+                                   5,
+                                   GSLOptions,
+                                   saveAllMinima,
+                                   MaxSol,
+                                   UseMultithreading,
+                                   UseGradient,
+                                   Budget);
+        });
   }
 #ifdef libcmaes_FOUND
-  std::thread thread_CMAES;
   LibCMAES::LibCMAESReturn LibCMAES;
   if (UseMinimizer.UseCMAES)
   {
-    if (UseMultithreading)
-    {
-      thread_CMAES = std::thread(
-          [&modelPointer, &Temp, &start, &LibCMAES]() {
-            LibCMAES = LibCMAES::min_cmaes_gen_all(*modelPointer, Temp, start);
-          });
-    }
-    else
-    {
-      LibCMAES = LibCMAES::min_cmaes_gen_all(*modelPointer, Temp, start);
-    }
+    LibCMAES::LibCMAESSettings CMAESSettings;
+    CMAESSettings.ParallelPopulation = UseMultithreading;
+    RunMinimizer(
+        [&]()
+        {
+          LibCMAES = LibCMAES::min_cmaes_gen_all(
+              *modelPointer, Temp, start, CMAESSettings, Budget);
+        });
   }
 #else
   (void)start;
@@ -176,29 +171,25 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
 
 #ifdef NLopt_FOUND
   LibNLOPT::NLOPTReturnType NLOPTResult;
-  std::thread thread_NLopt;
   if (UseMinimizer.UseNLopt)
   {
-    if (UseMultithreading)
-    {
-      thread_NLopt = std::thread(
-          [&NLOPTResult, &modelPointer, &Temp]()
-          { NLOPTResult = LibNLOPT::MinimizeUsingNLOPT(*modelPointer, Temp); });
-    }
-    else
-    {
-      NLOPTResult = LibNLOPT::MinimizeUsingNLOPT(*modelPointer, Temp);
-    }
+    RunMinimizer(
+        [&]()
+        {
+          NLOPTResult =
+              LibNLOPT::MinimizeUsingNLOPT(*modelPointer, Temp, Budget);
+        });
   }
 #endif
 
-#ifdef NLopt_FOUND
-  if (UseMultithreading and thread_NLopt.joinable())
+  if (UseMultithreading)
   {
-    Logger::Write(LoggingLevel::MinimizerDetailed, "Waiting for NLopt thread");
-    thread_NLopt.join();
+    Logger::Write(LoggingLevel::MinimizerDetailed,
+                  "Waiting for the minimizers");
+    MinimizerTasks.Wait();
   }
 
+#ifdef NLopt_FOUND
   if (NLOPTResult.Success)
   {
     PotValues.push_back(NLOPTResult.PotVal);
@@ -211,10 +202,8 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
 #endif
 
 #ifdef libcmaes_FOUND
-  if (UseMultithreading and thread_CMAES.joinable())
+  if (UseMinimizer.UseCMAES)
   {
-    Logger::Write(LoggingLevel::MinimizerDetailed, "Waiting for CMAES Thread");
-    thread_CMAES.join();
     auto errC          = LibCMAES.CMAESStatus;
     auto solCMAES      = LibCMAES.result;
     auto solCMAESPotIn = modelPointer->MinimizeOrderVEV(solCMAES);
@@ -230,12 +219,6 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
   }
 #endif
 
-  if (UseMultithreading and thread_GSL.joinable())
-  {
-    Logger::Write(LoggingLevel::MinimizerDetailed, "Waiting for GSL thread");
-    thread_GSL.join();
-  }
-
   if (gslMinSuc)
   {
     solGSLMinPot = modelPointer->MinimizeOrderVEV(solGSLMin);
@@ -255,15 +238,42 @@ Minimize_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
     if (PotValues.at(i) < PotValues.at(minIndex)) minIndex = i;
   }
 
-  auto sol   = Minima.at(minIndex);
+  if (Budget and Budget->Exhausted())
+  {
+    std::stringstream ss;
+    ss << "The minimizer budget was exhausted after "
+       << Budget->GetEvaluations() << " evaluations and "
+       << Budget->GetElapsedSeconds() << " s at T = " << Temp
+       << ", using the deepest point found so far" << std::endl;
+    Logger::Write(LoggingLevel::MinimizerDetailed, ss.str());
+  }
+
+  auto sol = Minima.at(minIndex);
+
+  // Polish the solution with Newton steps and check that it is a minimum, with
+  // an exhausted budget the solution is only classified
+  StationaryPointSettings Refinement;
+  if (Budget and Budget->Exhausted()) Refinement.MaxIterations = 0;
+  const auto Refined =
+      RefineStationaryPoint(*modelPointer, sol, Temp, Refinement);
+  if (Refined.Type == StationaryPointType::Minimum) sol = Refined.Point;
+  {
+    std::stringstream ss;
+    ss << "Refined solution at T = " << Temp << " : " << sol << " after "
+       << Refined.Iterations << " Newton steps, Hessian eigenvalues "
+       << Refined.Eigenvalues << std::endl;
+    Logger::Write(LoggingLevel::MinimizerDetailed, ss.str());
+  }
+
   auto EWVEV = modelPointer->EWSBVEV(modelPointer->MinimizeOrderVEV(sol));
   if (EWVEV <= 0.5) modelPointer->SetEWVEVZero(sol);
 
   solGSLMin.clear();
-  if (UseMinimizer.UseGSL and gslMinSuc)
+  if ((UseMinimizer.UseGSL or UseGradient) and gslMinSuc)
     Check.push_back(1);
   else
     Check.push_back(-1);
+  Check.push_back(static_cast<double>(Refined.Type));
 
   return sol;
 }
@@ -343,6 +353,30 @@ PTFinder_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
     return result;
   }
 
+  // The broken phase is tracked from the lower and the symmetric phase from
+  // the upper end of the interval with local minimisations. The global
+  // minimisation, warm started from both phases, is only needed if one of
+  // them disappears.
+  std::vector<double> BrokenPhase{solStart}, SymmetricPhase{solEnd};
+  auto EWSBVEVOf = [&](const std::vector<double> &vev)
+  { return modelPointer->EWSBVEV(modelPointer->MinimizeOrderVEV(vev)); };
+  auto VEffOf = [&](const std::vector<double> &vev, const double &Temp)
+  { return modelPointer->VEff(modelPointer->MinimizeOrderVEV(vev), Temp); };
+  auto TrackPhase = [&](const std::vector<double> &Phase, const double &Temp)
+  {
+    auto LocalMinima =
+        FindNextLocalMinima(modelPointer, Phase, Temp, WhichMinimizer);
+    std::size_t minIndex = 0;
+    for (std::size_t i = 1; i < LocalMinima.size(); i++)
+    {
+      if (VEffOf(LocalMinima.at(i), Temp) <
+          VEffOf(LocalMinima.at(minIndex), Temp))
+        minIndex = i;
+    }
+    return LocalMinima.empty() ? std::vector<double>{}
+                               : LocalMinima.at(minIndex);
+  };
+
   for (std::size_t k = 0; k < dim; k++)
     startMitte.push_back(modelPointer->get_vevTreeMin(k));
   do
@@ -351,12 +385,30 @@ PTFinder_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
     solMitte.clear();
     checkMitte.clear();
     solMittePot.clear();
-    solMitte    = Minimize_gen_all(modelPointer,
-                                TM,
-                                checkMitte,
-                                startMitte,
-                                WhichMinimizer,
-                                UseMultithreading);
+    const auto Broken    = TrackPhase(BrokenPhase, TM);
+    const auto Symmetric = TrackPhase(SymmetricPhase, TM);
+    if (not Broken.empty() and not Symmetric.empty() and
+        EWSBVEVOf(Broken) >= Distance and EWSBVEVOf(Symmetric) < Distance)
+    {
+      solMitte = VEffOf(Broken, TM) < VEffOf(Symmetric, TM) ? Broken
+                                                             : Symmetric;
+      if (EWSBVEVOf(solMitte) <= 0.5) modelPointer->SetEWVEVZero(solMitte);
+    }
+    else
+    {
+      Logger::Write(LoggingLevel::MinimizerDetailed,
+                    "Phase disappeared at T = " + std::to_string(TM) +
+                        " GeV, using the global minimization");
+      GSL_MultistartOptions GSLOptions;
+      GSLOptions.WarmStarts = {BrokenPhase, SymmetricPhase};
+      solMitte              = Minimize_gen_all(modelPointer,
+                                  TM,
+                                  checkMitte,
+                                  startMitte,
+                                  WhichMinimizer,
+                                  UseMultithreading,
+                                  GSLOptions);
+    }
     solMittePot = modelPointer->MinimizeOrderVEV(solMitte);
     vMitte      = modelPointer->EWSBVEV(solMittePot);
 
@@ -385,11 +437,13 @@ PTFinder_gen_all(const std::shared_ptr<Class_Potential_Origin> &modelPointer,
       pSol[0] = vMitte;
       for (std::size_t k = 0; k < dim; k++)
         startMitte.push_back(pSol[k + 1]);
-      vStart = vMitte;
+      vStart      = vMitte;
+      BrokenPhase = solMitte;
     }
     else
     {
-      TE = TM;
+      TE             = TM;
+      SymmetricPhase = solMitte;
     }
 
   } while (std::abs(TE - TA) > Distance);
@@ -453,16 +507,20 @@ FindNextLocalMinima(const std::shared_ptr<Class_Potential_Origin> &model,
 
   std::vector<std::vector<double>> Minima;
 
-  if (UseMinimizer.UseGSL)
+  if (UseMinimizer.UseGSL or UseMinimizer.UseGSLGradient)
   {
     std::vector<double> GSLSolution;
     std::size_t tries{0}, MaxTries{600};
     int status;
-    GSL_params params(*model, temperature);
+    GSL_params params(*model, temperature, UseMinimizer.UseGSLGradient);
     do
     {
       GSLSolution.clear();
-      status = GSL_Minimize_From_S_gen_all(params, GSLSolution, StartingPoint);
+      status = params.UseGradient
+                   ? GSL_Minimize_Gradient_From_S_gen_all(
+                         params, GSLSolution, StartingPoint)
+                   : GSL_Minimize_From_S_gen_all(
+                         params, GSLSolution, StartingPoint);
       tries++;
     } while (status != GSL_SUCCESS and tries < MaxTries);
     if (status == GSL_SUCCESS)
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file
+ */
+
+#include <BSMPT/minimizer/StationaryPoint.h>
+#include <BSMPT/models/ClassPotentialOrigin.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace BSMPT
+{
+namespace Minimizer
+{
+
+namespace
+{
+/**
+ * Gradient of the effective potential in the VEV directions
+ */
+Eigen::VectorXd GradientVEVSpace(const Class_Potential_Origin &model,
+                                 const std::vector<double> &Point,
+                                 double Temp)
+{
+  const auto Gradient = model.VEffGradient(model.MinimizeOrderVEV(Point), Temp);
+  const auto &VevOrder = model.Get_VevOrder();
+  Eigen::VectorXd res(VevOrder.size());
+  for (std::size_t i = 0; i < VevOrder.size(); i++)
+  {
+    res(i) = Gradient.at(VevOrder.at(i));
+  }
+  return res;
+}
+} // namespace
+
+StationaryPointType ClassifyStationaryPoint(const Eigen::VectorXd &Eigenvalues,
+                                            double Tolerance)
+{
+  if (Eigenvalues.size() == 0) return StationaryPointType::Degenerate;
+  const double Threshold = Tolerance * Eigenvalues.cwiseAbs().maxCoeff();
+  bool HasPositive = false, HasNegative = false, HasZero = false;
+  for (Eigen::Index i = 0; i < Eigenvalues.size(); i++)
+  {
+    if (Eigenvalues(i) > Threshold)
+      HasPositive = true;
+    else if (Eigenvalues(i) < -Threshold)
+      HasNegative = true;
+    else
+      HasZero = true;
+  }
+  if (HasNegative and HasPositive) return StationaryPointType::Saddle;
+  if (HasNegative and not HasZero) return StationaryPointType::Maximum;
+  if (HasZero or HasNegative) return StationaryPointType::Degenerate;
+  return StationaryPointType::Minimum;
+}
+
+Eigen::MatrixXd HessianVEVSpace(const Class_Potential_Origin &model,
+                                const std::vector<double> &Point,
+                                double Temp)
+{
+  const auto Hessian   = model.VEffHessian(model.MinimizeOrderVEV(Point), Temp);
+  const auto &VevOrder = model.Get_VevOrder();
+  Eigen::MatrixXd res(VevOrder.size(), VevOrder.size());
+  for (std::size_t i = 0; i < VevOrder.size(); i++)
+  {
+    for (std::size_t j = 0; j < VevOrder.size(); j++)
+    {
+      res(i, j) = Hessian(VevOrder.at(i), VevOrder.at(j));
+    }
+  }
+  return res;
+}
+
+StationaryPoint RefineStationaryPoint(const Class_Potential_Origin &model,
+                                      const std::vector<double> &Point,
+                                      double Temp,
+                                      const StationaryPointSettings &Settings)
+{
+  if (Point.size() != model.get_nVEV())
+  {
+    throw std::runtime_error("RefineStationaryPoint expects a point with nVEV "
+                             "entries.");
+  }
+  StationaryPoint res;
+  res.Point = Point;
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> Solver;
+  bool HessianIsCurrent = false;
+  auto UpdateHessian    = [&]()
+  {
+    Solver.compute(HessianVEVSpace(model, res.Point, Temp));
+    res.Type         = ClassifyStationaryPoint(Solver.eigenvalues(),
+                                       Settings.EigenvalueTolerance);
+    HessianIsCurrent = true;
+  };
+
+  auto Gradient = GradientVEVSpace(model, res.Point, Temp);
+  UpdateHessian();
+  while (res.Type == StationaryPointType::Minimum and
+         res.Iterations < Settings.MaxIterations and not res.Converged)
+  {
+    const Eigen::VectorXd Step =
+        -Solver.eigenvectors() *
+        Solver.eigenvalues().cwiseInverse().asDiagonal() *
+        Solver.eigenvectors().transpose() * Gradient;
+
+    // Halve the step until the gradient decreases, within the numerical
+    // precision of the gradient no step is accepted any more
+    bool Accepted = false;
+    double Scale  = 1;
+    std::vector<double> Trial;
+    Eigen::VectorXd TrialGradient;
+    for (int halving = 0; halving < 6 and not Accepted; halving++)
+    {
+      Trial = res.Point;
+      for (std::size_t i = 0; i < Trial.size(); i++)
+      {
+        Trial.at(i) += Scale * Step(i);
+      }
+      TrialGradient = GradientVEVSpace(model, Trial, Temp);
+      Accepted      = TrialGradient.norm() < Gradient.norm();
+      Scale /= 2;
+    }
+
+    if (not Accepted)
+    {
+      if (HessianIsCurrent)
+      {
+        res.Converged = Step.norm() < Settings.StepTolerance;
+        break;
+      }
+      // The cached Hessian may be outdated, retry with a new one
+      UpdateHessian();
+      continue;
+    }
+
+    const bool SlowDecrease = TrialGradient.norm() > 0.5 * Gradient.norm();
+    res.Point               = Trial;
+    Gradient                = TrialGradient;
+    res.Iterations++;
+    res.Converged    = 2 * Scale * Step.norm() < Settings.StepTolerance;
+    HessianIsCurrent = false;
+    if (SlowDecrease and not res.Converged) UpdateHessian();
+  }
+
+  res.PotVal       = model.VEff(model.MinimizeOrderVEV(res.Point), Temp);
+  res.GradientNorm = Gradient.norm();
+  res.Eigenvalues.assign(Solver.eigenvalues().data(),
+                         Solver.eigenvalues().data() +
+                             Solver.eigenvalues().size());
+  return res;
+}
+
+} // namespace Minimizer
+} // namespace BSMPT
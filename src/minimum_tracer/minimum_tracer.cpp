@@ -9,6 +9,11 @@
 
 #include <BSMPT/minimum_tracer/minimum_tracer.h>
 #include <BSMPT/utility/NumericalDerivatives.h>
+#include <BSMPT/utility/Profiler.h>
+#include <BSMPT/utility/ThreadPool.h>
+
+#include <algorithm>
+#include <limits>
 
 using namespace Eigen;
 
@@ -62,22 +67,22 @@ std::vector<double> MinimumTracer::LocateMinimum(
 {
   // Save initial guess
   std::vector<double> guess = guess_In;
+  // Gradient at the current guess, evaluated once per iteration
+  std::vector<double> gradient = df(guess);
   // Checks if guess is close enough
-  if (L2NormVector(df(guess)) < error) return guess;
+  if (L2NormVector(gradient) < error) return guess;
 
   // If not, performs gradient descent until minima with a maximum of
   // "maxiter" iterations
   int dim                       = guess.size(); // Guess dimension
   int i                         = 0;            // Counter
   std::vector<double> new_guess = guess;        // First guess
-  std::vector<double> gradient;                 // Gradient
-  std::vector<std::vector<double>> Hess;        // HessianNumerical gradient
+  std::vector<std::vector<double>> Hess;        // Hessian
 
-  for (i = 0; (i < maxiter) && (L2NormVector(df(new_guess)) > error); i++)
+  for (i = 0; (i < maxiter) && (L2NormVector(gradient) > error); i++)
   {
-    //  Update grad and HessianNumerical :
-    gradient = df(new_guess);
-    Hess     = Hessian(new_guess);
+    //  Update Hessian :
+    Hess = Hessian(new_guess);
 
     // Convert into a Eigen3 // Probably there is a better way
     Eigen::MatrixXd HessMatrix(dim, dim);
@@ -92,7 +97,7 @@ std::vector<double> MinimumTracer::LocateMinimum(
       HessMatrix(m, m) += HessianDiagonalShift;
     }
 
-    if (HessMatrix.determinant() != 0) // If HessianNumerical is
+    if (HessMatrix.determinant() != 0) // If Hessian is
     // invertible them do the gradient descent, if not use only the
     // diagonal elements.
     {
@@ -117,6 +122,7 @@ std::vector<double> MinimumTracer::LocateMinimum(
         new_guess[j] -= const_multiplier * gradient[j]; // Updates guess
       }
     }
+    gradient = df(new_guess);
   }
   return (new_guess);
 }
@@ -144,40 +150,155 @@ double MinimumTracer::SmallestEigenvalue(
   return current_min + 1e-7;
 }
 
+double MinimumTracer::PotentialVEVSpace(const std::vector<double> &vev,
+                                        const double &T)
+{
+  return this->modelPointer->VEff(this->modelPointer->MinimizeOrderVEV(vev), T);
+}
+
+std::vector<double>
+MinimumTracer::GradientVEVSpace(const std::vector<double> &vev,
+                                const double &T,
+                                const double &Normalisation)
+{
+  const auto Gradient = this->modelPointer->VEffGradient(
+      this->modelPointer->MinimizeOrderVEV(vev), T);
+  const auto &VevOrder = this->modelPointer->Get_VevOrder();
+  std::vector<double> res(VevOrder.size());
+  for (std::size_t i = 0; i < VevOrder.size(); i++)
+  {
+    res.at(i) = Gradient.at(VevOrder.at(i)) / Normalisation;
+  }
+  return res;
+}
+
+std::vector<std::vector<double>>
+MinimumTracer::HessianVEVSpace(const std::vector<double> &vev,
+                               const double &T,
+                               const double &Normalisation)
+{
+  const auto Hessian = this->modelPointer->VEffHessian(
+      this->modelPointer->MinimizeOrderVEV(vev), T);
+  const auto &VevOrder = this->modelPointer->Get_VevOrder();
+  std::vector<std::vector<double>> res(
+      VevOrder.size(), std::vector<double>(VevOrder.size()));
+  for (std::size_t i = 0; i < VevOrder.size(); i++)
+  {
+    for (std::size_t j = 0; j < VevOrder.size(); j++)
+    {
+      res.at(i).at(j) =
+          Hessian(VevOrder.at(i), VevOrder.at(j)) / Normalisation;
+    }
+  }
+  return res;
+}
+
+std::vector<double>
+MinimumTracer::PhaseTangent(const std::vector<double> &point,
+                            const double &T,
+                            double &SmallestEV)
+{
+  const std::size_t dim = point.size();
+  // Temperature derivative of the gradient by central differences, one-sided
+  // at T = 0
+  const double Step  = 1e-3 * std::max(1., std::abs(T));
+  const double TDown = std::max(T - Step, 0.);
+  const double TUp   = T + Step;
+  const auto Up      = GradientVEVSpace(point, TUp);
+  const auto Down    = GradientVEVSpace(point, TDown);
+  const auto Hessian = HessianVEVSpace(point, T);
+
+  Eigen::MatrixXd HessianEigen(dim, dim);
+  Eigen::VectorXd dTGradient(dim);
+  for (std::size_t i = 0; i < dim; i++)
+  {
+    HessianEigen.col(i) =
+        Eigen::Map<const Eigen::VectorXd>(Hessian[i].data(), dim);
+    dTGradient(i) = (Up.at(i) - Down.at(i)) / (TUp - TDown);
+  }
+
+  // Flat directions have vanishing eigenvalues and do not change with T
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> Solver(HessianEigen);
+  const double FlatThreshold =
+      1e-8 * Solver.eigenvalues().cwiseAbs().maxCoeff();
+  Eigen::VectorXd Projection = Solver.eigenvectors().transpose() * dTGradient;
+  SmallestEV                 = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < dim; i++)
+  {
+    const double EV = Solver.eigenvalues()(i);
+    if (std::abs(EV) <= FlatThreshold)
+    {
+      Projection(i) = 0;
+      continue;
+    }
+    Projection(i) /= EV;
+    SmallestEV = std::min(SmallestEV, EV);
+  }
+  const Eigen::VectorXd Tangent = -Solver.eigenvectors() * Projection;
+  return std::vector<double>(Tangent.data(), Tangent.data() + dim);
+}
+
+PhasePrediction MinimumTracer::PredictMinimum(const std::vector<double> &point,
+                                              const double &T,
+                                              const double &dT)
+{
+  PhasePrediction res;
+  double StageEV;
+  // Bogacki-Shampine tableau, the fourth stage is evaluated at the third order
+  // solution and gives the embedded second order solution
+  const auto k1 = PhaseTangent(point, T, res.ev_start);
+  const auto k2 = PhaseTangent(point + dT / 2 * k1, T + dT / 2, StageEV);
+  const auto k3 =
+      PhaseTangent(point + 3 * dT / 4 * k2, T + 3 * dT / 4, StageEV);
+  res.point = point + dT * (2. / 9 * k1 + 1. / 3 * k2 + 4. / 9 * k3);
+  const auto k4 = PhaseTangent(res.point, T + dT, res.ev_end);
+  const auto Embedded =
+      point + dT * (7. / 24 * k1 + 1. / 4 * k2 + 1. / 3 * k3 + 1. / 8 * k4);
+  res.error = L2NormVector(res.point - Embedded);
+  return res;
+}
+
+double MinimumTracer::PredictorStep(const double &dT,
+                                    const PhasePrediction &prediction,
+                                    const double &MaxStep)
+{
+  // The local error of the third order method scales with dT^3
+  double Factor = 5;
+  if (prediction.error > 0)
+  {
+    Factor = std::clamp(
+        0.9 * std::cbrt(PredictorTolerance / prediction.error), 0.2, 5.);
+  }
+  double res = std::min(Factor * std::abs(dT), MaxStep);
+
+  // The phase ends where the smallest eigenvalue of the Hessian vanishes
+  if (prediction.ev_end > 0 and prediction.ev_end < prediction.ev_start)
+  {
+    const double DistanceToEnd = std::abs(dT) * prediction.ev_end /
+                                 (prediction.ev_start - prediction.ev_end);
+    res = std::min(res, 0.75 * DistanceToEnd);
+  }
+  return std::copysign(res, dT);
+}
+
 std::vector<double>
 MinimumTracer::FindZeroSmallestEigenvalue(std::vector<double> point_1,
                                           double T_1,
                                           std::vector<double> point_2,
                                           double T_2)
 {
-  double eps = 0.1;
   double ev_1, ev_2, ev_m, T_m; // Eigenvalues of phases and middle temperature
   int dim = this->modelPointer->get_nVEV();
   std::vector<double> point_m;
-  std::function<double(std::vector<double>)> V_1, V_2, V_m;
-  std::function<std::vector<double>(std::vector<double>)> dV_1, dV_2, dV_m;
+  std::function<std::vector<double>(std::vector<double>)> dV_m;
   std::function<std::vector<std::vector<double>>(std::vector<double>)>
       Hessian_1, Hessian_2, Hessian_m;
 
-  // Define potential 1
-  V_1 = [&](std::vector<double> vev)
-  {
-    // Potential wrapper
-    std::vector<double> res = this->modelPointer->MinimizeOrderVEV(vev);
-    return this->modelPointer->VEff(res, T_1) / (1 + T_1 * T_1);
-  };
-  dV_1      = [&](auto const &arg) { return NablaNumerical(arg, V_1, eps); };
-  Hessian_1 = [&](auto const &arg) { return HessianNumerical(arg, V_1, eps); };
-
-  // Define potential 2
-  V_2 = [&](std::vector<double> vev)
-  {
-    // Potential wrapper
-    std::vector<double> res = this->modelPointer->MinimizeOrderVEV(vev);
-    return this->modelPointer->VEff(res, T_2) / (1 + T_2 * T_2);
-  };
-  dV_2      = [=](auto const &arg) { return NablaNumerical(arg, V_2, eps); };
-  Hessian_2 = [=](auto const &arg) { return HessianNumerical(arg, V_2, eps); };
+  // Hessians of the potential at both temperatures
+  Hessian_1 = [&](auto const &arg)
+  { return HessianVEVSpace(arg, T_1, 1 + T_1 * T_1); };
+  Hessian_2 = [&](auto const &arg)
+  { return HessianVEVSpace(arg, T_2, 1 + T_2 * T_2); };
 
   // Initial guess for middle point
   point_m = point_1;
@@ -206,16 +327,11 @@ MinimumTracer::FindZeroSmallestEigenvalue(std::vector<double> point_1,
   while (abs(T_1 / T_2 - 1) > 1e-8)
   {
     T_m = (T_1 + T_2) / 2.;
-    // Define potential in the middle
-    V_m = [&](std::vector<double> vev)
-    {
-      // Potential wrapper
-      std::vector<double> res = this->modelPointer->MinimizeOrderVEV(vev);
-      return this->modelPointer->VEff(res, T_m) / (1 + T_m * T_m);
-    };
-    dV_m      = [=](auto const &arg) { return NablaNumerical(arg, V_m, eps); };
-    Hessian_m = [=](auto const &arg)
-    { return HessianNumerical(arg, V_m, eps); };
+    // Derivatives of the potential in the middle
+    dV_m = [&](auto const &arg)
+    { return GradientVEVSpace(arg, T_m, 1 + T_m * T_m); };
+    Hessian_m = [&](auto const &arg)
+    { return HessianVEVSpace(arg, T_m, 1 + T_m * T_m); };
     point_m =
         LocateMinimum(point_m, dV_m, Hessian_m, 1e-3 * dim / (1 + T_m * T_m));
     ev_m = SmallestEigenvalue(point_m, Hessian_m);
@@ -260,6 +376,7 @@ MinimumTracer::TrackPhase(double &globMinEndT,
                           const bool &output,
                           const bool &unprotected)
 {
+  BSMPT_PROFILE_STAGE(MinimumTracer);
   // Test phase tracker
   int dim         = this->modelPointer->get_nVEV();
   int IsInMin     = 0;
@@ -267,7 +384,6 @@ MinimumTracer::TrackPhase(double &globMinEndT,
   double currentT = currentT_In;
   double dT       = dT_In;
   double initialdT;
-  double eps = 0.1;
   double LengthGradient, PotentialDifference, Distance;
   std::function<std::vector<double>(std::vector<double>)> dV;
   std::function<std::vector<std::vector<double>>(std::vector<double>)> Hessian;
@@ -277,6 +393,9 @@ MinimumTracer::TrackPhase(double &globMinEndT,
   std::stringstream ss;
   std::vector<Minimum> MinimumList;
   Minimum newMinimum;
+  // Temperature of point and last step of the predictor-corrector mode
+  double pointT = currentT_In;
+  PhasePrediction prediction;
 
   bool old_min_is_global = true;
 
@@ -285,7 +404,8 @@ MinimumTracer::TrackPhase(double &globMinEndT,
     // Step has the wrong sign
     dT *= -1;
   }
-  initialdT = dT;
+  initialdT                     = dT;
+  const double MaxPredictorStep = abs(initialdT) * PredictorMaxStepFactor;
 
   // Reduce the VEV into the same sector
   ReduceVEV(point);
@@ -304,12 +424,31 @@ MinimumTracer::TrackPhase(double &globMinEndT,
       return this->modelPointer->VEff(res, currentT) /
              (1 + currentT * currentT);
     };
-    dV      = [=](auto const &arg) { return NablaNumerical(arg, V, eps); };
-    Hessian = [=](auto const &arg) { return HessianNumerical(arg, V, eps); };
-
-    // Locate the minimum
-    new_point =
-        LocateMinimum(point, dV, Hessian, 1e-4 * GradientThreshold * dim);
+    dV = [&](auto const &arg)
+    { return GradientVEVSpace(arg, currentT, 1 + currentT * currentT); };
+    Hessian = [&](auto const &arg)
+    { return HessianVEVSpace(arg, currentT, 1 + currentT * currentT); };
+
+    // Locate the minimum, in the predictor-corrector mode starting from the
+    // predicted minimum
+    const double Tolerance = 1e-4 * GradientThreshold * dim;
+    const double Step      = currentT - pointT;
+    const bool Predicted   = UsePredictorCorrector and Step != 0;
+    if (Predicted)
+    {
+      prediction = PredictMinimum(point, pointT, Step);
+      if (prediction.error > PredictorTolerance and
+          abs(Step) > 1e-3 * abs(initialdT))
+      {
+        // Retry with a smaller step
+        dT       = PredictorStep(Step, prediction, MaxPredictorStep);
+        currentT = pointT + dT;
+        continue;
+      }
+      new_point = LocateMinimum(prediction.point, dV, Hessian, Tolerance);
+    }
+    else
+      new_point = LocateMinimum(point, dV, Hessian, Tolerance);
 
     // Reduce the VEV into the same sector
     ReduceVEV(new_point);
@@ -321,8 +460,8 @@ MinimumTracer::TrackPhase(double &globMinEndT,
     // by the dimension of the VEV space
     LengthGradient =
         L2NormVector(dV(new_point)) / dim; // (1 + currentT * currentT) *
-    // Compare minimum and previous iteration
-    Distance = L2NormVector(new_point - point);
+    // Compare minimum and previous iteration, or the prediction
+    Distance = L2NormVector(new_point - (Predicted ? prediction.point : point));
     // Compute difference in energy between both minimum
     PotentialDifference = V(new_point) - V(point);
 
@@ -363,8 +502,17 @@ MinimumTracer::TrackPhase(double &globMinEndT,
         return MinimumList;
       }
 
-      currentT -= dT;
-      dT /= 10.;
+      if (Predicted)
+      {
+        // The last step may have been shortened to reach finalT
+        currentT = pointT;
+        dT       = Step / 10.;
+      }
+      else
+      {
+        currentT -= dT;
+        dT /= 10.;
+      }
     }
     else if (unprotected)
     {
@@ -372,12 +520,18 @@ MinimumTracer::TrackPhase(double &globMinEndT,
       newMinimum.temp      = currentT;
       newMinimum.potential = V(new_point) * (1 + currentT * currentT);
       MinimumList.push_back(newMinimum);
-      point = new_point;
+      point  = new_point;
+      pointT = currentT;
       // Sucess minimum!
       ss << "\033[1;32m.\033[0m";
-      dT *=
-          .5 * ThresholdDistance / Distance; // Try to predict the best stepsize
-      if (abs(initialdT) <= abs(dT)) dT = initialdT;
+      if (Predicted)
+        dT = PredictorStep(Step, prediction, MaxPredictorStep);
+      else
+      {
+        dT *= .5 * ThresholdDistance /
+              Distance; // Try to predict the best stepsize
+        if (abs(initialdT) <= abs(dT)) dT = initialdT;
+      }
     }
     else
     {
@@ -467,13 +621,19 @@ MinimumTracer::TrackPhase(double &globMinEndT,
           MinimumList.push_back(newMinimum);
           // Sucess minimum!
           ss << "\033[1;32m.\033[0m";
-          dT *= .5 * ThresholdDistance /
-                Distance; // Try to predict the best stepsize
-          if (abs(initialdT) <= abs(dT)) dT = initialdT;
+          if (Predicted)
+            dT = PredictorStep(Step, prediction, MaxPredictorStep);
+          else
+          {
+            dT *= .5 * ThresholdDistance /
+                  Distance; // Try to predict the best stepsize
+            if (abs(initialdT) <= abs(dT)) dT = initialdT;
+          }
         }
         IsInMin = -1;
       }
-      point = new_point;
+      point  = new_point;
+      pointT = currentT;
     }
 
     // Make sure that or step is not bigger than it should be and we overshot
@@ -501,6 +661,7 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
                           const bool &output,
                           const bool &unprotected)
 {
+  BSMPT_PROFILE_STAGE(MinimumTracer);
   // Test phase tracker
   int dim         = this->modelPointer->get_nVEV();
   int IsInMin     = 0;
@@ -508,7 +669,6 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
   double currentT = currentT_In;
   double dT       = dT_In;
   double initialdT;
-  double eps = 0.1;
   double LengthGradient, PotentialDifference, Distance;
   std::function<std::vector<double>(std::vector<double>)> dV;
   std::function<std::vector<std::vector<double>>(std::vector<double>)> Hessian;
@@ -518,13 +678,17 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
   std::stringstream ss;
   std::vector<Minimum> MinimumList;
   Minimum newMinimum;
+  // Temperature of point and last step of the predictor-corrector mode
+  double pointT = currentT_In;
+  PhasePrediction prediction;
 
   if ((finalT - currentT) / dT < 0)
   {
     // Step has the wrong sign
     dT *= -1;
   }
-  initialdT = dT;
+  initialdT                     = dT;
+  const double MaxPredictorStep = abs(initialdT) * PredictorMaxStepFactor;
 
   // Reduce the VEV into the same sector
   ReduceVEV(point);
@@ -543,12 +707,31 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
       return this->modelPointer->VEff(res, currentT) /
              (1 + currentT * currentT);
     };
-    dV      = [=](auto const &arg) { return NablaNumerical(arg, V, eps); };
-    Hessian = [=](auto const &arg) { return HessianNumerical(arg, V, eps); };
-
-    // Locate the minimum
-    new_point =
-        LocateMinimum(point, dV, Hessian, 1e-4 * GradientThreshold * dim);
+    dV = [&](auto const &arg)
+    { return GradientVEVSpace(arg, currentT, 1 + currentT * currentT); };
+    Hessian = [&](auto const &arg)
+    { return HessianVEVSpace(arg, currentT, 1 + currentT * currentT); };
+
+    // Locate the minimum, in the predictor-corrector mode starting from the
+    // predicted minimum
+    const double Tolerance = 1e-4 * GradientThreshold * dim;
+    const double Step      = currentT - pointT;
+    const bool Predicted   = UsePredictorCorrector and Step != 0;
+    if (Predicted)
+    {
+      prediction = PredictMinimum(point, pointT, Step);
+      if (prediction.error > PredictorTolerance and
+          abs(Step) > 1e-3 * abs(initialdT))
+      {
+        // Retry with a smaller step
+        dT       = PredictorStep(Step, prediction, MaxPredictorStep);
+        currentT = pointT + dT;
+        continue;
+      }
+      new_point = LocateMinimum(prediction.point, dV, Hessian, Tolerance);
+    }
+    else
+      new_point = LocateMinimum(point, dV, Hessian, Tolerance);
 
     // Reduce the VEV into the same sector
     ReduceVEV(new_point);
@@ -560,8 +743,8 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
     // by the dimension of the VEV space
     LengthGradient =
         L2NormVector(dV(new_point)) / dim; // (1 + currentT * currentT) *
-    // Compare minimum and previous iteration
-    Distance = L2NormVector(new_point - point);
+    // Compare minimum and previous iteration, or the prediction
+    Distance = L2NormVector(new_point - (Predicted ? prediction.point : point));
     // Compute difference in energy between both minimum
     PotentialDifference = V(new_point) - V(point);
 
@@ -602,8 +785,17 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
         return MinimumList;
       }
 
-      currentT -= dT;
-      dT /= 10.;
+      if (Predicted)
+      {
+        // The last step may have been shortened to reach finalT
+        currentT = pointT;
+        dT       = Step / 10.;
+      }
+      else
+      {
+        currentT -= dT;
+        dT /= 10.;
+      }
     }
     else if (unprotected)
     {
@@ -611,12 +803,18 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
       newMinimum.temp      = currentT;
       newMinimum.potential = V(new_point) * (1 + currentT * currentT);
       MinimumList.push_back(newMinimum);
-      point = new_point;
+      point  = new_point;
+      pointT = currentT;
       // Sucess minimum!
       ss << "\033[1;32m.\033[0m";
-      dT *=
-          .5 * ThresholdDistance / Distance; // Try to predict the best stepsize
-      if (abs(initialdT) <= abs(dT)) dT = initialdT;
+      if (Predicted)
+        dT = PredictorStep(Step, prediction, MaxPredictorStep);
+      else
+      {
+        dT *= .5 * ThresholdDistance /
+              Distance; // Try to predict the best stepsize
+        if (abs(initialdT) <= abs(dT)) dT = initialdT;
+      }
     }
     else
     {
@@ -672,13 +870,19 @@ MinimumTracer::TrackPhase(const std::vector<double> &point_In,
           MinimumList.push_back(newMinimum);
           // Sucess minimum!
           ss << "\033[1;32m.\033[0m";
-          dT *= .5 * ThresholdDistance /
-                Distance; // Try to predict the best stepsize
-          if (abs(initialdT) <= abs(dT)) dT = initialdT;
+          if (Predicted)
+            dT = PredictorStep(Step, prediction, MaxPredictorStep);
+          else
+          {
+            dT *= .5 * ThresholdDistance /
+                  Distance; // Try to predict the best stepsize
+            if (abs(initialdT) <= abs(dT)) dT = initialdT;
+          }
         }
         IsInMin = -1;
       }
-      point = new_point;
+      point  = new_point;
+      pointT = currentT;
     }
 
     // Make sure that or step is not bigger than it should be and we overshot
@@ -970,14 +1174,6 @@ void MinimumTracer::FindDiscreteSymmetries()
       10; // Number of times GroupElements is checked
   const size_t dim = modelPointer->get_nVEV(); // Number of VEVs
 
-  std::function<double(Eigen::VectorXd)> V = [&](Eigen::VectorXd vev)
-  {
-    // Potential wrapper at T=0 for tree-level potential
-    std::vector<double> res = this->modelPointer->MinimizeOrderVEV(
-        std::vector<double>(vev.data(), vev.data() + vev.size()));
-    return this->modelPointer->VEff(res, 0, 0, 0);
-  };
-
   // Generate random VEV
   srand(time(NULL));
   const long max_rand                                = 1000000L;
@@ -989,15 +1185,30 @@ void MinimumTracer::FindDiscreteSymmetries()
     return res;
   };
 
-  // Check if potential is invariant under group element
+  // Check if potential is invariant under group element, all random VEVs and
+  // their images are evaluated in one batch
   std::function<int(Eigen::MatrixXd)> CheckGroupElement =
       [&](Eigen::MatrixXd GroupElement)
   {
-    int result = 1;
+    std::vector<double> points, values;
+    auto AddPoint = [&](const Eigen::VectorXd &vev)
+    {
+      const auto res = this->modelPointer->MinimizeOrderVEV(
+          std::vector<double>(vev.data(), vev.data() + vev.size()));
+      points.insert(points.end(), res.begin(), res.end());
+    };
     for (std::size_t it = 0; it < NumberOfGroupElementsChecks; it++)
     {
       auto RandomVEV = GenerateRandomVEV();
-      result *= (abs(V(RandomVEV) / V(GroupElement * RandomVEV) - 1) <
+      AddPoint(RandomVEV);
+      AddPoint(GroupElement * RandomVEV);
+    }
+    this->modelPointer->VEffBatch(points, 0, values, 0);
+
+    int result = 1;
+    for (std::size_t it = 0; it < NumberOfGroupElementsChecks; it++)
+    {
+      result *= (abs(values.at(2 * it) / values.at(2 * it + 1) - 1) <
                  GroupElementslMaximumRelativeError);
     }
     return result;
@@ -1069,13 +1280,28 @@ MinimumTracer::GetGlobalMinimum(const double &Temp,
                                 std::vector<double> &check,
                                 const std::vector<double> &start)
 {
+  // The local minimizations start from the given point, the tree-level vacuum
+  // and its symmetry images before the Sobol points are probed. Solutions in
+  // the same basin, up to the discrete symmetries, are merged and the search
+  // stops once the last starting points found no new minimum.
+  Minimizer::GSL_MultistartOptions Multistart;
+  Multistart.Strategy = Minimizer::GSLSeedingStrategy::Sobol;
+  if (start.size() == this->modelPointer->get_nVEV())
+  {
+    Multistart.WarmStarts.push_back(start);
+  }
+  Multistart.UseTreeLevelVacuum         = true;
+  Multistart.SymmetryElements           = this->GroupElements;
+  Multistart.ClusterMinima              = true;
+  Multistart.MaxStartsWithoutNewMinimum = 20;
   return this->modelPointer->MinimizeOrderVEV(
       Minimizer::Minimize_gen_all(this->modelPointer,
                                   Temp,
                                   check,
                                   start,
                                   this->WhichMinimizer,
-                                  this->UseMultithreading));
+                                  this->UseMultithreading,
+                                  Multistart));
 }
 
 std::vector<double>
@@ -1177,7 +1403,6 @@ int MinimumTracer::IsThereEWSymmetryRestoration()
   double ActualSmallestEigenvalue    = 0;
   double OldSmallestEigenvalue       = 1e100;
   double EvenOlderSmallestEigenvalue = 1e200;
-  double eps                         = 0.1;
   double treshold                    = 1e-6;
   double Tmax                        = 1e10;
   std::vector<double> gradient, stationary_point;
@@ -1188,7 +1413,6 @@ int MinimumTracer::IsThereEWSymmetryRestoration()
   Eigen::MatrixXd HessianEigen(dim, dim);
 
   std::function<std::vector<double>(std::vector<double>)> dV;
-  std::function<double(std::vector<double>)> V;
   std::function<std::vector<std::vector<double>>(std::vector<double>)> Hessian;
 
   Logger::Write(LoggingLevel::MinTracerDetailed,
@@ -1198,16 +1422,13 @@ int MinimumTracer::IsThereEWSymmetryRestoration()
        exponentT += log(Tmax) / (20 * log(Tmax)))
   {
     T = exp(exponentT);
-    // wrappers for potential, first and second numerical derivative
-    V = [&](std::vector<double> vev)
-    {
-      std::vector<double> res = this->modelPointer->MinimizeOrderVEV(vev);
-      if (C_UseParwani)
-        return this->modelPointer->VEff(res, T) / (1 + T * T * log(T * T));
-      return this->modelPointer->VEff(res, T) / (1 + T * T);
-    };
-    dV      = [=](auto const &arg) { return NablaNumerical(arg, V, eps); };
-    Hessian = [=](auto const &arg) { return HessianNumerical(arg, V, eps); };
+    // wrappers for the first and second derivative of the potential
+    const double Normalisation =
+        C_UseParwani ? 1 + T * T * log(T * T) : 1 + T * T;
+    dV = [=](auto const &arg)
+    { return GradientVEVSpace(arg, T, Normalisation); };
+    Hessian = [=](auto const &arg)
+    { return HessianVEVSpace(arg, T, Normalisation); };
 
     ActualSmallestEigenvalue = SmallestEigenvalue(point, Hessian);
 
@@ -1672,24 +1893,29 @@ Minimum Phase::Get(double T)
                   "Tried to Get() the minimum outside temperature range of "
                   "the phase.");
   }
+  // Unset temperatures are EmptyValue, no minimum is close to them
+  if (MinimumPhaseVector.size() == 0 or std::isnan(T)) return Minimum();
 
-  double error = 1e100;
-  Minimum bestGuess;
-  // Compute minimum closes to the desired temperature
-  for (auto min = MinimumPhaseVector.begin(); min < MinimumPhaseVector.end();
-       ++min)
-  {
-    if (abs(T - min->temp) < error)
-    {
-      error     = abs(T - min->temp);
-      bestGuess = *min;
-    }
-  }
-  if (error == 0)
+  if (T >= MinimumPhaseVector.front().temp and
+      T <= MinimumPhaseVector.back().temp)
   {
-    // Minimum already in the list
-    return bestGuess;
+    double error = 0;
+    Minimum res  = Interpolate(T, error);
+    if (error <= InterpolationTolerance) return res;
   }
+
+  // Trace the phase from the closest stored minimum
+  const auto upper = std::lower_bound(
+      MinimumPhaseVector.begin(), MinimumPhaseVector.end(), T,
+      [](const Minimum &min, const double &Temp) { return min.temp < Temp; });
+  Minimum bestGuess;
+  if (upper == MinimumPhaseVector.end() or
+      (upper != MinimumPhaseVector.begin() and
+       T - std::prev(upper)->temp <= upper->temp - T))
+    bestGuess = *std::prev(upper);
+  else
+    bestGuess = *upper;
+
   std::vector<Minimum> MinimumList = MinTracer->TrackPhase(
       bestGuess.point, bestGuess.temp, T, (T - bestGuess.temp), false, true);
   // Check if the TrackPhase fails
@@ -1716,15 +1942,81 @@ Minimum Phase::Get(double T)
   return bestGuess;
 }
 
+Minimum Phase::Interpolate(double T, double &error)
+{
+  const auto upper = std::lower_bound(
+      MinimumPhaseVector.begin(), MinimumPhaseVector.end(), T,
+      [](const Minimum &min, const double &Temp) { return min.temp < Temp; });
+  if (upper == MinimumPhaseVector.end() or
+      (upper == MinimumPhaseVector.begin() and upper->temp != T))
+  {
+    throw std::runtime_error(
+        "Phase::Interpolate called outside of the stored temperature range.");
+  }
+  error = 0;
+  if (upper->temp == T) return *upper;
+
+  const std::size_t k = std::distance(MinimumPhaseVector.begin(), upper);
+  const Minimum &Low  = MinimumPhaseVector.at(k - 1);
+  const Minimum &High = MinimumPhaseVector.at(k);
+  const double h      = High.temp - Low.temp;
+  const double t      = (T - Low.temp) / h;
+  // Cubic Hermite basis functions
+  const double h00 = (1 + 2 * t) * (1 - t) * (1 - t);
+  const double h10 = t * (1 - t) * (1 - t);
+  const double h01 = t * t * (3 - 2 * t);
+  const double h11 = t * t * (t - 1);
+
+  const auto &LowTangent  = Tangent(k - 1);
+  const auto &HighTangent = Tangent(k);
+
+  Minimum res;
+  res.temp  = T;
+  res.point = h00 * Low.point + h * h10 * LowTangent + h01 * High.point +
+              h * h11 * HighTangent;
+  // The cubic part of the interpolant is an estimate of the error of the
+  // lower order interpolant, which overestimates the error of the cubic one
+  error = t * (1 - t) / 2 *
+          L2NormVector(h * (LowTangent + HighTangent) -
+                       2 * (High.point - Low.point));
+
+  // The gradient vanishes at the minimum, so the potential at the
+  // interpolated location is only off by the square of its error
+  res.potential = MinTracer->PotentialVEVSpace(res.point, T);
+  return res;
+}
+
+const std::vector<double> &Phase::Tangent(std::size_t k)
+{
+  if (TangentVector.size() != MinimumPhaseVector.size())
+  {
+    TangentVector.assign(MinimumPhaseVector.size(), std::vector<double>());
+  }
+  if (TangentVector.at(k).empty())
+  {
+    double SmallestEV = 0;
+    TangentVector.at(k) =
+        MinTracer->PhaseTangent(MinimumPhaseVector.at(k).point,
+                                MinimumPhaseVector.at(k).temp,
+                                SmallestEV);
+  }
+  return TangentVector.at(k);
+}
+
 void Phase::Add(Minimum min)
 {
+  const auto position = std::lower_bound(
+      MinimumPhaseVector.begin(), MinimumPhaseVector.end(), min);
   // Check if phase is already there
-  for (std::size_t i = 0; i < MinimumPhaseVector.size(); i++)
+  if (position != MinimumPhaseVector.end() and position->temp == min.temp)
   {
-    if (min.temp == MinimumPhaseVector[i].temp)
-    {
-      return;
-    }
+    return;
+  }
+  // Keep the cached tangents aligned with the minima
+  if (TangentVector.size() == MinimumPhaseVector.size())
+  {
+    const auto index = std::distance(MinimumPhaseVector.begin(), position);
+    TangentVector.insert(TangentVector.begin() + index, std::vector<double>());
   }
   // If the list is empty add that value in.
   if (MinimumPhaseVector.size() == 0)
@@ -1733,7 +2025,7 @@ void Phase::Add(Minimum min)
     return;
   }
   // Temperature is the lowest yet.
-  if (min.temp < MinimumPhaseVector[0].temp)
+  if (position == MinimumPhaseVector.begin())
   {
     // update EdgeOfPhase
     MinimumPhaseVector.front().EdgeOfPhase = 0;
@@ -1744,14 +2036,10 @@ void Phase::Add(Minimum min)
     return;
   }
   // Is the temperature in the middle of other temperatures?
-  for (std::size_t i = 0; i < MinimumPhaseVector.size() - 1; i++)
+  if (position != MinimumPhaseVector.end())
   {
-    if (min.temp > MinimumPhaseVector[i].temp and
-        min.temp < MinimumPhaseVector[i + 1].temp)
-    {
-      MinimumPhaseVector.insert(MinimumPhaseVector.begin() + i + 1, min);
-      return;
-    }
+    MinimumPhaseVector.insert(position, min);
+    return;
   }
   // If not, it is the biggest temperature yet, add it to the end and update
   // EdgeOfPhase
@@ -2273,6 +2561,7 @@ Vacuum::Vacuum(const double &T_lowIn,
                const int &num_pointsIn,
                const bool &do_only_tracing)
 {
+  BSMPT_PROFILE_STAGE(MinimumTracer);
   T_low        = T_lowIn;
   T_high       = T_highIn;
   MinTracer    = MinTracerIn;
@@ -2438,22 +2727,68 @@ void Vacuum::MultiStepPTTracer(const double &Temp, const double &deltaT)
       addPhase(phase);
       print(phase);
 
-      // test equally-spaced point grid
-      for (int i = 1; i <= num_points; i++)
+      // test equally-spaced point grid, the global minimizations at the
+      // different temperatures are independent and run concurrently
+      std::vector<Minimum> GridMinima(std::max(num_points, 0));
+      {
+        TaskGroup GridTasks;
+        for (std::size_t i = 0; i < GridMinima.size(); i++)
+        {
+          GridTasks.Run(
+              [this, i, &GridMinima]()
+              {
+                Minimum &min = GridMinima.at(i);
+                min.temp =
+                    T_low + (T_high - T_low) / (num_points + 1) * (i + 1);
+                min.point = MinTracer->ConvertToVEVDim(
+                    MinTracer->GetGlobalMinimum(min.temp));
+                MinTracer->ReduceVEV(min.point);
+                MinTracer->ConvertToNonFlatDirections(min.point);
+              });
+        }
+        GridTasks.Wait();
+      }
+
+      // Trace all grid points which do not belong to a known phase in
+      // parallel. Several of them can belong to the same new phase, so the
+      // merge below repeats the check in grid order, which gives the same
+      // phase list as tracing one point after the other.
+      std::vector<int> CandidateIndex(GridMinima.size(), -1);
+      std::vector<Phase> CandidatePhases;
+      for (std::size_t i = 0; i < GridMinima.size(); i++)
+      {
+        if (MinimumFoundAlready(GridMinima.at(i)) == -1)
+        {
+          CandidateIndex.at(i) = CandidatePhases.size();
+          CandidatePhases.emplace_back();
+        }
+      }
+      {
+        TaskGroup TraceTasks;
+        for (std::size_t i = 0; i < GridMinima.size(); i++)
+        {
+          if (CandidateIndex.at(i) == -1) continue;
+          TraceTasks.Run(
+              [this, i, &GridMinima, &CandidateIndex, &CandidatePhases]()
+              {
+                const Minimum &min = GridMinima.at(i);
+                CandidatePhases.at(CandidateIndex.at(i)) =
+                    Phase(min.temp, min.point, T_high, T_low, MinTracer);
+              });
+        }
+        TraceTasks.Wait();
+      }
+
+      for (std::size_t i = 0; i < GridMinima.size(); i++)
       {
-        Minimum min;
-        min.temp = T_low + (T_high - T_low) / (num_points + 1) * i;
-        min.point =
-            MinTracer->ConvertToVEVDim(MinTracer->GetGlobalMinimum(min.temp));
-        MinTracer->ReduceVEV(min.point);
-        MinTracer->ConvertToNonFlatDirections(min.point);
-
-        if (MinimumFoundAlready(min) == -1) // found new phase
+        const Minimum &min = GridMinima.at(i);
+        if (CandidateIndex.at(i) != -1 and
+            MinimumFoundAlready(min) == -1) // found new phase
         {
           Logger::Write(
               LoggingLevel::MinTracerDetailed,
               "-------------------------------------------------------");
-          Phase inter_phase(min.temp, T_high, T_low, MinTracer);
+          Phase &inter_phase = CandidatePhases.at(CandidateIndex.at(i));
           addPhase(inter_phase);
           print(inter_phase);
         }
@@ -2280,6 +2280,11 @@ void Class_Potential_C2HDM::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_Potential_C2HDM::clone() const
+{
+  return std::make_unique<Class_Potential_C2HDM>(*this);
+}
+
 /**
  * Calculates the counterterms in the 2HDM (CP violating as well as CP
  * conserving)
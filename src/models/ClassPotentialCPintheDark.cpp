@@ -1244,6 +1244,11 @@ void Class_Potential_CPintheDark::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_Potential_CPintheDark::clone() const
+{
+  return std::make_unique<Class_Potential_CPintheDark>(*this);
+}
+
 /**
  * Calculates the counterterms. Here you need to work out the scheme and
  * implement the formulas.
@@ -574,6 +574,11 @@ void Class_CxSM::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_CxSM::clone() const
+{
+  return std::make_unique<Class_CxSM>(*this);
+}
+
 /**
  * Calculates the counterterms. Here you need to work out the scheme and
  * implement the formulas.
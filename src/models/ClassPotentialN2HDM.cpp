@@ -613,6 +613,11 @@ void Class_Potential_N2HDM::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_Potential_N2HDM::clone() const
+{
+  return std::make_unique<Class_Potential_N2HDM>(*this);
+}
+
 std::vector<double> Class_Potential_N2HDM::calc_CT() const
 {
   std::vector<double> parCT;
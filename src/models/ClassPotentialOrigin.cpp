@@ -5,8 +5,16 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <gsl/gsl_sf_gamma.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iomanip>
+#include <iterator>
+#include <list>
+#include <map>
 #include <random>
+#include <type_traits>
+#include <utility>
 
 #include "Eigen/Dense"
 
@@ -20,11 +28,607 @@
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/models/modeltests/ModelTestfunctions.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/Profiler.h>
 #include <BSMPT/utility/utility.h>
 using namespace Eigen;
 
 namespace BSMPT
 {
+namespace
+{
+/**
+ * @brief CouplingMap collects the packed couplings, ordered by their index
+ * tuple
+ */
+template <std::size_t Rank>
+using CouplingMap = std::map<std::array<std::size_t, Rank>, double>;
+
+/**
+ * @brief ToPacked converts the collected couplings into a contiguous vector
+ * and drops the vanishing ones
+ */
+template <std::size_t Rank>
+std::vector<PackedCoupling<Rank>> ToPacked(const CouplingMap<Rank> &Couplings)
+{
+  std::vector<PackedCoupling<Rank>> res;
+  res.reserve(Couplings.size());
+  for (const auto &[Index, Value] : Couplings)
+  {
+    if (Value != 0) res.push_back(PackedCoupling<Rank>{Index, Value});
+  }
+  res.shrink_to_fit();
+  return res;
+}
+
+/**
+ * @brief SortedIndex returns the index tuple in ascending order
+ */
+template <std::size_t Rank>
+std::array<std::size_t, Rank> SortedIndex(std::array<std::size_t, Rank> Index)
+{
+  std::sort(Index.begin(), Index.end());
+  return Index;
+}
+
+/**
+ * @brief PackPotential packs the tensors L1 to L4 of a potential
+ * sum_i L^i v_i + 1/2 L^{ij} v_i v_j + 1/6 L^{ijk} v_i v_j v_k + 1/24 L^{ijkl}
+ * v_i v_j v_k v_l into one term for each monomial
+ */
+void PackPotential(
+    const std::vector<double> &L1,
+    const std::vector<std::vector<double>> &L2,
+    const std::vector<std::vector<std::vector<double>>> &L3,
+    const std::vector<std::vector<std::vector<std::vector<double>>>> &L4,
+    std::vector<PackedCoupling<1>> &Packed1,
+    std::vector<PackedCoupling<2>> &Packed2,
+    std::vector<PackedCoupling<3>> &Packed3,
+    std::vector<PackedCoupling<4>> &Packed4)
+{
+  const std::size_t NHiggs = L1.size();
+  CouplingMap<1> Map1;
+  CouplingMap<2> Map2;
+  CouplingMap<3> Map3;
+  CouplingMap<4> Map4;
+  for (std::size_t i = 0; i < NHiggs; i++)
+  {
+    Map1[{i}] += L1[i];
+    for (std::size_t j = 0; j < NHiggs; j++)
+    {
+      Map2[SortedIndex<2>({i, j})] += L2[i][j] / 2.0;
+      for (std::size_t k = 0; k < NHiggs; k++)
+      {
+        Map3[SortedIndex<3>({i, j, k})] += L3[i][j][k] / 6.0;
+        for (std::size_t l = 0; l < NHiggs; l++)
+        {
+          Map4[SortedIndex<4>({i, j, k, l})] += L4[i][j][k][l] / 24.0;
+        }
+      }
+    }
+  }
+  Packed1 = ToPacked(Map1);
+  Packed2 = ToPacked(Map2);
+  Packed3 = ToPacked(Map3);
+  Packed4 = ToPacked(Map4);
+}
+
+/**
+ * @brief EvaluatePacked calculates sum Value * v_{Index[0]} * ... *
+ * v_{Index[Rank-1]}
+ */
+template <std::size_t Rank>
+double EvaluatePacked(const std::vector<PackedCoupling<Rank>> &Couplings,
+                      const std::vector<double> &v)
+{
+  double res = 0;
+  for (const auto &Coupling : Couplings)
+  {
+    double Term = Coupling.Value;
+    for (const auto &Index : Coupling.Index)
+    {
+      Term *= v[Index];
+    }
+    res += Term;
+  }
+  return res;
+}
+
+/**
+ * @brief EvaluatePackedDerivative calculates the derivative of EvaluatePacked
+ * w.r.t. v_x
+ */
+template <std::size_t Rank>
+double
+EvaluatePackedDerivative(const std::vector<PackedCoupling<Rank>> &Couplings,
+                         const std::vector<double> &v,
+                         std::size_t x)
+{
+  double res = 0;
+  for (const auto &Coupling : Couplings)
+  {
+    for (std::size_t p = 0; p < Rank; p++)
+    {
+      if (Coupling.Index[p] != x) continue;
+      double Term = Coupling.Value;
+      for (std::size_t q = 0; q < Rank; q++)
+      {
+        if (q != p) Term *= v[Coupling.Index[q]];
+      }
+      res += Term;
+    }
+  }
+  return res;
+}
+
+/**
+ * @brief SymmetricFromUpper returns the matrix with the lower triangle replaced
+ * by the upper one
+ */
+MatrixXd SymmetricFromUpper(const std::vector<std::vector<double>> &Tensor)
+{
+  const std::size_t N = Tensor.size();
+  MatrixXd res(N, N);
+  for (std::size_t i = 0; i < N; i++)
+  {
+    for (std::size_t j = i; j < N; j++)
+    {
+      res(i, j) = Tensor[i][j];
+      res(j, i) = Tensor[i][j];
+    }
+  }
+  return res;
+}
+
+/**
+ * @brief FlattenYukawa copies Y^{IJ} and Y^{IJk} into contiguous matrices and
+ * stores the Higgs fields k with a non-vanishing Y^{IJk}
+ */
+void FlattenYukawa(
+    const std::vector<std::vector<std::complex<double>>> &F2,
+    const std::vector<std::vector<std::vector<std::complex<double>>>> &F2H1,
+    const std::size_t &NHiggs,
+    MatrixXcd &FlatF2,
+    std::vector<MatrixXcd> &FlatF2H1,
+    std::vector<std::size_t> &Fields)
+{
+  const std::size_t NFermion = F2.size();
+  FlatF2                     = MatrixXcd::Zero(NFermion, NFermion);
+  FlatF2H1.assign(NHiggs, MatrixXcd::Zero(NFermion, NFermion));
+  Fields.clear();
+  for (std::size_t i = 0; i < NFermion; i++)
+  {
+    for (std::size_t j = 0; j < NFermion; j++)
+    {
+      FlatF2(i, j) = F2[i][j];
+      for (std::size_t k = 0; k < NHiggs; k++)
+      {
+        FlatF2H1[k](i, j) = F2H1[i][j][k];
+      }
+    }
+  }
+  for (std::size_t k = 0; k < NHiggs; k++)
+  {
+    if (not FlatF2H1[k].isZero(0)) Fields.push_back(k);
+  }
+}
+
+/**
+ * @brief C_VEffBatchBlockSize number of field configurations VEffBatch
+ * assembles at once, chosen such that the mass matrices of a block stay in
+ * the cache
+ */
+const std::size_t C_VEffBatchBlockSize = 64;
+
+/**
+ * @brief EvaluatePackedBatch calculates EvaluatePacked for many points at
+ * once, the column i of Fields holds v_i of all points
+ */
+template <std::size_t Rank>
+ArrayXd EvaluatePackedBatch(const std::vector<PackedCoupling<Rank>> &Couplings,
+                            const ArrayXXd &Fields)
+{
+  ArrayXd res = ArrayXd::Zero(Fields.rows());
+  ArrayXd Term(Fields.rows());
+  for (const auto &Coupling : Couplings)
+  {
+    Term.setConstant(Coupling.Value);
+    for (const auto &Index : Coupling.Index)
+    {
+      Term *= Fields.col(Index);
+    }
+    res += Term;
+  }
+  return res;
+}
+
+/**
+ * @brief IndependentBlocks splits the indices into the connected components of
+ * the pattern of non-vanishing entries. Every matrix with this pattern is
+ * block diagonal in these components.
+ */
+std::vector<std::vector<std::size_t>>
+IndependentBlocks(const Matrix<bool, Dynamic, Dynamic> &Pattern)
+{
+  const std::size_t Dim = Pattern.rows();
+  std::vector<std::size_t> Component(Dim);
+  for (std::size_t i = 0; i < Dim; i++)
+    Component[i] = i;
+  bool Changed = true;
+  while (Changed)
+  {
+    Changed = false;
+    for (std::size_t i = 0; i < Dim; i++)
+    {
+      for (std::size_t j = 0; j < Dim; j++)
+      {
+        if ((Pattern(i, j) or Pattern(j, i)) and Component[i] != Component[j])
+        {
+          Component[i] = Component[j] = std::min(Component[i], Component[j]);
+          Changed                     = true;
+        }
+      }
+    }
+  }
+  std::map<std::size_t, std::vector<std::size_t>> Blocks;
+  for (std::size_t i = 0; i < Dim; i++)
+    Blocks[Component[i]].push_back(i);
+  std::vector<std::vector<std::size_t>> res;
+  for (const auto &[Label, Block] : Blocks)
+    res.push_back(Block);
+  return res;
+}
+
+/**
+ * @brief SymmetricEigenvaluesBatch diagonalises a real symmetric matrix for
+ * each point. The column i + Dim * j of Entries holds the entry (i,j) with i
+ * <= j of all points, each block of Blocks is diagonalised on its own.
+ * Eigenvalues below ZeroMass are set to zero.
+ * @return array with the eigenvalues of the point p in the row p, they are
+ * sorted within each block only
+ */
+ArrayXXd
+SymmetricEigenvaluesBatch(const ArrayXXd &Entries,
+                          const std::size_t &Dim,
+                          const std::vector<std::vector<std::size_t>> &Blocks,
+                          const double &ZeroMass)
+{
+  const Index NPoints = Entries.rows();
+  ArrayXXd res(NPoints, Dim);
+  std::size_t Column = 0;
+  for (const auto &Block : Blocks)
+  {
+    const std::size_t Size = Block.size();
+    if (Size == 1)
+    {
+      res.col(Column) = Entries.col(Block[0] + Dim * Block[0]);
+      Column++;
+      continue;
+    }
+    MatrixXd M(Size, Size);
+    SelfAdjointEigenSolver<MatrixXd> es(Size);
+    for (Index p = 0; p < NPoints; p++)
+    {
+      for (std::size_t j = 0; j < Size; j++)
+      {
+        for (std::size_t i = 0; i <= j; i++)
+        {
+          const auto a = std::min(Block[i], Block[j]);
+          const auto b = std::max(Block[i], Block[j]);
+          M(i, j)      = Entries(p, a + Dim * b);
+          M(j, i)      = M(i, j);
+        }
+      }
+      es.compute(M, EigenvaluesOnly);
+      res.row(p).segment(Column, Size) = es.eigenvalues().transpose().array();
+    }
+    Column += Size;
+  }
+  return (res.abs() < ZeroMass).select(0.0, res);
+}
+
+/**
+ * @brief FermionEigenvaluesBatch calculates the eigenvalues of M^* M for each
+ * point, the column i + Dim * j of MIJ holds the entry (i,j) of the fermion
+ * mass matrix M of all points. Each block of Blocks, which have to be the
+ * independent blocks of M^* M, is diagonalised on its own. Eigenvalues below
+ * ZeroMass are set to zero.
+ * @return array with the eigenvalues of the point p in the row p, they are
+ * sorted within each block only
+ */
+ArrayXXd
+FermionEigenvaluesBatch(const ArrayXXcd &MIJ,
+                        const std::size_t &Dim,
+                        const std::vector<std::vector<std::size_t>> &Blocks,
+                        const double &ZeroMass)
+{
+  const Index NPoints = MIJ.rows();
+  ArrayXXd res(NPoints, Dim);
+  MatrixXcd M(Dim, Dim);
+  std::vector<MatrixXcd> Rows, Columns;
+  std::vector<SelfAdjointEigenSolver<MatrixXcd>> es;
+  for (const auto &Block : Blocks)
+  {
+    Rows.push_back(MatrixXcd(Block.size(), Dim));
+    Columns.push_back(MatrixXcd(Dim, Block.size()));
+    es.push_back(SelfAdjointEigenSolver<MatrixXcd>(Block.size()));
+  }
+  for (Index p = 0; p < NPoints; p++)
+  {
+    for (std::size_t j = 0; j < Dim; j++)
+    {
+      for (std::size_t i = 0; i < Dim; i++)
+      {
+        M(i, j) = MIJ(p, i + Dim * j);
+      }
+    }
+    std::size_t Column = 0;
+    for (std::size_t b = 0; b < Blocks.size(); b++)
+    {
+      const auto &Block = Blocks[b];
+      for (std::size_t i = 0; i < Block.size(); i++)
+      {
+        Rows[b].row(i)    = M.row(Block[i]);
+        Columns[b].col(i) = M.col(Block[i]);
+      }
+      es[b].compute(Rows[b].conjugate() * Columns[b], EigenvaluesOnly);
+      res.row(p).segment(Column, Block.size()) =
+          es[b].eigenvalues().transpose().array();
+      Column += Block.size();
+    }
+  }
+  return (res.abs() < ZeroMass).select(0.0, res);
+}
+
+/**
+ * @brief Entry of the mass spectrum cache
+ */
+struct MassCacheEntry
+{
+  int Sector;
+  std::uint64_t Generation;
+  double Temp;
+  std::vector<double> Fields;
+  std::vector<double> Masses;
+};
+
+/**
+ * @brief Least recently used cache of mass spectra, one per thread
+ */
+struct MassSpectrumCache
+{
+  std::list<MassCacheEntry> Entries;
+  Class_Potential_Origin::MassCacheStatistics Statistics;
+};
+
+MassSpectrumCache &ThreadMassCache()
+{
+  thread_local MassSpectrumCache Cache;
+  return Cache;
+}
+
+std::uint64_t NewMassCacheGeneration()
+{
+  static std::atomic<std::uint64_t> Generation{0};
+  return ++Generation;
+}
+
+/**
+ * @brief FixedSizeDimensions lists matrix dimensions which are diagonalised
+ * with fixed-size Eigen types on the stack
+ */
+template <int... Dims>
+using FixedSizeDimensions = std::integer_sequence<int, Dims...>;
+/**
+ * @brief FixedSizeBosonDimensions dimensions of the Higgs and gauge boson mass
+ * matrices of the implemented models. A model with another NHiggs falls back
+ * to dynamic matrices and opts in by adding its dimension here.
+ */
+using FixedSizeBosonDimensions = FixedSizeDimensions<1, 4, 6, 8, 9>;
+/**
+ * @brief FixedSizeFermionDimensions dimensions of the quark and lepton mass
+ * matrices of the implemented models
+ */
+using FixedSizeFermionDimensions = FixedSizeDimensions<9, 12>;
+
+/**
+ * @brief SelfAdjointEigenvalues fills a matrix of the type MatrixType and the
+ * dimension Dim with Fill and writes its eigenvalues into res. Eigenvalues
+ * below ZeroMass are set to zero.
+ */
+template <typename MatrixType, typename FillFunction>
+void SelfAdjointEigenvalues(const std::size_t &Dim,
+                            const FillFunction &Fill,
+                            const double &ZeroMass,
+                            std::vector<double> &res)
+{
+  MatrixType MassMatrix;
+  Fill(MassMatrix);
+  SelfAdjointEigenSolver<MatrixType> es(MassMatrix, EigenvaluesOnly);
+  res.resize(Dim);
+  for (std::size_t i = 0; i < Dim; i++)
+  {
+    const double tmp = es.eigenvalues()[i];
+    res[i]           = std::abs(tmp) < ZeroMass ? 0 : tmp;
+  }
+}
+
+/**
+ * @brief MassEigenvalues writes the eigenvalues of the self-adjoint mass
+ * matrix written by Fill into res. If Dim is one of Dims the matrix and the
+ * solver are fixed-size and, as long as res has the capacity for Dim entries,
+ * no heap allocation happens. Otherwise dynamic ones are used.
+ */
+template <typename Scalar, int... Dims, typename FillFunction>
+void MassEigenvalues(FixedSizeDimensions<Dims...>,
+                     const std::size_t &Dim,
+                     const FillFunction &Fill,
+                     const double &ZeroMass,
+                     std::vector<double> &res)
+{
+  const bool FixedSize =
+      ((Dim == static_cast<std::size_t>(Dims) and
+        (SelfAdjointEigenvalues<Matrix<Scalar, Dims, Dims>>(
+             Dim, Fill, ZeroMass, res),
+         true)) or
+       ...);
+  if (not FixedSize)
+  {
+    SelfAdjointEigenvalues<Matrix<Scalar, Dynamic, Dynamic>>(
+        Dim, Fill, ZeroMass, res);
+  }
+}
+
+/**
+ * @brief DividedDifference first divided difference (dF(a) - dF(b))/(a - b)
+ * of dF. For (nearly) degenerate a and b, where the quotient loses its
+ * precision, it is replaced by the derivative of dF at their mean, calculated
+ * by central differences.
+ */
+double DividedDifference(const std::function<double(double)> &dF,
+                         double a,
+                         double b,
+                         double dFa,
+                         double dFb)
+{
+  const double Step = 1e-4 * std::max({std::abs(a), std::abs(b), 1.0});
+  if (std::abs(a - b) > Step) return (dFa - dFb) / (a - b);
+  const double Mean = (a + b) / 2;
+  // The thermal functions of the fermions are not defined for negative masses,
+  // at vanishing masses the derivative is taken from the positive side
+  if (Mean >= 0 and Mean < Step)
+  {
+    return (4 * dF(Mean + Step) - dF(Mean + 2 * Step) - 3 * dF(Mean)) /
+           (2 * Step);
+  }
+  return (dF(Mean + Step) - dF(Mean - Step)) / (2 * Step);
+}
+
+/**
+ * @brief AddSpectralHessian adds the part of the Hessian of sum_k f(m_k^2)
+ * with the first derivatives of the mass matrix, m_k^2 being the eigenvalues
+ * of MassMatrix
+ * @param Hessian the Hessian to which the contribution is added
+ * @param MassMatrix the mass matrix
+ * @param MassMatrixDiff derivatives of the mass matrix w.r.t. the fields
+ * @param dF derivative of f w.r.t. m^2
+ * @return U f'(Lambda) U^dagger, the contraction of which with the second
+ * derivatives of the mass matrix gives the remaining part of the Hessian
+ */
+MatrixXcd AddSpectralHessian(MatrixXd &Hessian,
+                             const MatrixXcd &MassMatrix,
+                             const std::vector<MatrixXcd> &MassMatrixDiff,
+                             const std::function<double(double)> &dF)
+{
+  // Same threshold for vanishing masses as in FirstDerivativeOfEigenvalues
+  const double EVThres = std::pow(10, -6);
+
+  SelfAdjointEigenSolver<MatrixXcd> es(MassMatrix);
+  const Eigen::Index nSize = MassMatrix.rows();
+  VectorXd Eigenvalues     = es.eigenvalues();
+  VectorXd dFValues(nSize);
+  for (Eigen::Index k = 0; k < nSize; k++)
+  {
+    if (std::abs(Eigenvalues(k)) < EVThres) Eigenvalues(k) = 0;
+    dFValues(k) = dF(Eigenvalues(k));
+  }
+
+  MatrixXd Divided(nSize, nSize);
+  for (Eigen::Index k = 0; k < nSize; k++)
+  {
+    for (Eigen::Index l = k; l < nSize; l++)
+    {
+      Divided(k, l) = DividedDifference(
+          dF, Eigenvalues(k), Eigenvalues(l), dFValues(k), dFValues(l));
+      Divided(l, k) = Divided(k, l);
+    }
+  }
+
+  const auto &U = es.eigenvectors();
+  std::vector<MatrixXcd> Rotated;
+  std::vector<std::size_t> Fields;
+  for (std::size_t i = 0; i < MassMatrixDiff.size(); i++)
+  {
+    if (MassMatrixDiff[i].isZero(0)) continue;
+    Rotated.push_back(U.adjoint() * MassMatrixDiff[i] * U);
+    Fields.push_back(i);
+  }
+  for (std::size_t i = 0; i < Fields.size(); i++)
+  {
+    for (std::size_t j = i; j < Fields.size(); j++)
+    {
+      const double Contribution =
+          (Divided.array() *
+           (Rotated[i].array() * Rotated[j].array().conjugate()).real())
+              .sum();
+      Hessian(Fields[i], Fields[j]) += Contribution;
+      if (i != j) Hessian(Fields[j], Fields[i]) += Contribution;
+    }
+  }
+
+  return U * dFValues.asDiagonal() * U.adjoint();
+}
+
+/**
+ * @brief AddPackedSecondDerivatives adds the contraction of Weights with the
+ * second derivatives of a mass matrix made of the packed quartic couplings
+ * Coupling.Value * v_k * v_l, which only hold the upper triangle a <= b and k
+ * <= l
+ */
+void AddPackedSecondDerivatives(MatrixXd &Hessian,
+                                const MatrixXcd &Weights,
+                                const std::vector<PackedCoupling<4>> &Couplings)
+{
+  for (const auto &Coupling : Couplings)
+  {
+    const auto &[a, b, k, l] = Coupling.Index;
+    const double Weight =
+        (a == b ? 1 : 2) * Weights(a, b).real() * Coupling.Value;
+    if (k == l)
+    {
+      Hessian(k, k) += 2 * Weight;
+    }
+    else
+    {
+      Hessian(k, l) += Weight;
+      Hessian(l, k) += Weight;
+    }
+  }
+}
+
+/**
+ * @brief AddYukawaSecondDerivatives adds the contraction of Weights with the
+ * second derivatives conj(F_m) F_n + conj(F_n) F_m of the squared fermion mass
+ * matrix
+ */
+void AddYukawaSecondDerivatives(MatrixXd &Hessian,
+                                const MatrixXcd &Weights,
+                                const std::vector<MatrixXcd> &MassF2H1,
+                                const std::vector<std::size_t> &Fields)
+{
+  for (const auto &m : Fields)
+  {
+    for (const auto &n : Fields)
+    {
+      const MatrixXcd SecondDerivative =
+          MassF2H1[m].conjugate() * MassF2H1[n] +
+          MassF2H1[n].conjugate() * MassF2H1[m];
+      Hessian(m, n) +=
+          (Weights.array() * SecondDerivative.transpose().array()).sum().real();
+    }
+  }
+}
+
+/**
+ * @brief ThreadMassSpectrumBuffers buffers used by V1Loop, one per thread
+ */
+Class_Potential_Origin::MassSpectrumBuffers &ThreadMassSpectrumBuffers()
+{
+  thread_local Class_Potential_Origin::MassSpectrumBuffers Buffers;
+  return Buffers;
+}
+
+} // namespace
+
 Class_Potential_Origin::Class_Potential_Origin()
     : Class_Potential_Origin(GetSMConstants())
 {
@@ -33,6 +637,7 @@ Class_Potential_Origin::Class_Potential_Origin()
 Class_Potential_Origin::Class_Potential_Origin(const ISMConstants &smConstants)
     : SMConstants{smConstants}
     , scale{SMConstants.C_vev0}
+    , MassCacheGeneration{NewMassCacheGeneration()}
 
 {
   // TODO Auto-generated constructor stub
@@ -54,10 +659,94 @@ void Class_Potential_Origin::set_All(const std::vector<double> &par,
   set_gen(par);
   if (!SetCurvatureDone) SetCurvatureArrays();
   set_CT_Pot_Par(parCT);
+  FlattenCurvatureArrays();
   CalculateDebye();
   CalculateDebyeGauge();
 }
 
+std::shared_ptr<const Class_Potential_Origin>
+Class_Potential_Origin::Prepare() const
+{
+  if (not FlatCurvatureDone)
+  {
+    throw std::runtime_error("Prepare requires an initialised parameter point. "
+                             "Call initModel or set_All first.");
+  }
+  return clone();
+}
+
+void Class_Potential_Origin::SetUseMassCache(bool enable, std::size_t size)
+{
+  UseMassCache  = enable;
+  MassCacheSize = std::max<std::size_t>(size, 1);
+}
+
+Class_Potential_Origin::MassCacheStatistics
+Class_Potential_Origin::GetMassCacheStatistics()
+{
+  return ThreadMassCache().Statistics;
+}
+
+void Class_Potential_Origin::ResetMassCacheStatistics()
+{
+  ThreadMassCache().Entries.clear();
+  ThreadMassCache().Statistics = MassCacheStatistics();
+}
+
+void Class_Potential_Origin::InvalidateMassCache()
+{
+  MassCacheGeneration = NewMassCacheGeneration();
+}
+
+bool Class_Potential_Origin::FindInMassCache(int Sector,
+                                             const std::vector<double> &v,
+                                             double Temp,
+                                             std::vector<double> &res) const
+{
+  auto &Cache = ThreadMassCache();
+  for (auto it = Cache.Entries.begin(); it != Cache.Entries.end(); ++it)
+  {
+    if (it->Sector == Sector and it->Generation == MassCacheGeneration and
+        it->Temp == Temp and it->Fields == v)
+    {
+      Cache.Entries.splice(Cache.Entries.begin(), Cache.Entries, it);
+      Cache.Statistics.Hits++;
+      res = it->Masses;
+      return true;
+    }
+  }
+  Cache.Statistics.Misses++;
+  return false;
+}
+
+void Class_Potential_Origin::StoreInMassCache(
+    int Sector,
+    const std::vector<double> &v,
+    double Temp,
+    const std::vector<double> &res) const
+{
+  auto &Cache = ThreadMassCache();
+  if (Cache.Entries.size() >= MassCacheSize)
+  {
+    // reuse the least recently used entry
+    Cache.Entries.splice(
+        Cache.Entries.begin(), Cache.Entries, std::prev(Cache.Entries.end()));
+    auto &entry      = Cache.Entries.front();
+    entry.Sector     = Sector;
+    entry.Generation = MassCacheGeneration;
+    entry.Temp       = Temp;
+    entry.Fields     = v;
+    entry.Masses     = res;
+    while (Cache.Entries.size() > MassCacheSize)
+    {
+      Cache.Entries.pop_back();
+    }
+    return;
+  }
+  Cache.Entries.push_front(
+      MassCacheEntry{Sector, MassCacheGeneration, Temp, v, res});
+}
+
 void Class_Potential_Origin::Prepare_Triple()
 {
   for (std::size_t a = 0; a < NHiggs; a++)
@@ -115,7 +804,7 @@ double Class_Potential_Origin::boson(double MassSquared,
                                      int diff) const
 {
   double res = 0;
-  if (diff >= 0) res = CWTerm(std::abs(MassSquared), cb, diff);
+  if (diff >= 0) res = CWTerm(MassSquared, cb, diff);
   if (Temp == 0) return res;
   double Ratio = MassSquared / std::pow(Temp, 2);
   if (diff == 0)
@@ -123,18 +812,18 @@ double Class_Potential_Origin::boson(double MassSquared,
     res += std::pow(Temp, 4) / (2 * std::pow(M_PI, 2)) *
            ThermalFunctions::JbosonInterpolated(Ratio);
   }
-  else if (diff == 1)
+  else if (diff > 0)
   {
     res += std::pow(Temp, 2) / (2 * std::pow(M_PI, 2)) *
-           ThermalFunctions::JbosonNumericalIntegration(Ratio, 1);
+           ThermalFunctions::JbosonInterpolated(Ratio, 1);
   }
   else if (diff == -1)
   {
     res += 1.0 / (2 * std::pow(M_PI, 2)) *
            (4 * std::pow(Temp, 3) *
-                ThermalFunctions::JbosonNumericalIntegration(Ratio, 0) -
+                ThermalFunctions::JbosonInterpolated(Ratio) -
             2 * Temp * MassSquared *
-                ThermalFunctions::JbosonNumericalIntegration(Ratio, 1));
+                ThermalFunctions::JbosonInterpolated(Ratio, 1));
   }
   return res;
 }
@@ -143,7 +832,7 @@ double
 Class_Potential_Origin::fermion(double MassSquared, double Temp, int diff) const
 {
   double res = 0;
-  if (diff >= 0) res = CWTerm(std::abs(MassSquared), C_CWcbFermion, diff);
+  if (diff >= 0) res = CWTerm(MassSquared, C_CWcbFermion, diff);
   double Ratio = MassSquared / std::pow(Temp, 2);
   if (Temp == 0) return res;
   if (diff == 0)
@@ -151,18 +840,18 @@ Class_Potential_Origin::fermion(double MassSquared, double Temp, int diff) const
     res += std::pow(Temp, 4) / (2 * std::pow(M_PI, 2)) *
            ThermalFunctions::JfermionInterpolated(Ratio);
   }
-  else if (diff == 1)
+  else if (diff > 0)
   {
     res += std::pow(Temp, 2) / (2 * std::pow(M_PI, 2)) *
-           ThermalFunctions::JfermionNumericalIntegration(Ratio, 1);
+           ThermalFunctions::JfermionInterpolated(Ratio, 1);
   }
   else if (diff == -1)
   {
     res += 1.0 / (2 * std::pow(M_PI, 2)) *
            (4 * std::pow(Temp, 3) *
-                ThermalFunctions::JfermionNumericalIntegration(Ratio) -
+                ThermalFunctions::JfermionInterpolated(Ratio) -
             2 * Temp * MassSquared *
-                ThermalFunctions::JfermionNumericalIntegration(Ratio, 1));
+                ThermalFunctions::JfermionInterpolated(Ratio, 1));
   }
   return res;
 }
@@ -172,6 +861,20 @@ std::vector<double> Class_Potential_Origin::FirstDerivativeOfEigenvalues(
     const Ref<MatrixXcd> MDiff) const
 {
   std::vector<double> res;
+  const auto EVAndDerivatives =
+      FirstDerivativeOfEigenvalues(M, std::vector<MatrixXcd>{MDiff});
+  for (const auto &el : EVAndDerivatives)
+  {
+    res.insert(res.end(), el.begin(), el.end());
+  }
+  return res;
+}
+
+std::vector<std::vector<double>>
+Class_Potential_Origin::FirstDerivativeOfEigenvalues(
+    const Ref<MatrixXcd> M,
+    const std::vector<MatrixXcd> &MDiff) const
+{
   const std::size_t nRows = M.rows();
   const std::size_t nCols = M.cols();
 
@@ -188,100 +891,79 @@ std::vector<double> Class_Potential_Origin::FirstDerivativeOfEigenvalues(
   SelfAdjointEigenSolver<MatrixXcd> es;
   es.compute(M);
 
-  std::vector<std::complex<double>> Eigenvalues(nSize);
-  std::vector<std::complex<double>> Derivatives(nSize);
-  std::vector<double> AlreadyCalculated(
-      nSize); // Array to check which EVs already been calculated.
+  std::vector<std::vector<double>> res(MDiff.size() + 1,
+                                       std::vector<double>(nSize));
   for (std::size_t i = 0; i < nSize; i++)
   {
-    Eigenvalues[i] = es.eigenvalues()[i];
-    if (std::abs(Eigenvalues[i]) < EVThres)
+    res[0][i] = es.eigenvalues()[i];
+    if (std::abs(res[0][i]) < EVThres)
     {
-      Eigenvalues[i] = 0;
+      res[0][i] = 0;
     }
   }
 
-  std::vector<std::vector<double>> Mapping(nSize, std::vector<double>(nSize));
-
-  for (std::size_t i = 0; i < nSize; i++)
+  // Group the indices of (numerically) degenerate eigenvalues. The eigenvalues
+  // are sorted, so every group is a contiguous block. The grouping and the
+  // eigenvectors only depend on M and are shared between all directions.
+  std::vector<std::vector<std::size_t>> DegenerateGroups;
+  std::vector<bool> AlreadyCalculated(nSize, false);
+  for (std::size_t p = 0; p < nSize; p++)
   {
-    AlreadyCalculated[i] = -1;
-    for (std::size_t j = i; j < nSize; j++)
+    if (AlreadyCalculated[p]) continue;
+    std::vector<std::size_t> Group{p};
+    AlreadyCalculated[p] = true;
+    for (std::size_t i = p + 1; i < nSize; i++)
     {
-      if (std::abs(Eigenvalues[i] - Eigenvalues[j]) > EVThres)
+      if (std::abs(res[0][p] - res[0][i]) <= EVThres)
       {
-        Mapping[i][j] = 0;
-      }
-      else
-      {
-        Mapping[i][j] = 1;
+        Group.push_back(i);
+        AlreadyCalculated[i] = true;
       }
     }
+    DegenerateGroups.push_back(Group);
   }
-  for (std::size_t i = 1; i < nSize; i++)
+
+  std::vector<MatrixXcd> Phi;
+  Phi.reserve(DegenerateGroups.size());
+  for (const auto &Group : DegenerateGroups)
   {
-    for (std::size_t j = 0; j < i; j++)
-      Mapping[i][j] = Mapping[j][i];
+    MatrixXcd PhiGroup(nSize, Group.size());
+    for (std::size_t i = 0; i < Group.size(); i++)
+    {
+      PhiGroup.col(i) = es.eigenvectors().col(Group[i]);
+    }
+    Phi.push_back(PhiGroup);
   }
 
-  for (std::size_t p = 0; p < nSize; p++)
+  for (std::size_t d = 0; d < MDiff.size(); d++)
   {
-    if (AlreadyCalculated[p] == -1)
+    auto &Derivatives = res[d + 1];
+    for (std::size_t g = 0; g < DegenerateGroups.size(); g++)
     {
-      std::size_t NumOfReps = 0;
-      for (std::size_t i = p + 1; i < nSize; i++)
-      {
-        NumOfReps += Mapping[p][i];
-      }
-      if (NumOfReps == 0)
+      const auto &Group = DegenerateGroups[g];
+      if (Group.size() == 1)
       {
-        VectorXcd v(nSize);
-        v = es.eigenvectors().col(p);
-        // Derivatives[p] = (v.transpose()*MDiff*v).value();
-        Derivatives[p]       = (v.adjoint() * MDiff * v).value();
-        AlreadyCalculated[p] = 1;
+        Derivatives[Group[0]] =
+            (Phi[g].col(0).adjoint() * MDiff[d] * Phi[g].col(0)).value().real();
       }
       else
       {
-        MatrixXcd Phi(nSize, NumOfReps + 1);
-        std::size_t helpCol = 0;
-        MatrixXcd MXWork(NumOfReps + 1, NumOfReps + 1);
-
-        for (std::size_t i = p; i < nSize; i++)
+        // Degenerate perturbation theory: the derivatives are the eigenvalues
+        // of MDiff projected onto the degenerate eigenspace
+        MatrixXcd MXWork = Phi[g].adjoint() * MDiff[d] * Phi[g];
+        SelfAdjointEigenSolver<MatrixXcd> esWork(MXWork, EigenvaluesOnly);
+        for (std::size_t i = 0; i < Group.size(); i++)
         {
-          if (Mapping[p][i] == 1)
-          {
-            Phi.col(helpCol) = es.eigenvectors().col(i);
-            helpCol++;
-          }
-        }
-        MXWork = Phi.adjoint() * MDiff * Phi;
-        SelfAdjointEigenSolver<MatrixXcd> esWork;
-        esWork.compute(MXWork);
-        helpCol = 0;
-        for (std::size_t i = p; i < nSize; i++)
-        {
-          if (Mapping[p][i] == 1)
-          {
-            AlreadyCalculated[i] = 1;
-            Derivatives[i]       = esWork.eigenvalues()[helpCol];
-            helpCol++;
-          }
+          Derivatives[Group[i]] = esWork.eigenvalues()[i];
         }
       }
     }
-  }
-  for (std::size_t i = 0; i < nSize; i++)
-  {
-    if (std::abs(Derivatives[i]) < EVThres) Derivatives[i] = 0;
+    for (auto &el : Derivatives)
+    {
+      if (std::abs(el) < EVThres) el = 0;
+    }
   }
 
-  for (std::size_t i = 0; i < nSize; i++)
-  {
-    res.push_back(Eigenvalues[i].real());
-  }
-  for (std::size_t i = 0; i < nSize; i++)
-    res.push_back(Derivatives[i].real());
   return res;
 }
 
@@ -894,7 +1576,7 @@ Class_Potential_Origin::SecondDerivativeOfEigenvaluesNonRepeated(
   const std::size_t nRows = M.rows();
   const std::size_t nCols = M.cols();
 
-  const std::size_t EVThres = std::pow(10, -6);
+  const double EVThres = std::pow(10, -6);
 
   if (nCols != nRows)
   {
@@ -2321,6 +3003,83 @@ std::vector<double> Class_Potential_Origin::WeinbergForthDerivative() const
   return res;
 }
 
+template <typename MatrixType>
+void Class_Potential_Origin::FillHiggsMassMatrix(MatrixType &res,
+                                                 const std::vector<double> &v,
+                                                 double Temp) const
+{
+  res = MassHiggs_L2;
+  for (const auto &Coupling : MassHiggs_L3)
+  {
+    const auto &[i, j, k] = Coupling.Index;
+    res(i, j) += Coupling.Value * v[k];
+  }
+  for (const auto &Coupling : MassHiggs_L4)
+  {
+    const auto &[i, j, k, l] = Coupling.Index;
+    res(i, j) += Coupling.Value * v[k] * v[l];
+  }
+  if (Temp != 0)
+  {
+    res += MassDebyeHiggs * std::pow(Temp, 2);
+  }
+  for (std::size_t i{1}; i < NHiggs; ++i)
+  {
+    for (std::size_t j{0}; j < i; ++j)
+    {
+      res(i, j) = res(j, i);
+    }
+  }
+}
+
+template <typename MatrixType>
+void Class_Potential_Origin::FillGaugeMassMatrix(MatrixType &res,
+                                                 const std::vector<double> &v,
+                                                 double Temp) const
+{
+  res.setZero(NGauge, NGauge);
+  for (const auto &Coupling : MassGauge_G2H2)
+  {
+    const auto &[a, b, i, j] = Coupling.Index;
+    res(a, b) += Coupling.Value * v[i] * v[j];
+  }
+  if (Temp != 0)
+  {
+    res += MassDebyeGauge * std::pow(Temp, 2);
+  }
+  for (std::size_t a{1}; a < NGauge; ++a)
+  {
+    for (std::size_t b{0}; b < a; ++b)
+    {
+      res(a, b) = res(b, a);
+    }
+  }
+}
+
+template <typename MatrixType>
+void Class_Potential_Origin::FillQuarkMassMatrix(
+    MatrixType &res,
+    const std::vector<double> &v) const
+{
+  res = MassQuark_F2;
+  for (const auto &k : MassQuark_Fields)
+  {
+    res += MassQuark_F2H1[k] * v[k];
+  }
+}
+
+template <typename MatrixType>
+void Class_Potential_Origin::FillLeptonMassMatrix(
+    MatrixType &res,
+    const std::vector<double> &v) const
+{
+  res = MassLepton_F2;
+  for (const auto &k : MassLepton_Fields)
+  {
+    res += MassLepton_F2H1[k] * v[k];
+  }
+}
+
 MatrixXd Class_Potential_Origin::HiggsMassMatrix(const std::vector<double> &v,
                                                  double Temp,
                                                  int diff) const
@@ -2358,28 +3117,30 @@ MatrixXd Class_Potential_Origin::HiggsMassMatrix(const std::vector<double> &v,
     throw std::runtime_error(
         "SetCurvatureDone is not set. The Model is not initiliased correctly");
   }
+  if (!FlatCurvatureDone)
+  {
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
+  }
 
   if (diff == 0)
   {
-    for (std::size_t i = 0; i < NHiggs; i++)
+    FillHiggsMassMatrix(res, v, Temp);
+  }
+  else if (static_cast<size_t>(diff) <= NHiggs and diff > 0)
+  {
+    std::size_t x0 = diff - 1;
+    res            = MatrixXd::Zero(NHiggs, NHiggs);
+    for (const auto &Coupling : MassHiggs_L3)
     {
-      for (std::size_t j = i; j < NHiggs; j++)
-      {
-        res(i, j) = Curvature_Higgs_L2[i][j];
-        for (std::size_t k = 0; k < NHiggs; k++)
-        {
-          res(i, j) += Curvature_Higgs_L3[i][j][k] * v[k];
-          for (std::size_t l = 0; l < NHiggs; l++)
-          {
-            res(i, j) += 0.5 * Curvature_Higgs_L4[i][j][k][l] * v[k] * v[l];
-          }
-        }
-
-        if (Temp != 0)
-        {
-          res(i, j) += DebyeHiggs[i][j] * std::pow(Temp, 2);
-        }
-      }
+      const auto &[i, j, k] = Coupling.Index;
+      if (k == x0) res(i, j) += Coupling.Value;
+    }
+    for (const auto &Coupling : MassHiggs_L4)
+    {
+      const auto &[i, j, k, l] = Coupling.Index;
+      if (k == x0) res(i, j) += Coupling.Value * v[l];
+      if (l == x0) res(i, j) += Coupling.Value * v[k];
     }
     for (std::size_t i{1}; i < NHiggs; ++i)
     {
@@ -2389,45 +3150,145 @@ MatrixXd Class_Potential_Origin::HiggsMassMatrix(const std::vector<double> &v,
       }
     }
   }
-  else if (static_cast<size_t>(diff) <= NHiggs and diff > 0)
+  else if (diff == -1)
   {
-    std::size_t x0 = diff - 1;
-    for (std::size_t i = 0; i < NHiggs; i++)
-    {
-      for (std::size_t j = 0; j < NHiggs; j++)
-      {
-        res(i, j) = Curvature_Higgs_L3[i][j][x0];
-        for (std::size_t k = 0; k < NHiggs; k++)
-        {
-          res(i, j) += Curvature_Higgs_L4[i][j][x0][k] * v[k];
-        }
-      }
-    }
+    res = 2 * Temp * MassDebyeHiggs;
   }
-  else if (diff == -1)
+  return res;
+}
+
+MatrixXd Class_Potential_Origin::GaugeMassMatrix(const std::vector<double> &v,
+                                                 const double &Temp) const
+{
+  if (v.size() == nVEV and nVEV != NHiggs)
   {
-    for (std::size_t i = 0; i < NHiggs; i++)
-    {
-      for (std::size_t j = 0; j < NHiggs; j++)
-      {
-        res(i, j) = 2 * DebyeHiggs[i][j] * Temp;
-      }
-    }
+    return GaugeMassMatrix(MinimizeOrderVEV(v), Temp);
+  }
+  if (v.size() != NHiggs)
+  {
+    throw std::runtime_error(
+        std::string("You have called ") + __func__ +
+        " with an invalid vev configuration. Your vev is of dimension " +
+        std::to_string(v.size()) + " and it should be " +
+        std::to_string(NHiggs) + ".");
+  }
+  if (!SetCurvatureDone)
+  {
+    std::string retmes = __func__;
+    retmes += "was called while the model was not initialised correctly.\n";
+    throw std::runtime_error(retmes);
   }
+  if (!FlatCurvatureDone)
+  {
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
+  }
+
+  MatrixXd res;
+  FillGaugeMassMatrix(res, v, Temp);
   return res;
 }
 
+void Class_Potential_Origin::HiggsMassesSquared(std::vector<double> &res,
+                                                const std::vector<double> &v,
+                                                const double &Temp) const
+{
+  if (v.size() != NHiggs or not FlatCurvatureDone)
+  {
+    res = HiggsMassesSquared(v, Temp);
+    return;
+  }
+  BSMPT_PROFILE_COUNT(HiggsMassesSquared);
+  if (UseMassCache and FindInMassCache(0, v, Temp, res)) return;
+  MassEigenvalues<double>(
+      FixedSizeBosonDimensions{},
+      NHiggs,
+      [&](auto &MassMatrix) { FillHiggsMassMatrix(MassMatrix, v, Temp); },
+      1e-5,
+      res);
+  if (UseMassCache) StoreInMassCache(0, v, Temp, res);
+}
+
+void Class_Potential_Origin::GaugeMassesSquared(std::vector<double> &res,
+                                                const std::vector<double> &v,
+                                                const double &Temp) const
+{
+  if (v.size() != NHiggs or not FlatCurvatureDone)
+  {
+    res = GaugeMassesSquared(v, Temp);
+    return;
+  }
+  if (UseMassCache and FindInMassCache(1, v, Temp, res)) return;
+  MassEigenvalues<double>(
+      FixedSizeBosonDimensions{},
+      NGauge,
+      [&](auto &MassMatrix) { FillGaugeMassMatrix(MassMatrix, v, Temp); },
+      1e-5,
+      res);
+  if (UseMassCache) StoreInMassCache(1, v, Temp, res);
+}
+
+void Class_Potential_Origin::QuarkMassesSquared(
+    std::vector<double> &res,
+    const std::vector<double> &v) const
+{
+  if (v.size() != NHiggs or not FlatCurvatureDone)
+  {
+    res = QuarkMassesSquared(v);
+    return;
+  }
+  if (UseMassCache and FindInMassCache(2, v, 0, res)) return;
+  auto FillMassMatrix = [&](auto &MassMatrix)
+  {
+    std::decay_t<decltype(MassMatrix)> MIJ;
+    FillQuarkMassMatrix(MIJ, v);
+    MassMatrix.noalias() = MIJ.conjugate() * MIJ;
+  };
+  MassEigenvalues<std::complex<double>>(
+      FixedSizeFermionDimensions{}, NQuarks, FillMassMatrix, 1e-10, res);
+  if (UseMassCache) StoreInMassCache(2, v, 0, res);
+}
+
+void Class_Potential_Origin::LeptonMassesSquared(
+    std::vector<double> &res,
+    const std::vector<double> &v) const
+{
+  if (v.size() != NHiggs or not FlatCurvatureDone)
+  {
+    res = LeptonMassesSquared(v);
+    return;
+  }
+  if (UseMassCache and FindInMassCache(3, v, 0, res)) return;
+  auto FillMassMatrix = [&](auto &MassMatrix)
+  {
+    std::decay_t<decltype(MassMatrix)> MIJ;
+    FillLeptonMassMatrix(MIJ, v);
+    MassMatrix.noalias() = MIJ.conjugate() * MIJ;
+  };
+  MassEigenvalues<std::complex<double>>(
+      FixedSizeFermionDimensions{}, NLepton, FillMassMatrix, 1e-10, res);
+  if (UseMassCache) StoreInMassCache(3, v, 0, res);
+}
+
 std::vector<double>
 Class_Potential_Origin::HiggsMassesSquared(const std::vector<double> &v,
                                            const double &Temp,
                                            const int &diff) const
 {
   std::vector<double> res;
-
-  auto MassMatrix = HiggsMassMatrix(v, Temp, diff);
+  if (diff == 0 and v.size() == NHiggs and FlatCurvatureDone)
+  {
+    HiggsMassesSquared(res, v, Temp);
+    return res;
+  }
+  BSMPT_PROFILE_COUNT(HiggsMassesSquared);
+  const bool UseCache = UseMassCache and diff == 0;
+  if (UseCache and FindInMassCache(0, v, Temp, res)) return res;
 
   double ZeroMass = std::pow(10, -5);
 
+  auto MassMatrix = HiggsMassMatrix(v, Temp);
+
   if (diff == 0 and res.size() == 0)
   {
     SelfAdjointEigenSolver<MatrixXd> es(MassMatrix, EigenvaluesOnly);
@@ -2503,6 +3364,7 @@ Class_Potential_Origin::HiggsMassesSquared(const std::vector<double> &v,
     res      = FirstDerivativeOfEigenvalues(MassCast, DiffCast);
   }
 
+  if (UseCache) StoreInMassCache(0, v, Temp, res);
   return res;
 }
 
@@ -2545,59 +3407,30 @@ Class_Potential_Origin::GaugeMassesSquared(const std::vector<double> &v,
     retmes += "was called while the model was not initialised correctly.\n";
     throw std::runtime_error(retmes);
   }
-  MatrixXd MassMatrix(NGauge, NGauge);
-  double ZeroMass = std::pow(10, -5);
-  for (std::size_t a = 0; a < NGauge; a++)
+  if (diff == 0 and FlatCurvatureDone)
   {
-    for (std::size_t b = 0; b < NGauge; b++)
-    {
-      MassMatrix(a, b) = 0;
-      for (std::size_t i = 0; i < NHiggs; i++)
-      {
-        for (std::size_t j = 0; j < NHiggs; j++)
-          MassMatrix(a, b) +=
-              0.5 * Curvature_Gauge_G2H2[a][b][i][j] * v.at(i) * v.at(j);
-      }
-
-      if (Temp != 0)
-      {
-        MassMatrix(a, b) += DebyeGauge[a][b] * std::pow(Temp, 2);
-      }
-    }
-  }
-
-  for (std::size_t a{1}; a < NGauge; ++a)
-  {
-    for (std::size_t b{0}; b < a; ++b)
-    {
-      MassMatrix(a, b) = MassMatrix(b, a);
-    }
+    GaugeMassesSquared(res, v, Temp);
+    return res;
   }
+  const bool UseCache = UseMassCache and diff == 0;
+  if (UseCache and FindInMassCache(1, v, Temp, res)) return res;
 
-  if (diff == 0)
-  {
-
-    SelfAdjointEigenSolver<MatrixXd> es(MassMatrix, EigenvaluesOnly);
-    for (std::size_t i = 0; i < NGauge; i++)
+  MatrixXd MassMatrix = GaugeMassMatrix(v, Temp);
+  if (diff > 0 and static_cast<size_t>(diff) <= NHiggs)
+  {
+    std::size_t x0 = diff - 1;
+    MatrixXd Diff  = MatrixXd::Zero(NGauge, NGauge);
+    for (const auto &Coupling : MassGauge_G2H2)
     {
-      double tmp = es.eigenvalues()[i];
-      if (std::abs(tmp) < ZeroMass)
-        res.push_back(0);
-      else
-        res.push_back(tmp);
+      const auto &[a, b, i, j] = Coupling.Index;
+      if (i == x0) Diff(a, b) += Coupling.Value * v[j];
+      if (j == x0) Diff(a, b) += Coupling.Value * v[i];
     }
-  }
-  else if (diff > 0 and static_cast<size_t>(diff) <= NHiggs)
-  {
-    std::size_t i = diff - 1;
-    MatrixXd Diff(NGauge, NGauge);
-    Diff = MatrixXd::Zero(NGauge, NGauge);
-    for (std::size_t a = 0; a < NGauge; a++)
+    for (std::size_t a{1}; a < NGauge; ++a)
     {
-      for (std::size_t b = 0; b < NGauge; b++)
+      for (std::size_t b{0}; b < a; ++b)
       {
-        for (std::size_t j = 0; j < NHiggs; j++)
-          Diff(a, b) += Curvature_Gauge_G2H2[a][b][i][j] * v[j];
+        Diff(a, b) = Diff(b, a);
       }
     }
     MatrixXcd MassCast(NGauge, NGauge);
@@ -2608,14 +3441,7 @@ Class_Potential_Origin::GaugeMassesSquared(const std::vector<double> &v,
   }
   else if (diff == -1)
   {
-    MatrixXd Diff(NGauge, NGauge);
-    for (std::size_t i = 0; i < NGauge; i++)
-    {
-      for (std::size_t j = 0; j < NGauge; j++)
-      {
-        Diff(i, j) = 2 * DebyeGauge[i][j] * Temp;
-      }
-    }
+    MatrixXd Diff = 2 * Temp * MassDebyeGauge;
 
     MatrixXcd MassCast(NGauge, NGauge);
     MassCast = MassMatrix;
@@ -2624,6 +3450,7 @@ Class_Potential_Origin::GaugeMassesSquared(const std::vector<double> &v,
     res      = FirstDerivativeOfEigenvalues(MassCast, DiffCast);
   }
 
+  if (UseCache) StoreInMassCache(1, v, Temp, res);
   return res;
 }
 
@@ -2632,6 +3459,13 @@ Class_Potential_Origin::QuarkMassesSquared(const std::vector<double> &v,
                                            const int &diff) const
 {
   std::vector<double> res;
+  if (diff <= 0 and v.size() == NHiggs and FlatCurvatureDone)
+  {
+    QuarkMassesSquared(res, v);
+    return res;
+  }
+  const bool UseCache = UseMassCache and diff <= 0;
+  if (UseCache and FindInMassCache(2, v, 0, res)) return res;
   MatrixXcd MassMatrix(NQuarks, NQuarks), MIJ(NQuarks, NQuarks);
   MIJ             = QuarkMassMatrix(v);
   double ZeroMass = std::pow(10, -10);
@@ -2653,19 +3487,8 @@ Class_Potential_Origin::QuarkMassesSquared(const std::vector<double> &v,
   else if (static_cast<size_t>(diff) <= NHiggs)
   {
     std::size_t m = diff - 1;
-    MatrixXcd Diff(NQuarks, NQuarks);
-    Diff = MatrixXcd::Zero(NQuarks, NQuarks);
-    for (std::size_t a = 0; a < NQuarks; a++)
-    {
-      for (std::size_t b = 0; b < NQuarks; b++)
-      {
-        for (std::size_t i = 0; i < NQuarks; i++)
-        {
-          Diff(a, b) += std::conj(Curvature_Quark_F2H1[a][i][m]) * MIJ(i, b);
-          Diff(a, b) += std::conj(MIJ(a, i)) * Curvature_Quark_F2H1[i][b][m];
-        }
-      }
-    }
+    MatrixXcd Diff = MassQuark_F2H1[m].conjugate() * MIJ +
+                     MIJ.conjugate() * MassQuark_F2H1[m];
 
     res = FirstDerivativeOfEigenvalues(MassMatrix, Diff);
 
@@ -2722,6 +3545,7 @@ Class_Potential_Origin::QuarkMassesSquared(const std::vector<double> &v,
     }
   }
 
+  if (UseCache) StoreInMassCache(2, v, 0, res);
   return res;
 }
 
@@ -2730,6 +3554,13 @@ Class_Potential_Origin::LeptonMassesSquared(const std::vector<double> &v,
                                             const int &diff) const
 {
   std::vector<double> res;
+  if (diff <= 0 and v.size() == NHiggs and FlatCurvatureDone)
+  {
+    LeptonMassesSquared(res, v);
+    return res;
+  }
+  const bool UseCache = UseMassCache and diff <= 0;
+  if (UseCache and FindInMassCache(3, v, 0, res)) return res;
   MatrixXcd MassMatrix(NLepton, NLepton), MIJ(NLepton, NLepton);
   double ZeroMass = std::pow(10, -10);
   MIJ             = LeptonMassMatrix(v);
@@ -2752,18 +3583,8 @@ Class_Potential_Origin::LeptonMassesSquared(const std::vector<double> &v,
   {
 
     auto k         = diff - 1;
-    MatrixXcd Diff = MatrixXcd::Zero(NLepton, NLepton);
-    for (std::size_t I{0}; I < NLepton; ++I)
-    {
-      for (std::size_t J{0}; J < NLepton; ++J)
-      {
-        for (std::size_t L{0}; L < NLepton; ++L)
-        {
-          Diff(I, J) += std::conj(Curvature_Lepton_F2H1[I][L][k]) * MIJ(L, J);
-          Diff(I, J) += std::conj(MIJ(I, L)) * Curvature_Lepton_F2H1[L][J][k];
-        }
-      }
-    }
+    MatrixXcd Diff = MassLepton_F2H1[k].conjugate() * MIJ +
+                     MIJ.conjugate() * MassLepton_F2H1[k];
 
     res = FirstDerivativeOfEigenvalues(MassMatrix, Diff);
 
@@ -2820,9 +3641,157 @@ Class_Potential_Origin::LeptonMassesSquared(const std::vector<double> &v,
     }
   }
 
+  if (UseCache) StoreInMassCache(3, v, 0, res);
+  return res;
+}
+
+std::vector<std::vector<double>>
+Class_Potential_Origin::HiggsMassesSquaredGradient(const std::vector<double> &v,
+                                                   const double &Temp) const
+{
+  MatrixXcd MassMatrix = HiggsMassMatrix(v, Temp);
+  return FirstDerivativeOfEigenvalues(MassMatrix,
+                                      HiggsMassMatrixDerivatives(v));
+}
+
+std::vector<MatrixXcd> Class_Potential_Origin::HiggsMassMatrixDerivatives(
+    const std::vector<double> &v) const
+{
+  std::vector<MatrixXd> DiffReal(NHiggs, MatrixXd::Zero(NHiggs, NHiggs));
+  for (const auto &Coupling : MassHiggs_L3)
+  {
+    const auto &[i, j, k] = Coupling.Index;
+    DiffReal[k](i, j) += Coupling.Value;
+  }
+  for (const auto &Coupling : MassHiggs_L4)
+  {
+    const auto &[i, j, k, l] = Coupling.Index;
+    DiffReal[k](i, j) += Coupling.Value * v[l];
+    DiffReal[l](i, j) += Coupling.Value * v[k];
+  }
+
+  std::vector<MatrixXcd> Diff;
+  Diff.reserve(NHiggs);
+  for (auto &DiffX : DiffReal)
+  {
+    for (std::size_t i{1}; i < NHiggs; ++i)
+    {
+      for (std::size_t j{0}; j < i; ++j)
+      {
+        DiffX(i, j) = DiffX(j, i);
+      }
+    }
+    Diff.push_back(DiffX);
+  }
+  return Diff;
+}
+
+std::vector<std::vector<double>>
+Class_Potential_Origin::GaugeMassesSquaredGradient(const std::vector<double> &v,
+                                                   const double &Temp) const
+{
+  MatrixXcd MassMatrix = GaugeMassMatrix(v, Temp);
+  return FirstDerivativeOfEigenvalues(MassMatrix,
+                                      GaugeMassMatrixDerivatives(v));
+}
+
+std::vector<MatrixXcd> Class_Potential_Origin::GaugeMassMatrixDerivatives(
+    const std::vector<double> &v) const
+{
+  std::vector<MatrixXd> DiffReal(NHiggs, MatrixXd::Zero(NGauge, NGauge));
+  for (const auto &Coupling : MassGauge_G2H2)
+  {
+    const auto &[a, b, i, j] = Coupling.Index;
+    DiffReal[i](a, b) += Coupling.Value * v[j];
+    DiffReal[j](a, b) += Coupling.Value * v[i];
+  }
+
+  std::vector<MatrixXcd> Diff;
+  Diff.reserve(NHiggs);
+  for (auto &DiffI : DiffReal)
+  {
+    for (std::size_t i{1}; i < NGauge; ++i)
+    {
+      for (std::size_t j{0}; j < i; ++j)
+      {
+        DiffI(i, j) = DiffI(j, i);
+      }
+    }
+    Diff.push_back(DiffI);
+  }
+  return Diff;
+}
+
+std::vector<std::vector<double>>
+Class_Potential_Origin::QuarkMassesSquaredGradient(
+    const std::vector<double> &v) const
+{
+  MatrixXcd MIJ        = QuarkMassMatrix(v);
+  MatrixXcd MassMatrix = MIJ.conjugate() * MIJ;
+
+  auto res =
+      FirstDerivativeOfEigenvalues(MassMatrix, QuarkMassMatrixDerivatives(MIJ));
+  for (std::size_t m = 1; m < res.size(); m++)
+  {
+    for (const auto &el : res[m])
+    {
+      if (std::isnan(el))
+      {
+        throw std::runtime_error(std::string("Nan found in ") + __func__ +
+                                 " at m = " + std::to_string(m - 1));
+      }
+    }
+  }
+  return res;
+}
+
+std::vector<std::vector<double>>
+Class_Potential_Origin::LeptonMassesSquaredGradient(
+    const std::vector<double> &v) const
+{
+  MatrixXcd MIJ        = LeptonMassMatrix(v);
+  MatrixXcd MassMatrix = MIJ.conjugate() * MIJ;
+
+  auto res = FirstDerivativeOfEigenvalues(MassMatrix,
+                                          LeptonMassMatrixDerivatives(MIJ));
+  for (std::size_t k = 1; k < res.size(); k++)
+  {
+    for (const auto &el : res[k])
+    {
+      if (std::isnan(el))
+      {
+        throw std::runtime_error(std::string("Nan found in ") + __func__ +
+                                 " at m = " + std::to_string(k - 1));
+      }
+    }
+  }
   return res;
 }
 
+std::vector<MatrixXcd>
+Class_Potential_Origin::QuarkMassMatrixDerivatives(const MatrixXcd &MIJ) const
+{
+  std::vector<MatrixXcd> Diff(NHiggs, MatrixXcd::Zero(NQuarks, NQuarks));
+  for (const auto &m : MassQuark_Fields)
+  {
+    Diff[m] = MassQuark_F2H1[m].conjugate() * MIJ +
+              MIJ.conjugate() * MassQuark_F2H1[m];
+  }
+  return Diff;
+}
+
+std::vector<MatrixXcd>
+Class_Potential_Origin::LeptonMassMatrixDerivatives(const MatrixXcd &MIJ) const
+{
+  std::vector<MatrixXcd> Diff(NHiggs, MatrixXcd::Zero(NLepton, NLepton));
+  for (const auto &k : MassLepton_Fields)
+  {
+    Diff[k] = MassLepton_F2H1[k].conjugate() * MIJ +
+              MIJ.conjugate() * MassLepton_F2H1[k];
+  }
+  return Diff;
+}
+
 double Class_Potential_Origin::VTree(const std::vector<double> &v,
                                      int diff,
                                      bool ForceExplicitCalculation) const
@@ -2839,51 +3808,26 @@ double Class_Potential_Origin::VTree(const std::vector<double> &v,
     }
   }
   res = 0;
+  if (!FlatCurvatureDone)
+  {
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
+  }
 
   if (diff == 0)
   {
-    for (std::size_t i = 0; i < NHiggs; i++)
-    {
-      if (v[i] != 0)
-      {
-        res += Curvature_Higgs_L1[i] * v[i];
-        for (std::size_t j = 0; j < NHiggs; j++)
-        {
-          if (v[j] != 0)
-          {
-            res += 0.5 * Curvature_Higgs_L2[i][j] * v[i] * v[j];
-            for (std::size_t k = 0; k < NHiggs; k++)
-            {
-              res +=
-                  1.0 / 6.0 * Curvature_Higgs_L3[i][j][k] * v[i] * v[j] * v[k];
-              for (std::size_t l = 0; l < NHiggs; l++)
-              {
-                res += 1.0 / 24.0 * Curvature_Higgs_L4[i][j][k][l] * v[i] *
-                       v[j] * v[k] * v[l];
-              }
-            }
-          }
-        }
-      }
-    }
+    res = EvaluatePacked(PackedHiggs_L1, v) +
+          EvaluatePacked(PackedHiggs_L2, v) +
+          EvaluatePacked(PackedHiggs_L3, v) + EvaluatePacked(PackedHiggs_L4, v);
   }
   else if (diff > 0 and static_cast<size_t>(diff) <= NHiggs)
   {
-    std::size_t i = diff - 1;
-    res           = Curvature_Higgs_L1[i];
-    for (std::size_t j = 0; j < NHiggs; j++)
-    {
-      res += Curvature_Higgs_L2[i][j] * v[j];
-      for (std::size_t k = 0; k < NHiggs; k++)
-      {
-        res += 0.5 * Curvature_Higgs_L3[i][j][k] * v[j] * v[k];
-        for (std::size_t l = 0; l < NHiggs; l++)
-        {
-          res +=
-              1.0 / 6.0 * Curvature_Higgs_L4[i][j][k][l] * v[j] * v[k] * v[l];
-        }
-      }
-    }
+    const std::size_t x0 = diff - 1;
+
+    res = EvaluatePackedDerivative(PackedHiggs_L1, v, x0) +
+          EvaluatePackedDerivative(PackedHiggs_L2, v, x0) +
+          EvaluatePackedDerivative(PackedHiggs_L3, v, x0) +
+          EvaluatePackedDerivative(PackedHiggs_L4, v, x0);
   }
 
   return res;
@@ -2902,44 +3846,27 @@ double Class_Potential_Origin::CounterTerm(const std::vector<double> &v,
   }
 
   res = 0;
+  if (!FlatCurvatureDone)
+  {
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
+  }
+
   if (diff == 0)
   {
-    for (std::size_t i = 0; i < NHiggs; i++)
-    {
-      res += Curvature_Higgs_CT_L1[i] * v[i];
-      for (std::size_t j = 0; j < NHiggs; j++)
-      {
-        res += 0.5 * Curvature_Higgs_CT_L2[i][j] * v[i] * v[j];
-        for (std::size_t k = 0; k < NHiggs; k++)
-        {
-          res +=
-              1.0 / 6.0 * Curvature_Higgs_CT_L3[i][j][k] * v[i] * v[j] * v[k];
-          for (std::size_t l = 0; l < NHiggs; l++)
-          {
-            res += 1.0 / 24.0 * Curvature_Higgs_CT_L4[i][j][k][l] * v[i] *
-                   v[j] * v[k] * v[l];
-          }
-        }
-      }
-    }
+    res = EvaluatePacked(PackedHiggs_CT_L1, v) +
+          EvaluatePacked(PackedHiggs_CT_L2, v) +
+          EvaluatePacked(PackedHiggs_CT_L3, v) +
+          EvaluatePacked(PackedHiggs_CT_L4, v);
   }
   else if (diff > 0 and static_cast<size_t>(diff) <= NHiggs)
   {
-    std::size_t i = diff - 1;
-    res           = Curvature_Higgs_CT_L1[i];
-    for (std::size_t j = 0; j < NHiggs; j++)
-    {
-      res += Curvature_Higgs_CT_L2[i][j] * v[j];
-      for (std::size_t k = 0; k < NHiggs; k++)
-      {
-        res += 0.5 * Curvature_Higgs_CT_L3[i][j][k] * v[j] * v[k];
-        for (std::size_t l = 0; l < NHiggs; l++)
-        {
-          res += 1.0 / 6.0 * Curvature_Higgs_CT_L4[i][j][k][l] * v[j] * v[k] *
-                 v[l];
-        }
-      }
-    }
+    const std::size_t x0 = diff - 1;
+
+    res = EvaluatePackedDerivative(PackedHiggs_CT_L1, v, x0) +
+          EvaluatePackedDerivative(PackedHiggs_CT_L2, v, x0) +
+          EvaluatePackedDerivative(PackedHiggs_CT_L3, v, x0) +
+          EvaluatePackedDerivative(PackedHiggs_CT_L4, v, x0);
   }
 
   return res;
@@ -2950,6 +3877,7 @@ double Class_Potential_Origin::VEff(const std::vector<double> &v,
                                     int diff,
                                     int Order) const
 {
+  BSMPT_PROFILE_COUNT(VEff);
   if (v.size() != nVEV and v.size() != NHiggs)
   {
     std::string ErrorString =
@@ -2960,38 +3888,375 @@ double Class_Potential_Origin::VEff(const std::vector<double> &v,
         std::to_string(NHiggs) + std::string(".");
     throw std::runtime_error(ErrorString);
   }
-  if (v.size() == nVEV and nVEV != NHiggs)
+  if (v.size() == nVEV and nVEV != NHiggs)
+  {
+    std::stringstream ss;
+    ss << __func__
+       << " is being called with a wrong sized vev configuration. It "
+          "has the dimension of "
+       << nVEV << " while it should have " << NHiggs
+       << ". For now this is transformed but please fix this to reduce "
+          "the runtime."
+       << std::endl;
+    Logger::Write(LoggingLevel::Default, ss.str());
+    std::vector<double> Transformedv;
+    Transformedv = MinimizeOrderVEV(v);
+    return VEff(Transformedv, Temp, diff);
+  }
+
+  double resOut = 0;
+  resOut        = VTree(v, diff);
+  if (Order != 0 and not UseTreeLevel)
+  {
+    resOut += CounterTerm(v, diff);
+    resOut += V1Loop(v, Temp, diff);
+  }
+  // for(std::size_t i=0;i<NHiggs;i++) resOut +=
+  // DebyeHiggs[i][i]*0.5*std::pow(v.at(i),2)*std::pow(Temp,2);
+  return resOut;
+}
+
+void Class_Potential_Origin::VEffBatch(const std::vector<double> &points,
+                                       double Temp,
+                                       std::vector<double> &out,
+                                       int Order) const
+{
+  if (NHiggs == 0 or points.size() % NHiggs != 0)
+  {
+    throw std::runtime_error(
+        std::string("You have called ") + __func__ + " with " +
+        std::to_string(points.size()) +
+        " field values which is not a multiple of NHiggs = " +
+        std::to_string(NHiggs) + ".");
+  }
+  if (!FlatCurvatureDone)
+  {
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
+  }
+
+  const std::size_t NPoints = points.size() / NHiggs;
+  out.resize(NPoints);
+  for (std::size_t Start = 0; Start < NPoints; Start += C_VEffBatchBlockSize)
+  {
+    const std::size_t Size = std::min(C_VEffBatchBlockSize, NPoints - Start);
+    // Structure of arrays, the column i holds v_i of all points in the block
+    const ArrayXXd Fields =
+        Map<const MatrixXd>(points.data() + Start * NHiggs, NHiggs, Size)
+            .transpose()
+            .array();
+    Map<ArrayXd>(out.data() + Start, Size) =
+        VEffBatchBlock(Fields, Temp, Order);
+  }
+}
+
+ArrayXd Class_Potential_Origin::VEffBatchBlock(const ArrayXXd &Fields,
+                                               double Temp,
+                                               int Order) const
+{
+  const Index NPoints = Fields.rows();
+  auto Point          = [&](Index p)
+  {
+    std::vector<double> v(NHiggs);
+    for (std::size_t i = 0; i < NHiggs; i++)
+      v[i] = Fields(p, i);
+    return v;
+  };
+
+  ArrayXd res(NPoints);
+  if (UseVTreeSimplified)
+  {
+    for (Index p = 0; p < NPoints; p++)
+      res(p) = VTreeSimplified(Point(p));
+  }
+  else
+  {
+    res = EvaluatePackedBatch(PackedHiggs_L1, Fields) +
+          EvaluatePackedBatch(PackedHiggs_L2, Fields) +
+          EvaluatePackedBatch(PackedHiggs_L3, Fields) +
+          EvaluatePackedBatch(PackedHiggs_L4, Fields);
+  }
+
+  if (Order == 0 or UseTreeLevel) return res;
+
+  if (UseVCounterSimplified)
+  {
+    for (Index p = 0; p < NPoints; p++)
+      res(p) += VCounterSimplified(Point(p));
+  }
+  else
+  {
+    res += EvaluatePackedBatch(PackedHiggs_CT_L1, Fields) +
+           EvaluatePackedBatch(PackedHiggs_CT_L2, Fields) +
+           EvaluatePackedBatch(PackedHiggs_CT_L3, Fields) +
+           EvaluatePackedBatch(PackedHiggs_CT_L4, Fields);
+  }
+
+  // Mass matrices of all points, the column i + N * j holds the entry (i,j)
+  ArrayXXd HiggsEntries(NPoints, NHiggs * NHiggs);
+  for (std::size_t j = 0; j < NHiggs; j++)
+  {
+    for (std::size_t i = 0; i < NHiggs; i++)
+    {
+      HiggsEntries.col(i + NHiggs * j).setConstant(MassHiggs_L2(i, j));
+    }
+  }
+  for (const auto &Coupling : MassHiggs_L3)
+  {
+    const auto &[i, j, k] = Coupling.Index;
+    HiggsEntries.col(i + NHiggs * j) += Coupling.Value * Fields.col(k);
+  }
+  for (const auto &Coupling : MassHiggs_L4)
+  {
+    const auto &[i, j, k, l] = Coupling.Index;
+    HiggsEntries.col(i + NHiggs * j) +=
+        Coupling.Value * Fields.col(k) * Fields.col(l);
+  }
+
+  ArrayXXd GaugeEntries = ArrayXXd::Zero(NPoints, NGauge * NGauge);
+  for (const auto &Coupling : MassGauge_G2H2)
+  {
+    const auto &[a, b, i, j] = Coupling.Index;
+    GaugeEntries.col(a + NGauge * b) +=
+        Coupling.Value * Fields.col(i) * Fields.col(j);
+  }
+
+  auto FermionEntries = [&](const MatrixXcd &F2,
+                            const std::vector<MatrixXcd> &F2H1,
+                            const std::vector<std::size_t> &FieldIndices)
+  {
+    const std::size_t Dim = F2.rows();
+    ArrayXXcd MIJ(NPoints, Dim * Dim);
+    for (std::size_t j = 0; j < Dim; j++)
+    {
+      for (std::size_t i = 0; i < Dim; i++)
+      {
+        MIJ.col(i + Dim * j).setConstant(F2(i, j));
+        for (const auto &k : FieldIndices)
+        {
+          if (F2H1[k](i, j) != 0.0)
+            MIJ.col(i + Dim * j) += F2H1[k](i, j) * Fields.col(k);
+        }
+      }
+    }
+    return MIJ;
+  };
+
+  // Only the order of the eigenvalues is changed by diagonalising the blocks
+  // that do not mix separately, which does not matter for the potential
+  Matrix<bool, Dynamic, Dynamic> HiggsPattern =
+      MassHiggs_L2.array() != 0 or MassDebyeHiggs.array() != 0;
+  for (const auto &Coupling : MassHiggs_L3)
+    HiggsPattern(Coupling.Index[0], Coupling.Index[1]) = true;
+  for (const auto &Coupling : MassHiggs_L4)
+    HiggsPattern(Coupling.Index[0], Coupling.Index[1]) = true;
+  Matrix<bool, Dynamic, Dynamic> GaugePattern = MassDebyeGauge.array() != 0;
+  for (const auto &Coupling : MassGauge_G2H2)
+    GaugePattern(Coupling.Index[0], Coupling.Index[1]) = true;
+  // pattern of M^* M for the fermion mass matrix M
+  auto FermionPattern = [](const MatrixXcd &F2,
+                           const std::vector<MatrixXcd> &F2H1)
+  {
+    MatrixXi Pattern = (F2.array() != 0.0).cast<int>();
+    for (const auto &Coupling : F2H1)
+    {
+      Pattern =
+          Pattern.cwiseMax((Coupling.array() != 0.0).cast<int>().matrix());
+    }
+    return Matrix<bool, Dynamic, Dynamic>((Pattern * Pattern).array() != 0);
+  };
+  const auto HiggsBlocks  = IndependentBlocks(HiggsPattern);
+  const auto GaugeBlocks  = IndependentBlocks(GaugePattern);
+  const auto QuarkBlocks  = IndependentBlocks(FermionPattern(MassQuark_F2,
+                                                             MassQuark_F2H1));
+  const auto LeptonBlocks = IndependentBlocks(
+      FermionPattern(MassLepton_F2, MassLepton_F2H1));
+
+  const double ZeroMass = std::pow(10, -5);
+  const auto HiggsMassesZeroTemp =
+      SymmetricEigenvaluesBatch(HiggsEntries, NHiggs, HiggsBlocks, ZeroMass);
+  const auto GaugeMassesZeroTemp =
+      SymmetricEigenvaluesBatch(GaugeEntries, NGauge, GaugeBlocks, ZeroMass);
+  const auto QuarkMasses = FermionEigenvaluesBatch(
+      FermionEntries(MassQuark_F2, MassQuark_F2H1, MassQuark_Fields),
+      NQuarks,
+      QuarkBlocks,
+      std::pow(10, -10));
+  const auto LeptonMasses = FermionEigenvaluesBatch(
+      FermionEntries(MassLepton_F2, MassLepton_F2H1, MassLepton_Fields),
+      NLepton,
+      LeptonBlocks,
+      std::pow(10, -10));
+
+  ArrayXXd HiggsMasses = HiggsMassesZeroTemp;
+  ArrayXXd GaugeMasses = GaugeMassesZeroTemp;
+  if (Temp != 0)
+  {
+    for (std::size_t j = 0; j < NHiggs; j++)
+    {
+      for (std::size_t i = 0; i <= j; i++)
+      {
+        HiggsEntries.col(i + NHiggs * j) +=
+            MassDebyeHiggs(i, j) * std::pow(Temp, 2);
+      }
+    }
+    for (std::size_t b = 0; b < NGauge; b++)
+    {
+      for (std::size_t a = 0; a <= b; a++)
+      {
+        GaugeEntries.col(a + NGauge * b) +=
+            MassDebyeGauge(a, b) * std::pow(Temp, 2);
+      }
+    }
+    HiggsMasses =
+        SymmetricEigenvaluesBatch(HiggsEntries, NHiggs, HiggsBlocks, ZeroMass);
+    GaugeMasses =
+        SymmetricEigenvaluesBatch(GaugeEntries, NGauge, GaugeBlocks, ZeroMass);
+  }
+
+  // boson() and fermion() for all eigenvalues of all points at once, summed
+  // over the eigenvalues of each point
+  auto CWTerms = [&](const ArrayXd &m2, double cb) -> ArrayXd
+  {
+    return (m2.abs() < C_threshold)
+        .select(0.0,
+                1.0 / (64 * M_PI * M_PI) * m2.square() *
+                    (m2.abs().log() - 2 * std::log(scale) - cb));
+  };
+  auto SumPerPoint = [&](const ArrayXd &V) -> ArrayXd
+  {
+    return Map<const ArrayXXd>(V.data(), NPoints, V.size() / NPoints)
+        .rowwise()
+        .sum();
+  };
+  auto BosonSum = [&](const ArrayXXd &Masses, double cb)
+  {
+    const Map<const ArrayXd> m2(Masses.data(), Masses.size());
+    ArrayXd V = CWTerms(m2, cb);
+    if (Temp != 0)
+    {
+      V += std::pow(Temp, 4) / (2 * std::pow(M_PI, 2)) *
+           ThermalFunctions::JbosonInterpolatedBatch(m2 / std::pow(Temp, 2));
+    }
+    return SumPerPoint(V);
+  };
+  auto FermionSum = [&](const ArrayXXd &Masses)
+  {
+    const Map<const ArrayXd> m2(Masses.data(), Masses.size());
+    ArrayXd V = CWTerms(m2, C_CWcbFermion);
+    if (Temp != 0)
+    {
+      V += std::pow(Temp, 4) / (2 * std::pow(M_PI, 2)) *
+           ThermalFunctions::JfermionInterpolatedBatch(m2 / std::pow(Temp, 2));
+    }
+    return SumPerPoint(V);
+  };
+
+  if (C_UseParwani)
+  {
+    res += BosonSum(HiggsMasses, C_CWcbHiggs);
+    res += BosonSum(GaugeMasses, C_CWcbGB);
+    res += 2 * BosonSum(GaugeMassesZeroTemp, C_CWcbGB);
+    res += -6 * FermionSum(QuarkMasses);
+    res += -2 * FermionSum(LeptonMasses);
+  }
+  else
   {
-    std::stringstream ss;
-    ss << __func__
-       << " is being called with a wrong sized vev configuration. It "
-          "has the dimension of "
-       << nVEV << " while it should have " << NHiggs
-       << ". For now this is transformed but please fix this to reduce "
-          "the runtime."
-       << std::endl;
-    Logger::Write(LoggingLevel::Default, ss.str());
-    std::vector<double> Transformedv;
-    Transformedv = MinimizeOrderVEV(v);
-    return VEff(Transformedv, Temp, diff);
+    res += BosonSum(HiggsMassesZeroTemp, C_CWcbHiggs);
+    res += 3 * BosonSum(GaugeMassesZeroTemp, C_CWcbGB);
+    res += -2.0 * NColour * FermionSum(QuarkMasses);
+    res += -2 * FermionSum(LeptonMasses);
+
+    auto Cubic = [](const ArrayXXd &Masses) -> ArrayXd
+    { return (Masses.max(0) * Masses.max(0).sqrt()).rowwise().sum(); };
+    const ArrayXd VDebye = Cubic(HiggsMasses) - Cubic(HiggsMassesZeroTemp) +
+                           Cubic(GaugeMasses) - Cubic(GaugeMassesZeroTemp);
+    res += -Temp / (12 * M_PI) * VDebye;
   }
 
-  double resOut = 0;
-  resOut        = VTree(v, diff);
-  if (Order != 0 and not UseTreeLevel)
+  return res;
+}
+
+double Class_Potential_Origin::V1Loop(const std::vector<double> &v,
+                                      double Temp,
+                                      MassSpectrumBuffers &Buffers) const
+{
+  double res = 0;
+
+  HiggsMassesSquared(Buffers.Higgs, v, Temp);
+  GaugeMassesSquared(Buffers.Gauge, v, Temp);
+  GaugeMassesSquared(Buffers.GaugeZeroTemp, v, 0);
+  QuarkMassesSquared(Buffers.Quark, v);
+  LeptonMassesSquared(Buffers.Lepton, v);
+  const auto &HiggsMassesVec         = Buffers.Higgs;
+  const auto &GaugeMassesVec         = Buffers.Gauge;
+  const auto &GaugeMassesZeroTempVec = Buffers.GaugeZeroTemp;
+  const auto &QuarkMassesVec         = Buffers.Quark;
+  const auto &LeptonMassesVec        = Buffers.Lepton;
+
+  if (C_UseParwani)
   {
-    resOut += CounterTerm(v, diff);
-    resOut += V1Loop(v, Temp, diff);
+    for (std::size_t k = 0; k < NHiggs; k++)
+      res += boson(HiggsMassesVec[k], Temp, C_CWcbHiggs, 0);
+    for (std::size_t k = 0; k < NGauge; k++)
+      res += boson(GaugeMassesVec[k], Temp, C_CWcbGB, 0);
+    for (std::size_t k = 0; k < NGauge; k++)
+      res += 2 * boson(GaugeMassesZeroTempVec[k], Temp, C_CWcbGB, 0);
+    for (std::size_t k = 0; k < NQuarks; k++)
+      res += -6 * fermion(QuarkMassesVec[k], Temp, 0);
+    for (std::size_t k = 0; k < NLepton; k++)
+      res += -2 * fermion(LeptonMassesVec[k], Temp, 0);
   }
-  // for(std::size_t i=0;i<NHiggs;i++) resOut +=
-  // DebyeHiggs[i][i]*0.5*std::pow(v.at(i),2)*std::pow(Temp,2);
-  return resOut;
+  else
+  {
+    HiggsMassesSquared(Buffers.HiggsZeroTemp, v, 0);
+    const auto &HiggsMassesZeroTempVec = Buffers.HiggsZeroTemp;
+    for (std::size_t k = 0; k < NHiggs; k++)
+    {
+      res += boson(HiggsMassesZeroTempVec[k], Temp, C_CWcbHiggs, 0);
+    }
+    for (std::size_t k = 0; k < NGauge; k++)
+    {
+      res += 3 * boson(GaugeMassesZeroTempVec[k], Temp, C_CWcbGB, 0);
+    }
+    double AddContQuark = 0;
+    for (std::size_t k = 0; k < NQuarks; k++)
+    {
+      AddContQuark += -2 * fermion(QuarkMassesVec[k], Temp, 0);
+    }
+    res += NColour * AddContQuark;
+    for (std::size_t k = 0; k < NLepton; k++)
+    {
+      res += -2 * fermion(LeptonMassesVec[k], Temp, 0);
+    }
+
+    double VDebye = 0;
+    for (std::size_t k = 0; k < NHiggs; k++)
+    {
+      if (HiggsMassesVec[k] > 0) VDebye += std::pow(HiggsMassesVec[k], 1.5);
+      if (HiggsMassesZeroTempVec[k] > 0)
+        VDebye += -std::pow(HiggsMassesZeroTempVec[k], 1.5);
+    }
+    for (std::size_t k = 0; k < NGauge; k++)
+    {
+      if (GaugeMassesVec[k] > 0) VDebye += std::pow(GaugeMassesVec[k], 1.5);
+      if (GaugeMassesZeroTempVec[k] > 0)
+        VDebye += -std::pow(GaugeMassesZeroTempVec[k], 1.5);
+    }
+
+    VDebye *= -Temp / (12 * M_PI);
+    res += VDebye;
+  }
+
+  return res;
 }
 
 double Class_Potential_Origin::V1Loop(const std::vector<double> &v,
                                       double Temp,
                                       int diff) const
 {
+  if (diff == 0) return V1Loop(v, Temp, ThreadMassSpectrumBuffers());
+
   double res = 0;
 
   /**
@@ -3006,62 +4271,7 @@ double Class_Potential_Origin::V1Loop(const std::vector<double> &v,
   QuarkMassesVec         = QuarkMassesSquared(v, diff);
   LeptonMassesVec        = LeptonMassesSquared(v, diff);
 
-  if (diff == 0)
-  {
-    if (C_UseParwani)
-    {
-      for (std::size_t k = 0; k < NHiggs; k++)
-        res += boson(HiggsMassesVec[k], Temp, C_CWcbHiggs, 0);
-      for (std::size_t k = 0; k < NGauge; k++)
-        res += boson(GaugeMassesVec[k], Temp, C_CWcbGB, 0);
-      for (std::size_t k = 0; k < NGauge; k++)
-        res += 2 * boson(GaugeMassesZeroTempVec[k], Temp, C_CWcbGB, 0);
-      for (std::size_t k = 0; k < NQuarks; k++)
-        res += -6 * fermion(QuarkMassesVec[k], Temp, 0);
-      for (std::size_t k = 0; k < NLepton; k++)
-        res += -2 * fermion(LeptonMassesVec[k], Temp, 0);
-    }
-    else
-    {
-      HiggsMassesZeroTempVec = HiggsMassesSquared(v, 0);
-      for (std::size_t k = 0; k < NHiggs; k++)
-      {
-        res += boson(HiggsMassesZeroTempVec[k], Temp, C_CWcbHiggs, 0);
-      }
-      for (std::size_t k = 0; k < NGauge; k++)
-      {
-        res += 3 * boson(GaugeMassesZeroTempVec[k], Temp, C_CWcbGB, 0);
-      }
-      double AddContQuark = 0;
-      for (std::size_t k = 0; k < NQuarks; k++)
-      {
-        AddContQuark += -2 * fermion(QuarkMassesVec[k], Temp, 0);
-      }
-      res += NColour * AddContQuark;
-      for (std::size_t k = 0; k < NLepton; k++)
-      {
-        res += -2 * fermion(LeptonMassesVec[k], Temp, 0);
-      }
-
-      double VDebye = 0;
-      for (std::size_t k = 0; k < NHiggs; k++)
-      {
-        if (HiggsMassesVec[k] > 0) VDebye += std::pow(HiggsMassesVec[k], 1.5);
-        if (HiggsMassesZeroTempVec[k] > 0)
-          VDebye += -std::pow(HiggsMassesZeroTempVec[k], 1.5);
-      }
-      for (std::size_t k = 0; k < NGauge; k++)
-      {
-        if (GaugeMassesVec[k] > 0) VDebye += std::pow(GaugeMassesVec[k], 1.5);
-        if (GaugeMassesZeroTempVec[k] > 0)
-          VDebye += -std::pow(GaugeMassesZeroTempVec[k], 1.5);
-      }
-
-      VDebye *= -Temp / (12 * M_PI);
-      res += VDebye;
-    }
-  }
-  else if (diff > 0 and static_cast<size_t>(diff) <= NHiggs)
+  if (diff > 0 and static_cast<size_t>(diff) <= NHiggs)
   {
     if (C_UseParwani)
     {
@@ -3220,8 +4430,274 @@ double Class_Potential_Origin::V1Loop(const std::vector<double> &v,
   return res;
 }
 
+std::vector<double>
+Class_Potential_Origin::VEffGradient(const std::vector<double> &v,
+                                     double Temp,
+                                     int Order) const
+{
+  BSMPT_PROFILE_COUNT(VEffGradient);
+  if (v.size() != nVEV and v.size() != NHiggs)
+  {
+    std::string ErrorString =
+        std::string("You have called ") + std::string(__func__) +
+        std::string(
+            " with an invalid vev configuration. Your vev is of dimension ") +
+        std::to_string(v.size()) + std::string(" and it should be ") +
+        std::to_string(NHiggs) + std::string(".");
+    throw std::runtime_error(ErrorString);
+  }
+  if (v.size() == nVEV and nVEV != NHiggs)
+  {
+    std::stringstream ss;
+    ss << __func__
+       << " is being called with a wrong sized vev configuration. It "
+          "has the dimension of "
+       << nVEV << " while it should have " << NHiggs
+       << ". For now this is transformed but please fix this to reduce "
+          "the runtime."
+       << std::endl;
+    Logger::Write(LoggingLevel::Default, ss.str());
+    return VEffGradient(MinimizeOrderVEV(v), Temp, Order);
+  }
+
+  std::vector<double> res(NHiggs);
+  for (std::size_t i = 0; i < NHiggs; i++)
+  {
+    res[i] = VTree(v, i + 1);
+  }
+  if (Order != 0 and not UseTreeLevel)
+  {
+    const auto Loop = V1LoopGradient(v, Temp);
+    for (std::size_t i = 0; i < NHiggs; i++)
+    {
+      res[i] += CounterTerm(v, i + 1) + Loop[i];
+    }
+  }
+  return res;
+}
+
+MatrixXd Class_Potential_Origin::VEffHessian(const std::vector<double> &v,
+                                             double Temp,
+                                             int Order) const
+{
+  if (v.size() != nVEV and v.size() != NHiggs)
+  {
+    std::string ErrorString =
+        std::string("You have called ") + std::string(__func__) +
+        std::string(
+            " with an invalid vev configuration. Your vev is of dimension ") +
+        std::to_string(v.size()) + std::string(" and it should be ") +
+        std::to_string(NHiggs) + std::string(".");
+    throw std::runtime_error(ErrorString);
+  }
+  if (v.size() == nVEV and nVEV != NHiggs)
+  {
+    std::stringstream ss;
+    ss << __func__
+       << " is being called with a wrong sized vev configuration. It "
+          "has the dimension of "
+       << nVEV << " while it should have " << NHiggs
+       << ". For now this is transformed but please fix this to reduce "
+          "the runtime."
+       << std::endl;
+    Logger::Write(LoggingLevel::Default, ss.str());
+    return VEffHessian(MinimizeOrderVEV(v), Temp, Order);
+  }
+
+  // The Higgs mass matrix without the Debye corrections is the Hessian of the
+  // tree-level potential
+  MatrixXd res = HiggsMassMatrix(v, 0);
+  if (Order != 0 and not UseTreeLevel)
+  {
+    res += HessianCT(v) + V1LoopHessian(v, Temp);
+  }
+  return res;
+}
+
+std::vector<double>
+Class_Potential_Origin::V1LoopGradient(const std::vector<double> &v,
+                                       double Temp) const
+{
+  std::vector<double> res(NHiggs, 0);
+
+  /**
+   * Every mass matrix is diagonalised once, index 0 holds the eigenvalues and
+   * index i the derivatives of the eigenvalues w.r.t. v_{i-1}
+   */
+  const auto HiggsMasses         = HiggsMassesSquaredGradient(v, Temp);
+  const auto GaugeMasses         = GaugeMassesSquaredGradient(v, Temp);
+  const auto GaugeMassesZeroTemp = GaugeMassesSquaredGradient(v, 0);
+  const auto QuarkMasses         = QuarkMassesSquaredGradient(v);
+  const auto LeptonMasses        = LeptonMassesSquaredGradient(v);
+
+  // The thermal functions only depend on the eigenvalues and are shared by
+  // all field directions
+  auto BosonDerivatives = [&](const std::vector<double> &Masses, double cb)
+  {
+    std::vector<double> dV(Masses.size());
+    for (std::size_t k = 0; k < Masses.size(); k++)
+      dV[k] = boson(Masses[k], Temp, cb, 1);
+    return dV;
+  };
+  auto FermionDerivatives = [&](const std::vector<double> &Masses)
+  {
+    std::vector<double> dV(Masses.size());
+    for (std::size_t k = 0; k < Masses.size(); k++)
+      dV[k] = fermion(Masses[k], Temp, 1);
+    return dV;
+  };
+  auto Contract = [](const std::vector<double> &MassDerivative,
+                     const std::vector<double> &dV)
+  {
+    double sum = 0;
+    for (std::size_t k = 0; k < dV.size(); k++)
+      sum += MassDerivative[k] * dV[k];
+    return sum;
+  };
+
+  const auto dVQuark  = FermionDerivatives(QuarkMasses[0]);
+  const auto dVLepton = FermionDerivatives(LeptonMasses[0]);
+
+  if (C_UseParwani)
+  {
+    const auto dVHiggs         = BosonDerivatives(HiggsMasses[0], C_CWcbHiggs);
+    const auto dVGauge         = BosonDerivatives(GaugeMasses[0], C_CWcbHiggs);
+    const auto dVGaugeZeroTemp = BosonDerivatives(GaugeMassesZeroTemp[0],
+                                                  C_CWcbHiggs);
+    for (std::size_t i = 0; i < NHiggs; i++)
+    {
+      res[i] += Contract(HiggsMasses[i + 1], dVHiggs);
+      res[i] += Contract(GaugeMasses[i + 1], dVGauge);
+      res[i] += 2 * Contract(GaugeMassesZeroTemp[i + 1], dVGaugeZeroTemp);
+      res[i] += -6 * Contract(QuarkMasses[i + 1], dVQuark);
+      res[i] += -2 * Contract(LeptonMasses[i + 1], dVLepton);
+    }
+  }
+  else
+  {
+    const auto HiggsMassesZeroTemp = HiggsMassesSquaredGradient(v, 0);
+    const auto dVHiggsZeroTemp =
+        BosonDerivatives(HiggsMassesZeroTemp[0], C_CWcbHiggs);
+    const auto dVGaugeZeroTemp =
+        BosonDerivatives(GaugeMassesZeroTemp[0], C_CWcbGB);
+
+    // Derivative of m^3 w.r.t. m^2 for the Debye (daisy) contribution
+    auto DebyeDerivatives = [](const std::vector<double> &Masses, double sign)
+    {
+      std::vector<double> dV(Masses.size(), 0);
+      for (std::size_t k = 0; k < Masses.size(); k++)
+      {
+        if (Masses[k] > 0) dV[k] = sign * 1.5 * std::pow(Masses[k], 0.5);
+      }
+      return dV;
+    };
+    const auto dDebyeHiggs = DebyeDerivatives(HiggsMasses[0], 1);
+    const auto dDebyeHiggsZeroTemp =
+        DebyeDerivatives(HiggsMassesZeroTemp[0], -1);
+    const auto dDebyeGauge = DebyeDerivatives(GaugeMasses[0], 1);
+    const auto dDebyeGaugeZeroTemp =
+        DebyeDerivatives(GaugeMassesZeroTemp[0], -1);
+
+    for (std::size_t i = 0; i < NHiggs; i++)
+    {
+      res[i] += Contract(HiggsMassesZeroTemp[i + 1], dVHiggsZeroTemp);
+      res[i] += 3 * Contract(GaugeMassesZeroTemp[i + 1], dVGaugeZeroTemp);
+      res[i] += -2.0 * NColour * Contract(QuarkMasses[i + 1], dVQuark);
+      res[i] += -2 * Contract(LeptonMasses[i + 1], dVLepton);
+
+      double VDebye = 0;
+      VDebye += Contract(HiggsMasses[i + 1], dDebyeHiggs);
+      VDebye += Contract(HiggsMassesZeroTemp[i + 1], dDebyeHiggsZeroTemp);
+      VDebye += Contract(GaugeMasses[i + 1], dDebyeGauge);
+      VDebye += Contract(GaugeMassesZeroTemp[i + 1], dDebyeGaugeZeroTemp);
+      VDebye *= -Temp / (12 * M_PI);
+      res[i] += VDebye;
+    }
+  }
+
+  return res;
+}
+
+MatrixXd Class_Potential_Origin::V1LoopHessian(const std::vector<double> &v,
+                                               double Temp) const
+{
+  MatrixXd res = MatrixXd::Zero(NHiggs, NHiggs);
+
+  const auto HiggsDiff = HiggsMassMatrixDerivatives(v);
+  const auto GaugeDiff = GaugeMassMatrixDerivatives(v);
+  const MatrixXcd QuarkMIJ  = QuarkMassMatrix(v);
+  const MatrixXcd LeptonMIJ = LeptonMassMatrix(v);
+
+  // Adds the Hessian of sum_k f(m_k^2) for the Higgs and gauge boson mass
+  // matrices, dF being the derivative of f w.r.t. m^2
+  auto AddHiggs =
+      [&](double MatrixTemp, const std::function<double(double)> &dF)
+  {
+    const MatrixXcd Weights =
+        AddSpectralHessian(res, HiggsMassMatrix(v, MatrixTemp), HiggsDiff, dF);
+    AddPackedSecondDerivatives(res, Weights, MassHiggs_L4);
+  };
+  auto AddGauge =
+      [&](double MatrixTemp, const std::function<double(double)> &dF)
+  {
+    const MatrixXcd Weights =
+        AddSpectralHessian(res, GaugeMassMatrix(v, MatrixTemp), GaugeDiff, dF);
+    AddPackedSecondDerivatives(res, Weights, MassGauge_G2H2);
+  };
+  auto AddFermions = [&](double Factor)
+  {
+    const MatrixXcd QuarkWeights = AddSpectralHessian(
+        res,
+        QuarkMIJ.conjugate() * QuarkMIJ,
+        QuarkMassMatrixDerivatives(QuarkMIJ),
+        [&](double m2) { return Factor * fermion(m2, Temp, 1); });
+    AddYukawaSecondDerivatives(
+        res, QuarkWeights, MassQuark_F2H1, MassQuark_Fields);
+    const MatrixXcd LeptonWeights = AddSpectralHessian(
+        res,
+        LeptonMIJ.conjugate() * LeptonMIJ,
+        LeptonMassMatrixDerivatives(LeptonMIJ),
+        [&](double m2) { return -2 * fermion(m2, Temp, 1); });
+    AddYukawaSecondDerivatives(
+        res, LeptonWeights, MassLepton_F2H1, MassLepton_Fields);
+  };
+
+  if (C_UseParwani)
+  {
+    AddHiggs(Temp,
+             [&](double m2) { return boson(m2, Temp, C_CWcbHiggs, 1); });
+    AddGauge(Temp, [&](double m2) { return boson(m2, Temp, C_CWcbGB, 1); });
+    AddGauge(0, [&](double m2) { return 2 * boson(m2, Temp, C_CWcbGB, 1); });
+    AddFermions(-6);
+  }
+  else
+  {
+    // Derivative of the Debye (daisy) term -T/(12 pi) (m^2)^(3/2) w.r.t. m^2
+    auto dDebye = [&](double m2)
+    {
+      if (m2 <= 0) return 0.0;
+      return -Temp / (12 * M_PI) * 1.5 * std::sqrt(m2);
+    };
+    AddHiggs(0,
+             [&](double m2)
+             { return boson(m2, Temp, C_CWcbHiggs, 1) - dDebye(m2); });
+    AddGauge(0,
+             [&](double m2)
+             { return 3 * boson(m2, Temp, C_CWcbGB, 1) - dDebye(m2); });
+    if (Temp != 0)
+    {
+      AddHiggs(Temp, dDebye);
+      AddGauge(Temp, dDebye);
+    }
+    AddFermions(-2.0 * NColour);
+  }
+
+  return res;
+}
+
 void Class_Potential_Origin::CalculateDebye(bool forceCalculation)
 {
+  BSMPT_PROFILE_COUNT(CalculateDebye);
   if (!SetCurvatureDone) SetCurvatureArrays();
 
   bool Calculate = forceCalculation or not CalculateDebyeSimplified();
@@ -3287,6 +4763,8 @@ void Class_Potential_Origin::CalculateDebye(bool forceCalculation)
       }
     }
   }
+  MassDebyeHiggs = SymmetricFromUpper(DebyeHiggs);
+  InvalidateMassCache();
 }
 
 void Class_Potential_Origin::CalculateDebyeGauge()
@@ -3298,7 +4776,12 @@ void Class_Potential_Origin::CalculateDebyeGauge()
   }
 
   bool Done = CalculateDebyeGaugeSimplified();
-  if (Done) return;
+  if (Done)
+  {
+    MassDebyeGauge = SymmetricFromUpper(DebyeGauge);
+    InvalidateMassCache();
+    return;
+  }
 
   std::size_t nGaugeHiggs = 0;
 
@@ -3327,6 +4810,84 @@ void Class_Potential_Origin::CalculateDebyeGauge()
       if (std::abs(DebyeGauge[i][j]) <= 1e-5) DebyeGauge[i][j] = 0;
     }
   }
+  MassDebyeGauge = SymmetricFromUpper(DebyeGauge);
+  InvalidateMassCache();
+}
+
+void Class_Potential_Origin::FlattenCurvatureArrays()
+{
+  PackPotential(Curvature_Higgs_L1,
+                Curvature_Higgs_L2,
+                Curvature_Higgs_L3,
+                Curvature_Higgs_L4,
+                PackedHiggs_L1,
+                PackedHiggs_L2,
+                PackedHiggs_L3,
+                PackedHiggs_L4);
+  PackPotential(Curvature_Higgs_CT_L1,
+                Curvature_Higgs_CT_L2,
+                Curvature_Higgs_CT_L3,
+                Curvature_Higgs_CT_L4,
+                PackedHiggs_CT_L1,
+                PackedHiggs_CT_L2,
+                PackedHiggs_CT_L3,
+                PackedHiggs_CT_L4);
+
+  // The mass matrices are symmetric, so only i <= j (a <= b) is stored. The
+  // symmetric pair k, l is packed into k <= l.
+  CouplingMap<3> MapL3;
+  CouplingMap<4> MapL4, MapG2H2;
+  for (std::size_t i = 0; i < NHiggs; i++)
+  {
+    for (std::size_t j = i; j < NHiggs; j++)
+    {
+      for (std::size_t k = 0; k < NHiggs; k++)
+      {
+        MapL3[{i, j, k}] += Curvature_Higgs_L3[i][j][k];
+        for (std::size_t l = 0; l < NHiggs; l++)
+        {
+          MapL4[{i, j, std::min(k, l), std::max(k, l)}] +=
+              0.5 * Curvature_Higgs_L4[i][j][k][l];
+        }
+      }
+    }
+  }
+  for (std::size_t a = 0; a < NGauge; a++)
+  {
+    for (std::size_t b = a; b < NGauge; b++)
+    {
+      for (std::size_t i = 0; i < NHiggs; i++)
+      {
+        for (std::size_t j = 0; j < NHiggs; j++)
+        {
+          MapG2H2[{a, b, std::min(i, j), std::max(i, j)}] +=
+              0.5 * Curvature_Gauge_G2H2[a][b][i][j];
+        }
+      }
+    }
+  }
+  MassHiggs_L2   = SymmetricFromUpper(Curvature_Higgs_L2);
+  MassHiggs_L3   = ToPacked(MapL3);
+  MassHiggs_L4   = ToPacked(MapL4);
+  MassGauge_G2H2 = ToPacked(MapG2H2);
+  MassDebyeHiggs = SymmetricFromUpper(DebyeHiggs);
+  MassDebyeGauge = SymmetricFromUpper(DebyeGauge);
+
+  FlattenYukawa(Curvature_Quark_F2,
+                Curvature_Quark_F2H1,
+                NHiggs,
+                MassQuark_F2,
+                MassQuark_F2H1,
+                MassQuark_Fields);
+  FlattenYukawa(Curvature_Lepton_F2,
+                Curvature_Lepton_F2H1,
+                NHiggs,
+                MassLepton_F2,
+                MassLepton_F2H1,
+                MassLepton_Fields);
+
+  FlatCurvatureDone = true;
+  InvalidateMassCache();
 }
 
 void Class_Potential_Origin::initVectors()
@@ -3472,10 +5033,12 @@ void Class_Potential_Origin::sym4Dim(
 void Class_Potential_Origin::resetbools()
 {
   SetCurvatureDone          = false;
+  FlatCurvatureDone         = false;
   CalcCouplingsdone         = false;
   CalculatedTripleCopulings = false;
   parStored.clear();
   parCTStored.clear();
+  InvalidateMassCache();
 }
 
 bool Class_Potential_Origin::CheckNLOVEV(const std::vector<double> &v) const
@@ -3606,9 +5169,12 @@ Class_Potential_Origin::initModel(const std::vector<double> &par)
   std::vector<double> parCT(nParCT);
   resetbools();
   set_gen(par);
+  if (!SetCurvatureDone) SetCurvatureArrays();
+  FlattenCurvatureArrays();
   CalculatePhysicalCouplings();
   parCT = calc_CT();
   set_CT_Pot_Par(parCT);
+  FlattenCurvatureArrays();
   CalculateDebye();
   CalculateDebyeGauge();
 
@@ -3623,6 +5189,7 @@ std::vector<double> Class_Potential_Origin::resetScale(const double &newScale)
   scale      = newScale;
   auto parCT = calc_CT();
   set_CT_Pot_Par(parCT);
+  FlattenCurvatureArrays();
 
   parCTStored = parCT;
 
@@ -3665,21 +5232,14 @@ Class_Potential_Origin::QuarkMassMatrix(const std::vector<double> &v) const
     retmes += " is called before SetCurvatureArrays() is called. \n";
     throw std::runtime_error(retmes);
   }
-
-  MIJ = MatrixXcd::Zero(NQuarks, NQuarks);
-
-  for (std::size_t i = 0; i < NQuarks; i++)
+  if (!FlatCurvatureDone)
   {
-    for (std::size_t j = 0; j < NQuarks; j++)
-    {
-      MIJ(i, j) = Curvature_Quark_F2[i][j];
-      for (std::size_t k = 0; k < NHiggs; k++)
-      {
-        MIJ(i, j) += Curvature_Quark_F2H1[i][j][k] * v[k];
-      }
-    }
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
   }
 
+  FillQuarkMassMatrix(MIJ, v);
+
   return MIJ;
 }
 
@@ -3741,19 +5301,14 @@ Class_Potential_Origin::LeptonMassMatrix(const std::vector<double> &v) const
     retmes += " is called before SetCurvatureArrays();\n";
     throw std::runtime_error(retmes);
   }
-
-  for (std::size_t i = 0; i < NLepton; i++)
+  if (!FlatCurvatureDone)
   {
-    for (std::size_t j = 0; j < NLepton; j++)
-    {
-      res(i, j) = Curvature_Lepton_F2[i][j];
-      for (std::size_t k = 0; k < NHiggs; k++)
-      {
-        res(i, j) += Curvature_Lepton_F2H1[i][j][k] * v[k];
-      }
-    }
+    throw std::runtime_error(std::string(__func__) +
+                             " was called before FlattenCurvatureArrays().");
   }
 
+  FillLeptonMassMatrix(res, v);
+
   return res;
 }
 
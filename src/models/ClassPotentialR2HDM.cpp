@@ -629,6 +629,11 @@ void Class_Potential_R2HDM::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_Potential_R2HDM::clone() const
+{
+  return std::make_unique<Class_Potential_R2HDM>(*this);
+}
+
 /**
  * Calculates the counterterms in the 2HDM
  */
@@ -226,6 +226,11 @@ void Class_SM::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_SM::clone() const
+{
+  return std::make_unique<Class_SM>(*this);
+}
+
 std::vector<double> Class_SM::calc_CT() const
 {
   std::vector<double> parCT;
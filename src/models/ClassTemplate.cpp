@@ -230,6 +230,11 @@ void Class_Template::write() const
   Logger::Write(LoggingLevel::Default, ss.str());
 }
 
+std::unique_ptr<Class_Potential_Origin> Class_Template::clone() const
+{
+  return std::make_unique<Class_Template>(*this);
+}
+
 /**
  * Calculates the counterterms. Here you need to work out the scheme and
  * implement the formulas.
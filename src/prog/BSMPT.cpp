@@ -16,12 +16,15 @@
 #include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Potential_Origin
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ParallelLineProcessor.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for copy, max
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>   // for shared_ptr, __shared_...
+#include <sstream>
 #include <stdlib.h> // for atoi, EXIT_FAILURE
 #include <string>   // for string, operator<<
 #include <utility>  // for pair
@@ -41,8 +44,11 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
   bool UseMultithreading{true};
+  int ThreadPoolSize{0};
+  int NumberOfThreads{1};
 
   CLIOptions(const BSMPT::parser &argparser);
   bool good() const;
@@ -52,6 +58,24 @@ BSMPT::parser prepare_parser();
 
 std::vector<std::string> convert_input(int argc, char *argv[]);
 
+/**
+ * @brief CalculatePoint calculates the EWPT for a single parameter point
+ * @param model model instance used for this point
+ * @param linecounter line number of the parameter point
+ * @param linestr line of the input file
+ * @param args command line options
+ * @param UseMultithreading enables multithreading in the minimizers
+ * @param PrintErrorLines also prints points without a valid EWPT
+ * @return the line for the output file, empty if nothing is printed
+ */
+std::string CalculatePoint(
+    const std::shared_ptr<BSMPT::Class_Potential_Origin> &model,
+    int linecounter,
+    const std::string &linestr,
+    const CLIOptions &args,
+    bool UseMultithreading,
+    bool PrintErrorLines);
+
 int main(int argc, char *argv[])
 try
 {
@@ -71,7 +95,8 @@ try
     return EXIT_FAILURE;
   }
 
-  int linecounter = 1;
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   std::ifstream infile(args.InputFile);
   if (!infile.good())
   {
@@ -87,142 +112,48 @@ try
                   "Can not create file " + args.OutputFile);
     return EXIT_FAILURE;
   }
-  std::string linestr;
+  std::string legend;
+  if (not getline(infile, legend))
+  {
+    outfile.close();
+    return EXIT_SUCCESS;
+  }
   std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
       ModelID::FChoose(args.Model, SMConstants);
-  while (getline(infile, linestr))
-  {
-    if (linecounter > args.LastLine) break;
+  outfile << legend << sep << modelPointer->addLegendCT() << sep
+          << modelPointer->addLegendTemp() << std::endl;
 
-    if (linecounter == 1)
-    {
-      outfile << linestr << sep << modelPointer->addLegendCT() << sep
-              << modelPointer->addLegendTemp() << std::endl;
+  const auto NumberOfThreads = GetNumberOfThreads(args.NumberOfThreads);
+  // the minimizers of all points share the threads of the global pool
+  const bool UseMultithreading = args.UseMultithreading;
 
-      modelPointer->setUseIndexCol(linestr);
-    }
-    if (linecounter >= args.FirstLine and linecounter <= args.LastLine and
-        linecounter != 1)
+  // every worker thread calculates its points with its own model instance
+  auto CreateProcessor =
+      [&]() -> std::function<std::string(int, const std::string &)>
+  {
+    std::shared_ptr<BSMPT::Class_Potential_Origin> model =
+        ModelID::FChoose(args.Model, SMConstants);
+    model->setUseIndexCol(legend);
+    return [&, model](int linecounter, const std::string &linestr)
     {
-      if (args.TerminalOutput)
-      {
-        Logger::Write(LoggingLevel::ProgDetailed,
-                      "Currently at line " + std::to_string(linecounter));
-      }
-      std::pair<std::vector<double>, std::vector<double>> parameters =
-          modelPointer->initModel(linestr);
-      if (args.FirstLine == args.LastLine)
-      {
-        modelPointer->write();
-      }
+      return CalculatePoint(model,
+                            linecounter,
+                            linestr,
+                            args,
+                            UseMultithreading,
+                            PrintErrorLines);
+    };
+  };
+
+  ProcessLinesParallel<std::string>(
+      infile,
+      2,
+      args.FirstLine,
+      args.LastLine,
+      NumberOfThreads,
+      CreateProcessor,
+      [&](int, std::string &&result) { outfile << result; });
 
-      auto EWPT = Minimizer::PTFinder_gen_all(
-          modelPointer, 0, 300, args.WhichMinimizer, args.UseMultithreading);
-      std::vector<double> vevsymmetricSolution, checksym, startpoint;
-      for (const auto &el : EWPT.EWMinimum)
-        startpoint.push_back(0.5 * el);
-      auto VEVsym = Minimizer::Minimize_gen_all(modelPointer,
-                                                EWPT.Tc + 1,
-                                                checksym,
-                                                startpoint,
-                                                args.WhichMinimizer,
-                                                args.UseMultithreading);
-
-      if (args.FirstLine == args.LastLine)
-      {
-        auto dimensionnames = modelPointer->addLegendTemp();
-        Logger::Write(
-            LoggingLevel::Default,
-            "Success ? " + std::to_string(static_cast<int>(EWPT.StatusFlag)) +
-                sep + " (1 = Yes , -1 = No, v/T reached a value below " +
-                std::to_string(C_PT) + " during the calculation)");
-        if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
-        {
-          Logger::Write(LoggingLevel::Default,
-                        dimensionnames.at(1) + " = " + std::to_string(EWPT.vc) +
-                            " GeV");
-          Logger::Write(LoggingLevel::Default,
-                        dimensionnames.at(0) + " = " + std::to_string(EWPT.Tc) +
-                            " GeV");
-          Logger::Write(LoggingLevel::Default,
-                        "xi_c = " + dimensionnames.at(2) + " = " +
-                            std::to_string(EWPT.vc / EWPT.Tc));
-          for (std::size_t i = 0; i < modelPointer->get_nVEV(); i++)
-          {
-            Logger::Write(LoggingLevel::Default,
-                          dimensionnames.at(i + 3) + " = " +
-                              std::to_string(EWPT.EWMinimum.at(i)) + " GeV");
-          }
-          Logger::Write(LoggingLevel::Default, "Symmetric VEV config");
-          for (std::size_t i = 0; i < modelPointer->get_nVEV(); i++)
-          {
-            Logger::Write(LoggingLevel::Default,
-                          dimensionnames.at(i + 3) + " = " +
-                              std::to_string(VEVsym.at(i)) + " GeV");
-          }
-        }
-        else if (EWPT.StatusFlag ==
-                 Minimizer::MinimizerStatus::NOTVANISHINGATFINALTEMP)
-        {
-          Logger::Write(
-              LoggingLevel::Default,
-              dimensionnames.at(1) +
-                  " != 0 GeV at T = 300 GeV. No SFOEWPT is possible.");
-        }
-        else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::NLOVEVZEROORINF)
-        {
-          Logger::Write(LoggingLevel::Default,
-                        dimensionnames.at(1) + " = 0 / > 255 GeV at T = 0 GeV. "
-                                               "The point is not NLO stable.");
-        }
-        else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::NOTNLOSTABLE)
-        {
-          Logger::Write(
-              LoggingLevel::Default,
-              dimensionnames.at(1) +
-                  " != vEW GeV at T = 0 GeV. The point is not NLO stable.");
-        }
-        else if (EWPT.StatusFlag ==
-                 Minimizer::MinimizerStatus::NUMERICALLYUNSTABLE)
-        {
-          Logger::Write(LoggingLevel::Default,
-                        "The point is numerically unstable.");
-        }
-        else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::BELOWTHRESHOLD)
-        {
-          Logger::Write(LoggingLevel::Default,
-                        dimensionnames.at(1) + " < " + std::to_string(C_PT) +
-                            " found.");
-        }
-      }
-      if (PrintErrorLines)
-      {
-        outfile << linestr;
-        outfile << sep << parameters.second;
-        outfile << sep << EWPT.Tc << sep << EWPT.vc;
-        if (EWPT.vc > C_PT * EWPT.Tc and
-            EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
-          outfile << sep << EWPT.vc / EWPT.Tc;
-        else
-          outfile << sep << static_cast<int>(EWPT.StatusFlag);
-        outfile << sep << EWPT.EWMinimum;
-        outfile << std::endl;
-      }
-      else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
-      {
-        if (C_PT * EWPT.Tc < EWPT.vc)
-        {
-          outfile << linestr << sep << parameters.second;
-          outfile << sep << EWPT.Tc << sep << EWPT.vc;
-          outfile << sep << EWPT.vc / EWPT.Tc;
-          outfile << sep << EWPT.EWMinimum;
-          outfile << std::endl;
-        }
-      }
-    }
-    linecounter++;
-    if (infile.eof()) break;
-  }
   outfile.close();
   return EXIT_SUCCESS;
 }
@@ -236,6 +167,133 @@ catch (exception &e)
   return EXIT_FAILURE;
 }
 
+std::string CalculatePoint(
+    const std::shared_ptr<BSMPT::Class_Potential_Origin> &model,
+    int linecounter,
+    const std::string &linestr,
+    const CLIOptions &args,
+    bool UseMultithreading,
+    bool PrintErrorLines)
+{
+  std::stringstream output;
+  if (args.TerminalOutput)
+  {
+    Logger::Write(LoggingLevel::ProgDetailed,
+                  "Currently at line " + std::to_string(linecounter));
+  }
+  std::pair<std::vector<double>, std::vector<double>> parameters =
+      model->initModel(linestr);
+  if (args.FirstLine == args.LastLine)
+  {
+    model->write();
+  }
+
+  auto EWPT = Minimizer::PTFinder_gen_all(
+      model, 0, 300, args.WhichMinimizer, UseMultithreading);
+  std::vector<double> vevsymmetricSolution, checksym, startpoint;
+  for (const auto &el : EWPT.EWMinimum)
+    startpoint.push_back(0.5 * el);
+  auto VEVsym = Minimizer::Minimize_gen_all(model,
+                                            EWPT.Tc + 1,
+                                            checksym,
+                                            startpoint,
+                                            args.WhichMinimizer,
+                                            UseMultithreading);
+
+  if (args.FirstLine == args.LastLine)
+  {
+    auto dimensionnames = model->addLegendTemp();
+    Logger::Write(
+        LoggingLevel::Default,
+        "Success ? " + std::to_string(static_cast<int>(EWPT.StatusFlag)) +
+            sep + " (1 = Yes , -1 = No, v/T reached a value below " +
+            std::to_string(C_PT) + " during the calculation)");
+    if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
+    {
+      Logger::Write(LoggingLevel::Default,
+                    dimensionnames.at(1) + " = " + std::to_string(EWPT.vc) +
+                        " GeV");
+      Logger::Write(LoggingLevel::Default,
+                    dimensionnames.at(0) + " = " + std::to_string(EWPT.Tc) +
+                        " GeV");
+      Logger::Write(LoggingLevel::Default,
+                    "xi_c = " + dimensionnames.at(2) + " = " +
+                        std::to_string(EWPT.vc / EWPT.Tc));
+      for (std::size_t i = 0; i < model->get_nVEV(); i++)
+      {
+        Logger::Write(LoggingLevel::Default,
+                      dimensionnames.at(i + 3) + " = " +
+                          std::to_string(EWPT.EWMinimum.at(i)) + " GeV");
+      }
+      Logger::Write(LoggingLevel::Default, "Symmetric VEV config");
+      for (std::size_t i = 0; i < model->get_nVEV(); i++)
+      {
+        Logger::Write(LoggingLevel::Default,
+                      dimensionnames.at(i + 3) + " = " +
+                          std::to_string(VEVsym.at(i)) + " GeV");
+      }
+    }
+    else if (EWPT.StatusFlag ==
+             Minimizer::MinimizerStatus::NOTVANISHINGATFINALTEMP)
+    {
+      Logger::Write(
+          LoggingLevel::Default,
+          dimensionnames.at(1) +
+              " != 0 GeV at T = 300 GeV. No SFOEWPT is possible.");
+    }
+    else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::NLOVEVZEROORINF)
+    {
+      Logger::Write(LoggingLevel::Default,
+                    dimensionnames.at(1) + " = 0 / > 255 GeV at T = 0 GeV. "
+                                           "The point is not NLO stable.");
+    }
+    else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::NOTNLOSTABLE)
+    {
+      Logger::Write(
+          LoggingLevel::Default,
+          dimensionnames.at(1) +
+              " != vEW GeV at T = 0 GeV. The point is not NLO stable.");
+    }
+    else if (EWPT.StatusFlag ==
+             Minimizer::MinimizerStatus::NUMERICALLYUNSTABLE)
+    {
+      Logger::Write(LoggingLevel::Default,
+                    "The point is numerically unstable.");
+    }
+    else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::BELOWTHRESHOLD)
+    {
+      Logger::Write(LoggingLevel::Default,
+                    dimensionnames.at(1) + " < " + std::to_string(C_PT) +
+                        " found.");
+    }
+  }
+  if (PrintErrorLines)
+  {
+    output << linestr;
+    output << sep << parameters.second;
+    output << sep << EWPT.Tc << sep << EWPT.vc;
+    if (EWPT.vc > C_PT * EWPT.Tc and
+        EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
+      output << sep << EWPT.vc / EWPT.Tc;
+    else
+      output << sep << static_cast<int>(EWPT.StatusFlag);
+    output << sep << EWPT.EWMinimum;
+    output << std::endl;
+  }
+  else if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
+  {
+    if (C_PT * EWPT.Tc < EWPT.vc)
+    {
+      output << linestr << sep << parameters.second;
+      output << sep << EWPT.Tc << sep << EWPT.vc;
+      output << sep << EWPT.vc / EWPT.Tc;
+      output << sep << EWPT.EWMinimum;
+      output << std::endl;
+    }
+  }
+  return output.str();
+}
+
 CLIOptions::CLIOptions(const BSMPT::parser &argparser)
 {
   argparser.check_required_parameters();
@@ -277,6 +335,14 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
+  try
+  {
+    UseGSLGradient = argparser.get_value<bool>("useGSLGradient");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
   try
   {
     UseMultithreading = argparser.get_value<bool>("useMultithreading");
@@ -285,7 +351,24 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
-  WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+  try
+  {
+    ThreadPoolSize = argparser.get_value<int>("threadPoolSize");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
+  try
+  {
+    NumberOfThreads = argparser.get_value<int>("threads");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
+  WhichMinimizer = Minimizer::CalcWhichMinimizer(
+      UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
 }
 
 bool CLIOptions::good() const
@@ -352,6 +435,12 @@ BSMPT::parser prepare_parser()
       "y/n Turns on additional information in the terminal during "
       "the calculation.",
       false);
+  argparser.add_argument(
+      "threads",
+      "Number of parameter points calculated in parallel, 0 uses all cores. "
+      "Default is 1. At most threadPoolSize points are calculated at the "
+      "same time.",
+      false);
 
   std::stringstream ss;
   ss << "BSMPT calculates the strength of the electroweak phase transition"
@@ -14,12 +14,16 @@
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/transition_tracer/transition_tracer.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ParallelLineProcessor.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/parser.h>
 #include <BSMPT/utility/utility.h>
 #include <Eigen/Dense>
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <stdlib.h> // for atoi, EXIT_FAILURE
 #include <string>   // for string, operator<<
 #include <utility>  // for pair
@@ -39,8 +43,11 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
   bool UseMultithreading{false};
+  int ThreadPoolSize{0};
+  int NumberOfThreads{1};
   int UseMultiStepPTMode{-1};
   int CheckEWSymmetryRestoration{1};
   double perc_prbl{.71};
@@ -56,6 +63,41 @@ BSMPT::parser prepare_parser();
 
 std::vector<std::string> convert_input(int argc, char *argv[]);
 
+/**
+ * @brief Output of a single parameter point
+ */
+struct PointResult
+{
+  /**
+   * @brief row_stream output row without the transition history
+   */
+  std::stringstream row_stream;
+  /**
+   * @brief transition_history transition history of the point
+   */
+  std::string transition_history;
+  /**
+   * @brief legend legend of the transition tracer output
+   */
+  std::vector<std::string> legend;
+};
+
+/**
+ * @brief CalculatePoint runs the transition tracer for a single parameter point
+ * @param modelPointer model instance used for this point
+ * @param linecounter line number of the parameter point
+ * @param linestr line of the input file
+ * @param args command line options
+ * @param UseMultithreading enables multithreading in the minimizers
+ * @return output of the parameter point
+ */
+PointResult CalculatePoint(
+    const std::shared_ptr<BSMPT::Class_Potential_Origin> &modelPointer,
+    int linecounter,
+    const std::string &linestr,
+    const CLIOptions &args,
+    bool UseMultithreading);
+
 int main(int argc, char *argv[])
 try
 {
@@ -68,6 +110,8 @@ try
     return EXIT_FAILURE;
   }
 
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   std::ifstream infile(args.inputfile);
   if (!infile.good())
   {
@@ -83,178 +127,92 @@ try
 
   Logger::Write(LoggingLevel::ProgDetailed, "Created modelpointer ");
 
-  std::string linestr, linestr_store;
-  int linecounter   = 1;
-  std::size_t count = 0;
-  int num_points    = args.lastline - args.firstline + 1;
+  std::string linestr_store;
+  if (not getline(infile, linestr_store)) return EXIT_SUCCESS;
+  modelPointer->setUseIndexCol(linestr_store);
+
+  const auto NumberOfThreads = GetNumberOfThreads(args.NumberOfThreads);
+  // the minimizers of all points share the threads of the global pool
+  const bool UseMultithreading = args.UseMultithreading;
+
+  // every worker thread calculates its points with its own model instance
+  auto CreateProcessor =
+      [&]() -> std::function<PointResult(int, const std::string &)>
+  {
+    std::shared_ptr<BSMPT::Class_Potential_Origin> model =
+        ModelID::FChoose(args.Model, SMConstants);
+    model->setUseIndexCol(linestr_store);
+    return [&, model](int linecounter, const std::string &linestr)
+    {
+      return CalculatePoint(
+          model, linecounter, linestr, args, UseMultithreading);
+    };
+  };
 
   // output contents storage
-  std::vector<std::stringstream> output_contents;
-  output_contents.resize(num_points); // reserve one row per point
+  std::vector<std::string> output_contents;
   std::vector<std::string> transition_history;
   std::vector<std::string> legend;
+  std::ofstream outfile;
+  int tab_count_legend = 1;
 
-  while (getline(infile, linestr))
-  {
-    if (linecounter == 1) linestr_store = linestr;
+  auto CountColumns = [](const std::string &line)
+  { return 1 + static_cast<int>(std::count(line.begin(), line.end(), '\t')); };
 
-    if (linecounter > args.lastline) break;
+  // fill up rows to match multi-line
+  auto WriteRow = [&](std::size_t i)
+  {
+    outfile << output_contents.at(i);
+    int diff = tab_count_legend - CountColumns(output_contents.at(i));
+    while (diff > 0)
+    {
+      outfile << "nan" << sep;
+      diff--;
+    }
+    outfile << transition_history.at(i) << std::endl;
+  };
 
-    if (linecounter >= args.firstline and linecounter <= args.lastline)
+  // appends the new row to the output file, the whole file is only rewritten
+  // if the legend grows
+  auto Commit = [&](int, PointResult &&result)
+  {
+    output_contents.push_back(result.row_stream.str());
+    transition_history.push_back(std::move(result.transition_history));
+    bool rewrite = not outfile.is_open();
+    if (legend.size() < result.legend.size())
+    {
+      legend  = std::move(result.legend); // update legend
+      rewrite = true;
+    }
+    if (not rewrite)
     {
-      count += 1; // keep track at which point we are
-      output_contents.at(count - 1).precision(
-          std::numeric_limits<double>::max_digits10);
-
-      Logger::Write(LoggingLevel::ProgDetailed,
-                    "Currently at line " + std::to_string(linecounter));
-
-      modelPointer->setUseIndexCol(linestr_store);
-
-      std::pair<std::vector<double>, std::vector<double>> parameters =
-          modelPointer->initModel(linestr);
-
-      if (args.firstline == args.lastline)
-      {
-        modelPointer->write();
-      }
-
-      auto start = std::chrono::high_resolution_clock::now();
-
-      user_input input{modelPointer,
-                       args.templow,
-                       args.temphigh,
-                       args.UserDefined_vwall,
-                       args.perc_prbl,
-                       args.compl_prbl,
-                       0.1,
-                       args.MaxPathIntegrations,
-                       args.UseMultiStepPTMode,
-                       args.num_check_pts,
-                       args.CheckEWSymmetryRestoration,
-                       args.CheckNLOStability,
-                       args.WhichMinimizer,
-                       args.UseMultithreading,
-                       false,
-                       TransitionTemperature::Percolation,
-                       1};
-
-      TransitionTracer trans(input);
-
-      auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      std::chrono::high_resolution_clock::now() - start)
-                      .count() /
-                  1000.;
-
-      BSMPT::Logger::Write(BSMPT::LoggingLevel::ProgDetailed,
-                           "\nTook\t" + std::to_string(time) + " seconds.\n");
-
-      auto output = trans.output_store;
-
-      output_contents.at(count - 1)
-          << linestr << sep << parameters.second << sep
-          << output.status.status_nlo_stability << sep
-          << output.status.status_ewsr << sep << output.status.status_tracing
-          << sep << output.status.status_coex_pairs << sep << time << sep;
-
-      if ((output.status.status_tracing == StatusTracing::Success) &&
-          (output.status.status_coex_pairs == StatusCoexPair::Success))
-      {
-        for (std::size_t i = 0; i < trans.output_store.num_coex_phase_pairs;
-             i++)
-        {
-          output_contents.at(count - 1)
-              << output.status.status_crit.at(i) << sep
-              << output.vec_trans_data.at(i).crit_temp.value_or(EmptyValue)
-              << sep << output.vec_trans_data.at(i).crit_false_vev << sep
-              << output.vec_trans_data.at(i).crit_true_vev << sep
-              << output.status.status_bounce_sol.at(i) << sep
-              << output.status.status_nucl_approx.at(i) << sep
-              << output.vec_trans_data.at(i).nucl_approx_temp.value_or(
-                     EmptyValue)
-              << sep << output.vec_trans_data.at(i).nucl_approx_false_vev << sep
-              << output.vec_trans_data.at(i).nucl_approx_true_vev << sep
-              << output.status.status_nucl.at(i) << sep
-              << output.vec_trans_data.at(i).nucl_temp.value_or(EmptyValue)
-              << sep << output.vec_trans_data.at(i).nucl_false_vev << sep
-              << output.vec_trans_data.at(i).nucl_true_vev << sep
-              << output.status.status_perc.at(i) << sep
-              << output.vec_trans_data.at(i).perc_temp.value_or(EmptyValue)
-              << sep << output.vec_trans_data.at(i).perc_false_vev << sep
-              << output.vec_trans_data.at(i).perc_true_vev << sep
-              << output.status.status_compl.at(i) << sep
-              << output.vec_trans_data.at(i).compl_temp.value_or(EmptyValue)
-              << sep << output.vec_trans_data.at(i).compl_false_vev << sep
-              << output.vec_trans_data.at(i).compl_true_vev << sep;
-        }
-      }
-
-      transition_history.push_back(output.transition_history);
-
-      if (legend.size() < output.legend.size())
-      {
-        legend = output.legend; // update legend
-      }
-
-      // write to output file
-      std::ofstream outfile(args.outputfile);
-      if (!outfile.good())
-      {
-        Logger::Write(LoggingLevel::Default,
-                      "Can not create file " + args.outputfile);
-        return EXIT_FAILURE;
-      }
-
-      int tab_count_legend = 1;
-      std::stringstream full_legend;
-      full_legend << linestr_store << sep << modelPointer->addLegendCT() << sep
-                  << legend;
-      outfile << full_legend.str() << std::endl;
-
-      // get length of legend and of contents
-      std::string str_legend = full_legend.str();
-      for (auto &el : str_legend)
-      {
-        if (el == '\t')
-        {
-          tab_count_legend += 1;
-        }
-      }
-
-      std::vector<int> tab_count(count, 1);
-      for (std::size_t i = 0; i < count; i++)
-      {
-        std::string line = output_contents.at(i).str();
-        for (auto &el : line)
-        {
-          if (el == '\t')
-          {
-            tab_count.at(i) += 1;
-          }
-        }
-      }
-
-      // fill up previous rows to match multi-line
-      for (std::size_t i = 0; i < count; i++)
-      {
-        outfile << output_contents.at(i).str();
-
-        int diff = int(tab_count_legend - tab_count.at(i));
-
-        while (diff > 0)
-        {
-          outfile << "nan" << sep;
-          diff--;
-        }
-        outfile << transition_history.at(i) << std::endl;
-      }
-
-      outfile.close();
+      WriteRow(output_contents.size() - 1);
+      return;
     }
 
-    linecounter++;
-    if (infile.eof()) break;
-  }
+    outfile = std::ofstream(args.outputfile);
+    if (!outfile.good())
+    {
+      throw std::runtime_error("Can not create file " + args.outputfile);
+    }
+    std::stringstream full_legend;
+    full_legend << linestr_store << sep << modelPointer->addLegendCT() << sep
+                << legend;
+    outfile << full_legend.str() << std::endl;
+    tab_count_legend = CountColumns(full_legend.str());
+    for (std::size_t i = 0; i < output_contents.size(); i++)
+    {
+      WriteRow(i);
+    }
+  };
+
+  ProcessLinesParallel<PointResult>(infile,
+                                    2,
+                                    args.firstline,
+                                    args.lastline,
+                                    NumberOfThreads,
+                                    CreateProcessor,
+                                    Commit);
   return EXIT_SUCCESS;
 }
 catch (int)
@@ -267,6 +225,102 @@ catch (exception &e)
   return EXIT_FAILURE;
 }
 
+PointResult CalculatePoint(
+    const std::shared_ptr<BSMPT::Class_Potential_Origin> &modelPointer,
+    int linecounter,
+    const std::string &linestr,
+    const CLIOptions &args,
+    bool UseMultithreading)
+{
+  PointResult result;
+  result.row_stream.precision(std::numeric_limits<double>::max_digits10);
+
+  Logger::Write(LoggingLevel::ProgDetailed,
+                "Currently at line " + std::to_string(linecounter));
+
+  std::pair<std::vector<double>, std::vector<double>> parameters =
+      modelPointer->initModel(linestr);
+
+  if (args.firstline == args.lastline)
+  {
+    modelPointer->write();
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  user_input input{modelPointer,
+                   args.templow,
+                   args.temphigh,
+                   args.UserDefined_vwall,
+                   args.perc_prbl,
+                   args.compl_prbl,
+                   0.1,
+                   args.MaxPathIntegrations,
+                   args.UseMultiStepPTMode,
+                   args.num_check_pts,
+                   args.CheckEWSymmetryRestoration,
+                   args.CheckNLOStability,
+                   args.WhichMinimizer,
+                   UseMultithreading,
+                   false,
+                   TransitionTemperature::Percolation,
+                   1};
+
+  TransitionTracer trans(input);
+
+  auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count() /
+              1000.;
+
+  BSMPT::Logger::Write(BSMPT::LoggingLevel::ProgDetailed,
+                       "\nTook\t" + std::to_string(time) + " seconds.\n");
+
+  auto output = trans.output_store;
+
+  result.row_stream
+      << linestr << sep << parameters.second << sep
+      << output.status.status_nlo_stability << sep
+      << output.status.status_ewsr << sep << output.status.status_tracing
+      << sep << output.status.status_coex_pairs << sep << time << sep;
+
+  if ((output.status.status_tracing == StatusTracing::Success) &&
+      (output.status.status_coex_pairs == StatusCoexPair::Success))
+  {
+    for (std::size_t i = 0; i < trans.output_store.num_coex_phase_pairs;
+         i++)
+    {
+      result.row_stream
+          << output.status.status_crit.at(i) << sep
+          << output.vec_trans_data.at(i).crit_temp.value_or(EmptyValue)
+          << sep << output.vec_trans_data.at(i).crit_false_vev << sep
+          << output.vec_trans_data.at(i).crit_true_vev << sep
+          << output.status.status_bounce_sol.at(i) << sep
+          << output.status.status_nucl_approx.at(i) << sep
+          << output.vec_trans_data.at(i).nucl_approx_temp.value_or(
+                 EmptyValue)
+          << sep << output.vec_trans_data.at(i).nucl_approx_false_vev << sep
+          << output.vec_trans_data.at(i).nucl_approx_true_vev << sep
+          << output.status.status_nucl.at(i) << sep
+          << output.vec_trans_data.at(i).nucl_temp.value_or(EmptyValue)
+          << sep << output.vec_trans_data.at(i).nucl_false_vev << sep
+          << output.vec_trans_data.at(i).nucl_true_vev << sep
+          << output.status.status_perc.at(i) << sep
+          << output.vec_trans_data.at(i).perc_temp.value_or(EmptyValue)
+          << sep << output.vec_trans_data.at(i).perc_false_vev << sep
+          << output.vec_trans_data.at(i).perc_true_vev << sep
+          << output.status.status_compl.at(i) << sep
+          << output.vec_trans_data.at(i).compl_temp.value_or(EmptyValue)
+          << sep << output.vec_trans_data.at(i).compl_false_vev << sep
+          << output.vec_trans_data.at(i).compl_true_vev << sep;
+    }
+  }
+
+  result.transition_history = output.transition_history;
+  result.legend             = output.legend;
+  return result;
+}
+
 bool CLIOptions::good() const
 {
   if (UseGSL and not Minimizer::UseGSLDefault)
@@ -391,6 +445,8 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   std::string GSLhelp   = Minimizer::UseGSLDefault ? "true" : "false";
   std::string CMAEShelp = Minimizer::UseLibCMAESDefault ? "true" : "false";
   std::string NLoptHelp = Minimizer::UseNLoptDefault ? "true" : "false";
+  std::string GSLGradientHelp =
+      Minimizer::UseGSLGradientDefault ? "true" : "false";
   try
   {
     UseGSL = (argparser.get_value("usegsl") == "true");
@@ -418,6 +474,16 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
     ss << "--usenlopt not set, using default value: " << NLoptHelp << "\n";
   }
 
+  try
+  {
+    UseGSLGradient = (argparser.get_value("usegslgradient") == "true");
+  }
+  catch (BSMPT::parserException &)
+  {
+    ss << "--usegslgradient not set, using default value: " << GSLGradientHelp
+       << "\n";
+  }
+
   try
   {
     UseMultithreading = (argparser.get_value("usemultithreading") == "true");
@@ -427,6 +493,24 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
     ss << "--usemultithreading not set, using default value: false\n";
   }
 
+  try
+  {
+    ThreadPoolSize = argparser.get_value<int>("threadpoolsize");
+  }
+  catch (BSMPT::parserException &)
+  {
+    ss << "--threadpoolsize not set, using default value: 0\n";
+  }
+
+  try
+  {
+    NumberOfThreads = argparser.get_value<int>("threads");
+  }
+  catch (BSMPT::parserException &)
+  {
+    ss << "--threads not set, using default value: 1\n";
+  }
+
   // UseMultiStepPTMode
   try
   {
@@ -540,7 +624,8 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
        << MaxPathIntegrations << "\n";
   }
 
-  WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+  WhichMinimizer = Minimizer::CalcWhichMinimizer(
+      UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
 
   Logger::Write(LoggingLevel::ProgDetailed, ss.str());
 }
@@ -595,6 +680,8 @@ BSMPT::parser prepare_parser()
   std::string GSLhelp   = Minimizer::UseGSLDefault ? "true" : "false";
   std::string CMAEShelp = Minimizer::UseLibCMAESDefault ? "true" : "false";
   std::string NLoptHelp = Minimizer::UseNLoptDefault ? "true" : "false";
+  std::string GSLGradientHelp =
+      Minimizer::UseGSLGradientDefault ? "true" : "false";
 
   argparser.add_argument(
       "usegsl", "use GSL library for minimization", GSLhelp, false);
@@ -602,10 +689,26 @@ BSMPT::parser prepare_parser()
       "usecmaes", "use CMAES library  for minimization", CMAEShelp, false);
   argparser.add_argument(
       "usenlopt", "use NLopt library for minimization", NLoptHelp, false);
+  argparser.add_argument("usegslgradient",
+                         "use GSL library with the analytic gradient for "
+                         "minimization",
+                         GSLGradientHelp,
+                         false);
   argparser.add_argument("usemultithreading",
                          "enable multi-threading for minimizers",
                          "false",
                          false);
+  argparser.add_argument("threadpoolsize",
+                         "number of threads shared by the minimizers, 0 uses "
+                         "all cores",
+                         "0",
+                         false);
+  argparser.add_argument("threads",
+                         "number of parameter points calculated in parallel, "
+                         "0 uses all cores. At most threadpoolsize points are "
+                         "calculated at the same time",
+                         "1",
+                         false);
   argparser.add_argument(
       "json", "use a json file instead of cli parameters", false);
 
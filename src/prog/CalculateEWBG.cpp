@@ -18,12 +18,15 @@
 #include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Pot...
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ParallelLineProcessor.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/parser.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for max, copy
 #include <fstream>
 #include <iostream>
 #include <memory>   // for shared_ptr
+#include <sstream>
 #include <stdlib.h> // for atoi, std::size_t
 #include <string>   // for string
 #include <vector>   // for vector
@@ -41,8 +44,11 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
   bool UseMultithreading{true};
+  int ThreadPoolSize{0};
+  int NumberOfThreads{1};
 
   CLIOptions(const BSMPT::parser &argparser);
   bool good() const;
@@ -52,6 +58,25 @@ BSMPT::parser prepare_parser();
 
 std::vector<std::string> convert_input(int argc, char *argv[]);
 
+/**
+ * @brief CalculatePoint calculates the EWPT and the baryon asymmetry for a
+ * single parameter point
+ * @param modelPointer model instance used for this point
+ * @param EtaInterface eta interface instance used for this point
+ * @param linecounter line number of the parameter point
+ * @param linestr line of the input file
+ * @param args command line options
+ * @param UseMultithreading enables multithreading in the minimizers
+ * @return the line for the output file
+ */
+std::string CalculatePoint(
+    std::shared_ptr<Class_Potential_Origin> modelPointer,
+    const std::shared_ptr<Baryo::CalculateEtaInterface> &EtaInterface,
+    int linecounter,
+    const std::string &linestr,
+    const CLIOptions &args,
+    bool UseMultithreading);
+
 int main(int argc, char *argv[])
 try
 {
@@ -67,10 +92,11 @@ try
     return EXIT_FAILURE;
   }
 
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   // Init: Interface Class for the different transport methods
   Baryo::CalculateEtaInterface EtaInterface(args.ConfigFile, SMConstants);
 
-  int linecounter = 1;
   std::ifstream infile(args.InputFile);
   if (!infile.good())
   {
@@ -86,155 +112,65 @@ try
     return EXIT_FAILURE;
   }
   std::string linestr;
+  if (not getline(infile, linestr))
+  {
+    outfile.close();
+    return EXIT_SUCCESS;
+  }
   std::shared_ptr<Class_Potential_Origin> modelPointer = ModelID::FChoose(
       args.Model,
       SMConstants); // Declare the model pointer with the necessary parameters
   std::vector<std::string> etaLegend =
       EtaInterface.legend(); // Declare the vector for the PTFinder algorithm
-                             // Begin: Input Read
-  while (getline(infile, linestr))
+
+  // Write legend
+  modelPointer->setUseIndexCol(linestr);
+  outfile << linestr;
+  for (const auto &x : modelPointer->addLegendCT())
+    outfile << sep << x + "_EWBG";
+  for (const auto &x : modelPointer->addLegendTemp())
+    outfile << sep << x + "_EWBG";
+  outfile << sep << "vw";
+  outfile << sep << "L_W";
+  outfile << sep << "top_sym_phase";
+  outfile << sep << "top_brk_phase";
+  outfile << sep << "bot_sym_phase";
+  outfile << sep << "bot_brk_phase";
+  outfile << sep << "tau_sym_phase";
+  outfile << sep << "tau_brk_phase";
+  outfile << sep << etaLegend;
+  outfile << std::endl;
+
+  const auto NumberOfThreads = GetNumberOfThreads(args.NumberOfThreads);
+  // the minimizers of all points share the threads of the global pool
+  const bool UseMultithreading = args.UseMultithreading;
+
+  // every worker thread calculates its points with its own model and eta
+  // interface instance
+  auto CreateProcessor =
+      [&]() -> std::function<std::string(int, const std::string &)>
   {
-    if (linecounter > args.LastLine)
-      break;
-    else if (linecounter == 1)
+    std::shared_ptr<Class_Potential_Origin> model =
+        ModelID::FChoose(args.Model, SMConstants);
+    model->setUseIndexCol(linestr);
+    auto Eta = std::make_shared<Baryo::CalculateEtaInterface>(args.ConfigFile,
+                                                              SMConstants);
+    return [&, model, Eta](int linecounter, const std::string &line)
     {
-      // Write legend
-      modelPointer->setUseIndexCol(linestr);
-      outfile << linestr;
-      for (const auto &x : modelPointer->addLegendCT())
-        outfile << sep << x + "_EWBG";
-      for (const auto &x : modelPointer->addLegendTemp())
-        outfile << sep << x + "_EWBG";
-      outfile << sep << "vw";
-      outfile << sep << "L_W";
-      outfile << sep << "top_sym_phase";
-      outfile << sep << "top_brk_phase";
-      outfile << sep << "bot_sym_phase";
-      outfile << sep << "bot_brk_phase";
-      outfile << sep << "tau_sym_phase";
-      outfile << sep << "tau_brk_phase";
-      outfile << sep << etaLegend;
-      outfile << std::endl;
-    }
-    else if (linecounter >= args.FirstLine and linecounter <= args.LastLine and
-             linecounter != 1)
-    {
-      if (args.TerminalOutput)
-      {
-        Logger::Write(LoggingLevel::ProgDetailed,
-                      "Currently at line " + std::to_string(linecounter));
-      }
-      // Begin: Parameter Set Up for BSMPT
-      auto parameters = modelPointer->initModel(linestr);
-      modelPointer->FindSignSymmetries();
-      if (args.FirstLine == args.LastLine)
-      {
-        modelPointer->write();
-        Logger::Write(LoggingLevel::Default, "vw = " + std::to_string(args.vw));
-      }
-      if (args.TerminalOutput)
-        Logger::Write(LoggingLevel::ProgDetailed, "Calling PTFinder");
-
-      // Call: BSMPT
-      auto EWPT = Minimizer::PTFinder_gen_all(
-          modelPointer, 0, 300, args.WhichMinimizer, args.UseMultithreading);
-      // Define parameters for eta
-      std::vector<double> eta;
-      if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS and
-          C_PT * EWPT.Tc < EWPT.vc)
-      {
-        if (args.TerminalOutput)
-          Logger::Write(LoggingLevel::ProgDetailed, "SFOEWPT found...");
-        // Find the minimum in the symmetric phase. For this minimise at T = Tc
-        // + 1
-        std::vector<double> vevsymmetricSolution, checksym, startpoint;
-        for (const auto &el : EWPT.EWMinimum)
-          startpoint.push_back(0.5 * el);
-        vevsymmetricSolution =
-            Minimizer::Minimize_gen_all(modelPointer,
-                                        EWPT.Tc + 1,
-                                        checksym,
-                                        startpoint,
-                                        args.WhichMinimizer,
-                                        args.UseMultithreading);
-        // Call: Calculation of eta in the different implemented approaches
-        if (args.TerminalOutput)
-          Logger::Write(LoggingLevel::ProgDetailed, "Calling CalcEta...");
-        eta = EtaInterface.CalcEta(args.vw,
-                                   EWPT.EWMinimum,
-                                   vevsymmetricSolution,
-                                   EWPT.Tc,
-                                   modelPointer,
-                                   args.WhichMinimizer);
-        // Outfile
-        outfile << linestr;
-        outfile << sep << parameters.second;
-        outfile << sep << EWPT.Tc << sep << EWPT.vc;
-        outfile << sep << EWPT.vc / EWPT.Tc;
-        outfile << sep << EWPT.EWMinimum;
-        outfile << sep << args.vw;
-        outfile << sep << EtaInterface.getLW();
-        outfile << sep << EtaInterface.getSymmetricCPViolatingPhase_top();
-        outfile << sep << EtaInterface.getBrokenCPViolatingPhase_top();
-        outfile << sep << EtaInterface.getSymmetricCPViolatingPhase_bot();
-        outfile << sep << EtaInterface.getBrokenCPViolatingPhase_bot();
-        outfile << sep << EtaInterface.getSymmetricCPViolatingPhase_tau();
-        outfile << sep << EtaInterface.getBrokenCPViolatingPhase_tau();
-        outfile << sep << eta;
-        outfile << std::endl;
-      } // END: SFOEWPT found
-      else
-      { // No SFOEWPT provided
-        outfile << linestr;
-        outfile << sep << parameters.second;
-        outfile << sep << EWPT.Tc << sep << EWPT.vc;
-        outfile << sep << EWPT.EWMinimum;
-        outfile << sep << EWPT.vc / EWPT.Tc;
-        outfile << sep << args.vw;
-        outfile << sep << -1;  // LW
-        outfile << sep << -50; // top sym CP phase
-        outfile << sep << -50; // top brk CP phase
-        outfile << sep << -50; // bot sym CP phase
-        outfile << sep << -50; // bot brk CP phase
-        outfile << sep << -50; // tau sym CP phase
-        outfile << sep << -50; // tau brk CP phase
-        for (std::size_t i = 0; i < etaLegend.size(); i++)
-          outfile << sep << 0;
-        outfile << std::endl;
-      } // END: No SFOEWPT
-
-      if (args.FirstLine == args.LastLine)
-      {
-        std::stringstream ss;
-        auto dimensionnames = modelPointer->addLegendTemp();
-        ss << "Succeded ? " << static_cast<int>(EWPT.StatusFlag) << sep
-           << " (1 = Success , -1 = v/T reached a value below " << C_PT
-           << " during the calculation) \n";
-        if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
-        {
-          ss << std::scientific;
-          ss << dimensionnames.at(1) << " = " << EWPT.vc << " GeV\n";
-          ss << dimensionnames.at(0) << " = " << EWPT.Tc << " GeV\n";
-          ss << "xi_c = " << dimensionnames.at(2) << " = " << EWPT.vc / EWPT.Tc
-             << std::endl;
-          for (std::size_t i = 0; i < modelPointer->get_nVEV(); i++)
-          {
-            ss << dimensionnames.at(i + 3) << " = " << EWPT.EWMinimum.at(i)
-               << " GeV\n";
-          }
-          ss << "The Wall thickness is given by L_W  = " << EtaInterface.getLW()
-             << "GeV^-2\n"
-             << "L_W * T = " << EtaInterface.getLW() * EWPT.Tc << "\n";
-          for (std::size_t i = 0; i < etaLegend.size(); i++)
-            ss << etaLegend.at(i) << " = " << eta.at(i) << std::endl;
-        }
-        Logger::Write(LoggingLevel::Default, ss.str());
-
-      } // END: LineStart == LineEnd
-    }   // END: Valid Line
-    linecounter++;
-    if (infile.eof()) break;
-  } // END: Input Read
+      return CalculatePoint(
+          model, Eta, linecounter, line, args, UseMultithreading);
+    };
+  };
+
+  // Begin: Input Read
+  ProcessLinesParallel<std::string>(
+      infile,
+      2,
+      args.FirstLine,
+      args.LastLine,
+      NumberOfThreads,
+      CreateProcessor,
+      [&](int, std::string &&result) { outfile << result; });
   // Closing & Free
   outfile.close();
   return EXIT_SUCCESS;
@@ -249,6 +185,131 @@ catch (exception &e)
   return EXIT_FAILURE;
 }
 
+std::string CalculatePoint(
+    std::shared_ptr<Class_Potential_Origin> modelPointer,
+    const std::shared_ptr<Baryo::CalculateEtaInterface> &EtaInterface,
+    int linecounter,
+    const std::string &linestr,
+    const CLIOptions &args,
+    bool UseMultithreading)
+{
+  std::stringstream output;
+  const std::vector<std::string> EtaLegend = EtaInterface->legend();
+  if (args.TerminalOutput)
+  {
+    Logger::Write(LoggingLevel::ProgDetailed,
+                  "Currently at line " + std::to_string(linecounter));
+  }
+  // Begin: Parameter Set Up for BSMPT
+  auto parameters = modelPointer->initModel(linestr);
+  modelPointer->FindSignSymmetries();
+  if (args.FirstLine == args.LastLine)
+  {
+    modelPointer->write();
+    Logger::Write(LoggingLevel::Default, "vw = " + std::to_string(args.vw));
+  }
+  if (args.TerminalOutput)
+    Logger::Write(LoggingLevel::ProgDetailed, "Calling PTFinder");
+
+  // Call: BSMPT
+  auto EWPT = Minimizer::PTFinder_gen_all(
+      modelPointer, 0, 300, args.WhichMinimizer, UseMultithreading);
+  // Define parameters for eta
+  std::vector<double> eta;
+  if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS and
+      C_PT * EWPT.Tc < EWPT.vc)
+  {
+    if (args.TerminalOutput)
+      Logger::Write(LoggingLevel::ProgDetailed, "SFOEWPT found...");
+    // Find the minimum in the symmetric phase. For this minimise at T = Tc
+    // + 1
+    std::vector<double> vevsymmetricSolution, checksym, startpoint;
+    for (const auto &el : EWPT.EWMinimum)
+      startpoint.push_back(0.5 * el);
+    vevsymmetricSolution =
+        Minimizer::Minimize_gen_all(modelPointer,
+                                    EWPT.Tc + 1,
+                                    checksym,
+                                    startpoint,
+                                    args.WhichMinimizer,
+                                    UseMultithreading);
+    // Call: Calculation of eta in the different implemented approaches
+    if (args.TerminalOutput)
+      Logger::Write(LoggingLevel::ProgDetailed, "Calling CalcEta...");
+    eta = EtaInterface->CalcEta(args.vw,
+                                EWPT.EWMinimum,
+                                vevsymmetricSolution,
+                                EWPT.Tc,
+                                modelPointer,
+                                args.WhichMinimizer);
+    // Outfile
+    output << linestr;
+    output << sep << parameters.second;
+    output << sep << EWPT.Tc << sep << EWPT.vc;
+    output << sep << EWPT.vc / EWPT.Tc;
+    output << sep << EWPT.EWMinimum;
+    output << sep << args.vw;
+    output << sep << EtaInterface->getLW();
+    output << sep << EtaInterface->getSymmetricCPViolatingPhase_top();
+    output << sep << EtaInterface->getBrokenCPViolatingPhase_top();
+    output << sep << EtaInterface->getSymmetricCPViolatingPhase_bot();
+    output << sep << EtaInterface->getBrokenCPViolatingPhase_bot();
+    output << sep << EtaInterface->getSymmetricCPViolatingPhase_tau();
+    output << sep << EtaInterface->getBrokenCPViolatingPhase_tau();
+    output << sep << eta;
+    output << std::endl;
+  } // END: SFOEWPT found
+  else
+  { // No SFOEWPT provided
+    output << linestr;
+    output << sep << parameters.second;
+    output << sep << EWPT.Tc << sep << EWPT.vc;
+    output << sep << EWPT.EWMinimum;
+    output << sep << EWPT.vc / EWPT.Tc;
+    output << sep << args.vw;
+    output << sep << -1;  // LW
+    output << sep << -50; // top sym CP phase
+    output << sep << -50; // top brk CP phase
+    output << sep << -50; // bot sym CP phase
+    output << sep << -50; // bot brk CP phase
+    output << sep << -50; // tau sym CP phase
+    output << sep << -50; // tau brk CP phase
+    for (std::size_t i = 0; i < EtaLegend.size(); i++)
+      output << sep << 0;
+    output << std::endl;
+  } // END: No SFOEWPT
+
+  if (args.FirstLine == args.LastLine)
+  {
+    std::stringstream ss;
+    auto dimensionnames = modelPointer->addLegendTemp();
+    ss << "Succeded ? " << static_cast<int>(EWPT.StatusFlag) << sep
+       << " (1 = Success , -1 = v/T reached a value below " << C_PT
+       << " during the calculation) \n";
+    if (EWPT.StatusFlag == Minimizer::MinimizerStatus::SUCCESS)
+    {
+      ss << std::scientific;
+      ss << dimensionnames.at(1) << " = " << EWPT.vc << " GeV\n";
+      ss << dimensionnames.at(0) << " = " << EWPT.Tc << " GeV\n";
+      ss << "xi_c = " << dimensionnames.at(2) << " = " << EWPT.vc / EWPT.Tc
+         << std::endl;
+      for (std::size_t i = 0; i < modelPointer->get_nVEV(); i++)
+      {
+        ss << dimensionnames.at(i + 3) << " = " << EWPT.EWMinimum.at(i)
+           << " GeV\n";
+      }
+      ss << "The Wall thickness is given by L_W  = " << EtaInterface->getLW()
+         << "GeV^-2\n"
+         << "L_W * T = " << EtaInterface->getLW() * EWPT.Tc << "\n";
+      for (std::size_t i = 0; i < EtaLegend.size(); i++)
+        ss << EtaLegend.at(i) << " = " << eta.at(i) << std::endl;
+    }
+    Logger::Write(LoggingLevel::Default, ss.str());
+
+  } // END: LineStart == LineEnd
+  return output.str();
+}
+
 CLIOptions::CLIOptions(const BSMPT::parser &argparser)
 {
   argparser.check_required_parameters();
@@ -291,6 +352,14 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
+  try
+  {
+    UseGSLGradient = argparser.get_value<bool>("useGSLGradient");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
   try
   {
     UseMultithreading = argparser.get_value<bool>("useMultithreading");
@@ -299,7 +368,24 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
-  WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+  try
+  {
+    ThreadPoolSize = argparser.get_value<int>("threadPoolSize");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
+  try
+  {
+    NumberOfThreads = argparser.get_value<int>("threads");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
+  WhichMinimizer = Minimizer::CalcWhichMinimizer(
+      UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
 
   try
   {
@@ -383,6 +469,12 @@ BSMPT::parser prepare_parser()
       "vw",
       "Wall velocity for the EWBG calculation. Default value of 0.1.",
       false);
+  argparser.add_argument(
+      "threads",
+      "Number of parameter points calculated in parallel, 0 uses all cores. "
+      "Default is 1. At most threadPoolSize points are calculated at the "
+      "same time.",
+      false);
 
   std::stringstream ss;
   ss << "CalculateEWBG calculates the strength of the electroweak "
@@ -17,6 +17,7 @@
 #include <BSMPT/minimizer/Minimizer.h>
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for copy, max
 #include <fstream>
@@ -39,6 +40,8 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
+  int ThreadPoolSize{0};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
 
   CLIOptions(int argc, char *argv[]);
@@ -55,6 +58,8 @@ try
     return EXIT_FAILURE;
   }
 
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   std::shared_ptr<Class_Potential_Origin> modelPointer =
       ModelID::FChoose(args.Model);
   std::ifstream infile(args.InputFile);
@@ -202,6 +207,16 @@ CLIOptions::CLIOptions(int argc, char *argv[])
     ss << std::setw(SizeOfFirstColumn) << std::left << NLoptHelp
        << "Use the NLopt library to minimize the effective potential"
        << std::endl;
+    std::string GSLGradientHelp{"--UseGSLGradient="};
+    GSLGradientHelp += Minimizer::UseGSLGradientDefault ? "true" : "false";
+    ss << std::setw(SizeOfFirstColumn) << std::left << GSLGradientHelp
+       << "Use the GSL library with the analytic gradient to minimize the "
+          "effective potential"
+       << std::endl;
+    ss << std::setw(SizeOfFirstColumn) << std::left << "--ThreadPoolSize="
+       << "Number of threads shared by the minimizers, 0 uses all cores. "
+          "Default value of 0."
+       << std::endl;
     ShowLoggerHelp();
     ShowInputError();
   }
@@ -257,12 +272,23 @@ CLIOptions::CLIOptions(int argc, char *argv[])
       {
         UseNLopt = el.substr(std::string("--usenlopt=").size()) == "true";
       }
+      else if (StringStartsWith(el, "--usegslgradient="))
+      {
+        UseGSLGradient =
+            el.substr(std::string("--usegslgradient=").size()) == "true";
+      }
+      else if (StringStartsWith(el, "--threadpoolsize="))
+      {
+        ThreadPoolSize =
+            std::stoi(el.substr(std::string("--threadpoolsize=").size()));
+      }
       else
       {
         UnusedArgs.push_back(el);
       }
     }
-    WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+    WhichMinimizer = Minimizer::CalcWhichMinimizer(
+        UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
     SetLogger(UnusedArgs);
   }
   else
@@ -16,6 +16,7 @@
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/transition_tracer/transition_tracer.h> // TransitionTracer
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/parser.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for copy, max
@@ -41,8 +42,10 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
   bool UseMultithreading{false};
+  int ThreadPoolSize{0};
   int UseMultiStepPTMode{-1};
   int CheckEWSymmetryRestoration{1};
   int num_check_pts{10};
@@ -67,6 +70,8 @@ try
     return EXIT_FAILURE;
   }
 
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   std::ifstream infile(args.inputfile);
   if (!infile.good())
   {
@@ -380,6 +385,8 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   std::string GSLhelp   = Minimizer::UseGSLDefault ? "true" : "false";
   std::string CMAEShelp = Minimizer::UseLibCMAESDefault ? "true" : "false";
   std::string NLoptHelp = Minimizer::UseNLoptDefault ? "true" : "false";
+  std::string GSLGradientHelp =
+      Minimizer::UseGSLGradientDefault ? "true" : "false";
   try
   {
     UseGSL = (argparser.get_value("usegsl") == "true");
@@ -407,6 +414,16 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
     ss << "--usenlopt not set, using default value: " << NLoptHelp << "\n";
   }
 
+  try
+  {
+    UseGSLGradient = (argparser.get_value("usegslgradient") == "true");
+  }
+  catch (BSMPT::parserException &)
+  {
+    ss << "--usegslgradient not set, using default value: " << GSLGradientHelp
+       << "\n";
+  }
+
   try
   {
     UseMultithreading = (argparser.get_value("usemultithreading") == "true");
@@ -416,6 +433,15 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
     ss << "--usemultithreading not set, using default value: false\n";
   }
 
+  try
+  {
+    ThreadPoolSize = argparser.get_value<int>("threadpoolsize");
+  }
+  catch (BSMPT::parserException &)
+  {
+    ss << "--threadpoolsize not set, using default value: 0\n";
+  }
+
   // UseMultiStepPTMode
   try
   {
@@ -466,7 +492,8 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
     ss << "--checkewsr not set, using default value: on\n";
   }
 
-  WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+  WhichMinimizer = Minimizer::CalcWhichMinimizer(
+      UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
 
   Logger::Write(LoggingLevel::ProgDetailed, ss.str());
 }
@@ -502,6 +529,8 @@ BSMPT::parser prepare_parser()
   std::string GSLhelp   = Minimizer::UseGSLDefault ? "true" : "false";
   std::string CMAEShelp = Minimizer::UseLibCMAESDefault ? "true" : "false";
   std::string NLoptHelp = Minimizer::UseNLoptDefault ? "true" : "false";
+  std::string GSLGradientHelp =
+      Minimizer::UseGSLGradientDefault ? "true" : "false";
 
   argparser.add_argument(
       "usegsl", "use GSL library for minimization", GSLhelp, false);
@@ -509,10 +538,20 @@ BSMPT::parser prepare_parser()
       "usecmaes", "use CMAES library  for minimization", CMAEShelp, false);
   argparser.add_argument(
       "usenlopt", "use NLopt library for minimization", NLoptHelp, false);
+  argparser.add_argument("usegslgradient",
+                         "use GSL library with the analytic gradient for "
+                         "minimization",
+                         GSLGradientHelp,
+                         false);
   argparser.add_argument("usemultithreading",
                          "enable multi-threading for minimizers",
                          "false",
                          false);
+  argparser.add_argument("threadpoolsize",
+                         "number of threads shared by the minimizers, 0 uses "
+                         "all cores",
+                         "0",
+                         false);
   argparser.add_argument(
       "json", "use a json file instead of cli parameters", false);
 
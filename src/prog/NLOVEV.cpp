@@ -16,6 +16,7 @@
 #include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Potential_Origin
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/parser.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for copy, max
@@ -38,8 +39,10 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
   bool UseMultithreading{true};
+  int ThreadPoolSize{0};
 
   CLIOptions(const BSMPT::parser &argparser);
   bool good() const;
@@ -61,6 +64,8 @@ try
     return EXIT_FAILURE;
   }
 
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   int linecounter = 1;
   std::ifstream infile(args.InputFile);
   if (!infile.good())
@@ -226,6 +231,14 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
+  try
+  {
+    UseGSLGradient = argparser.get_value<bool>("useGSLGradient");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
   try
   {
     UseMultithreading = argparser.get_value<bool>("useMultithreading");
@@ -234,7 +247,16 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
-  WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+  try
+  {
+    ThreadPoolSize = argparser.get_value<int>("threadPoolSize");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
+  WhichMinimizer = Minimizer::CalcWhichMinimizer(
+      UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
 }
 
 BSMPT::parser prepare_parser()
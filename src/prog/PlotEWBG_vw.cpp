@@ -15,6 +15,7 @@
 #include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Pot...
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/parser.h>
 #include <BSMPT/utility/utility.h>
 #include <algorithm> // for copy, max
@@ -37,8 +38,10 @@ struct CLIOptions
   bool UseGSL{Minimizer::UseGSLDefault};
   bool UseCMAES{Minimizer::UseLibCMAESDefault};
   bool UseNLopt{Minimizer::UseNLoptDefault};
+  bool UseGSLGradient{Minimizer::UseGSLGradientDefault};
   int WhichMinimizer{Minimizer::WhichMinimizerDefault};
   bool UseMultithreading{true};
+  int ThreadPoolSize{0};
 
   CLIOptions(const BSMPT::parser &argparser);
   bool good() const;
@@ -60,6 +63,8 @@ try
     return EXIT_FAILURE;
   }
 
+  ThreadPool::SetGlobalConcurrency(args.ThreadPoolSize);
+
   // Set up of BSMPT/Baryo Classes
   Baryo::CalculateEtaInterface EtaInterface(args.ConfigFile, SMConstants);
   std::shared_ptr<Class_Potential_Origin> modelPointer =
@@ -229,6 +234,14 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
+  try
+  {
+    UseGSLGradient = argparser.get_value<bool>("useGSLGradient");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
   try
   {
     UseMultithreading = argparser.get_value<bool>("useMultithreading");
@@ -237,7 +250,16 @@ CLIOptions::CLIOptions(const BSMPT::parser &argparser)
   {
   }
 
-  WhichMinimizer = Minimizer::CalcWhichMinimizer(UseGSL, UseCMAES, UseNLopt);
+  try
+  {
+    ThreadPoolSize = argparser.get_value<int>("threadPoolSize");
+  }
+  catch (BSMPT::parserException &)
+  {
+  }
+
+  WhichMinimizer = Minimizer::CalcWhichMinimizer(
+      UseGSL, UseCMAES, UseNLopt, UseGSLGradient);
 }
 
 bool CLIOptions::good() const
@@ -135,12 +135,17 @@ try
 
       auto grid_points =
           Create1DimGrid(args.min_start, args.min_end, args.npoints);
-      for (auto point : grid_points)
+      std::vector<double> points, values;
+      for (const auto &point : grid_points)
       {
-        outfile << point << sep
-                << modelPointer->VEff(modelPointer->MinimizeOrderVEV(point),
-                                      temp)
-                << sep << temp << std::endl;
+        const auto v = modelPointer->MinimizeOrderVEV(point);
+        points.insert(points.end(), v.begin(), v.end());
+      }
+      modelPointer->VEffBatch(points, temp, values);
+      for (std::size_t p = 0; p < grid_points.size(); p++)
+      {
+        outfile << grid_points.at(p) << sep << values.at(p) << sep << temp
+                << std::endl;
       }
     }
     else
@@ -208,6 +213,27 @@ try
     std::vector<std::vector<double>> res_vec_outer, res_vec_inner_1,
         res_vec_inner_2, res_vec_inner_3, res_vec_inner_4, res_vec_inner_5;
 
+    const double VEffStart =
+        modelPointer->VEff(modelPointer->MinimizeOrderVEV(vevStart), temp);
+    // Evaluates the potential on all points of a grid line at once
+    auto WriteGrid = [&](const std::vector<std::vector<double>> &grid)
+    {
+      std::vector<double> points, values;
+      for (const auto &point : grid)
+      {
+        const auto v = modelPointer->MinimizeOrderVEV(point);
+        points.insert(points.end(), v.begin(), v.end());
+      }
+      modelPointer->VEffBatch(points, temp, values);
+      for (std::size_t p = 0; p < grid.size(); p++)
+      {
+        outfile << grid.at(p) << sep;
+        outfile << vevStart << sep;
+        outfile << values.at(p) << sep;
+        outfile << VEffStart << sep << temp << std::endl;
+      }
+    };
+
     for (std::size_t i = 0; i < modelPointer->get_nVEV(); i++)
     {
       res_vec_outer =
@@ -215,17 +241,7 @@ try
 
       if (modelPointer->get_nVEV() == 1)
       {
-        for (std::vector<double> a1 : res_vec_outer)
-        {
-          outfile << a1 << sep;
-          outfile << vevStart << sep;
-          outfile << modelPointer->VEff(modelPointer->MinimizeOrderVEV(a1),
-                                        temp)
-                  << sep;
-          outfile << modelPointer->VEff(
-                         modelPointer->MinimizeOrderVEV(vevStart), temp)
-                  << sep << temp << std::endl;
-        }
+        WriteGrid(res_vec_outer);
       }
       else if (i + 1 < modelPointer->get_nVEV())
       {
@@ -236,17 +252,7 @@ try
 
           if (modelPointer->get_nVEV() == 2)
           {
-            for (std::vector<double> a2 : res_vec_inner_1)
-            {
-              outfile << a2 << sep;
-              outfile << vevStart << sep;
-              outfile << modelPointer->VEff(modelPointer->MinimizeOrderVEV(a2),
-                                            temp)
-                      << sep;
-              outfile << modelPointer->VEff(
-                             modelPointer->MinimizeOrderVEV(vevStart), temp)
-                      << sep << temp << std::endl;
-            }
+            WriteGrid(res_vec_inner_1);
           }
           else if (i + 2 < modelPointer->get_nVEV())
           {
@@ -257,17 +263,7 @@ try
 
               if (modelPointer->get_nVEV() == 3)
               {
-                for (std::vector<double> a3 : res_vec_inner_2)
-                {
-                  outfile << a3 << sep;
-                  outfile << vevStart << sep;
-                  outfile << modelPointer->VEff(
-                                 modelPointer->MinimizeOrderVEV(a3), temp)
-                          << sep;
-                  outfile << modelPointer->VEff(
-                                 modelPointer->MinimizeOrderVEV(vevStart), temp)
-                          << sep << temp << std::endl;
-                }
+                WriteGrid(res_vec_inner_2);
               }
               else if (i + 3 < modelPointer->get_nVEV())
               {
@@ -278,18 +274,7 @@ try
 
                   if (modelPointer->get_nVEV() == 4)
                   {
-                    for (std::vector<double> a4 : res_vec_inner_3)
-                    {
-                      outfile << a4 << sep;
-                      outfile << vevStart << sep;
-                      outfile << modelPointer->VEff(
-                                     modelPointer->MinimizeOrderVEV(a4), temp)
-                              << sep;
-                      outfile
-                          << modelPointer->VEff(
-                                 modelPointer->MinimizeOrderVEV(vevStart), temp)
-                          << sep << temp << std::endl;
-                    }
+                    WriteGrid(res_vec_inner_3);
                   }
                   else if (i + 4 < modelPointer->get_nVEV())
                   {
@@ -300,20 +285,7 @@ try
 
                       if (modelPointer->get_nVEV() == 5)
                       {
-                        for (std::vector<double> a5 : res_vec_inner_4)
-                        {
-                          outfile << a5 << sep;
-                          outfile << vevStart << sep;
-                          outfile
-                              << modelPointer->VEff(
-                                     modelPointer->MinimizeOrderVEV(a5), temp)
-                              << sep;
-                          outfile
-                              << modelPointer->VEff(
-                                     modelPointer->MinimizeOrderVEV(vevStart),
-                                     temp)
-                              << sep << temp << std::endl;
-                        }
+                        WriteGrid(res_vec_inner_4);
                       }
                       else if (i + 5 < modelPointer->get_nVEV())
                       {
@@ -324,20 +296,7 @@ try
 
                           if (modelPointer->get_nVEV() == 6)
                           {
-                            for (std::vector<double> a6 : res_vec_inner_5)
-                            {
-                              outfile << a6 << sep;
-                              outfile << vevStart << sep;
-                              outfile << modelPointer->VEff(
-                                             modelPointer->MinimizeOrderVEV(a6),
-                                             temp)
-                                      << sep;
-                              outfile << modelPointer->VEff(
-                                             modelPointer->MinimizeOrderVEV(
-                                                 vevStart),
-                                             temp)
-                                      << sep << temp << std::endl;
-                            }
+                            WriteGrid(res_vec_inner_5);
                           }
                           else if (i + 6 < modelPointer->get_nVEV())
                           {
@@ -8,12 +8,14 @@
  */
 
 #include <BSMPT/transition_tracer/transition_tracer.h>
+#include <BSMPT/utility/Profiler.h>
 
 namespace BSMPT
 {
 
 TransitionTracer::TransitionTracer(user_input &input)
 {
+  BSMPT_PROFILE_STAGE(TransitionTracer);
   num_vev = input.modelPointer->get_nVEV();
 
   std::shared_ptr<MinimumTracer> mintracer(new MinimumTracer(
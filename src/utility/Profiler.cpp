@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file
+ */
+
+#include <BSMPT/utility/Logger.h>
+#include <BSMPT/utility/Profiler.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace BSMPT
+{
+namespace Profiler
+{
+
+namespace
+{
+const std::array<std::string, NumberOfCounters> CounterNames{
+    "VEff",
+    "VEffGradient",
+    "HiggsMassesSquared",
+    "CalculateDebye",
+    "JbosonInterpolated",
+    "JfermionInterpolated"};
+
+const std::array<std::string, NumberOfStages> StageNames{"Other",
+                                                         "Minimizer",
+                                                         "MinimumTracer",
+                                                         "TransitionTracer",
+                                                         "Bounce",
+                                                         "GravitationalWaves"};
+
+template <typename T> void Increase(std::atomic<T> &Value, T Increment)
+{
+  Value.store(Value.load(std::memory_order_relaxed) + Increment,
+              std::memory_order_relaxed);
+}
+
+void WriteAtExit();
+
+/**
+ * @brief The Registry struct knows the counters of all running threads and
+ * keeps the counts of the finished ones
+ */
+struct Registry
+{
+  Registry()
+  {
+    // The logger has to outlive the report written at exit
+    Logger::GetLoggingLevelStatus(LoggingLevel::Profile);
+    std::atexit(WriteAtExit);
+  }
+
+  std::mutex Mutex;
+  std::vector<const ThreadProfile *> Threads;
+  Profile Finished;
+  std::string JSONOutput;
+};
+
+Registry &GetRegistry()
+{
+  // Never destroyed, the worker threads of the pool may finish after the
+  // static objects are destroyed
+  static Registry *Instance = new Registry;
+  return *Instance;
+}
+
+void WriteAtExit()
+{
+  if (not IsEnabled()) return;
+  const auto profile = GetProfile();
+  Logger::Write(LoggingLevel::Profile, GetReport(profile));
+  std::string file;
+  {
+    auto &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    file = registry.JSONOutput;
+  }
+  if (not file.empty()) WriteJSON(file, profile);
+}
+} // namespace
+
+ThreadProfile::ThreadProfile()
+{
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.Threads.push_back(this);
+}
+
+ThreadProfile::~ThreadProfile()
+{
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  Add(registry.Finished);
+  registry.Threads.erase(
+      std::find(registry.Threads.begin(), registry.Threads.end(), this));
+}
+
+void ThreadProfile::Add(Profile &Total) const
+{
+  for (std::size_t stage = 0; stage < NumberOfStages; stage++)
+  {
+    for (std::size_t counter = 0; counter < NumberOfCounters; counter++)
+    {
+      Total.Counts[stage][counter] +=
+          Counts[stage][counter].load(std::memory_order_relaxed);
+    }
+    Total.Entries[stage] += Entries[stage].load(std::memory_order_relaxed);
+    Total.Seconds[stage] += Seconds[stage].load(std::memory_order_relaxed);
+  }
+}
+
+ScopedTimer::ScopedTimer(Stage stage)
+    : Nested{GetCurrentStage() == stage}
+    , Guard{stage}
+    , TimedStage{stage}
+    , Start{std::chrono::steady_clock::now()}
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  if (Nested) return;
+  const double Elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - Start)
+          .count();
+  auto &Thread = GetThreadProfile();
+  Increase<std::uint64_t>(Thread.Entries[static_cast<std::size_t>(TimedStage)],
+                          1);
+  Increase(Thread.Seconds[static_cast<std::size_t>(TimedStage)], Elapsed);
+}
+
+Profile GetProfile()
+{
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  Profile Total = registry.Finished;
+  for (const auto *Thread : registry.Threads)
+  {
+    Thread->Add(Total);
+  }
+  return Total;
+}
+
+void Reset()
+{
+  // The counters of the running threads are cleared from this thread, so no
+  // other thread should be calculating at this point
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.Finished = Profile();
+  for (const auto *Thread : registry.Threads)
+  {
+    auto &Running = const_cast<ThreadProfile &>(*Thread);
+    for (std::size_t stage = 0; stage < NumberOfStages; stage++)
+    {
+      for (auto &Value : Running.Counts[stage])
+      {
+        Value.store(0, std::memory_order_relaxed);
+      }
+      Running.Entries[stage].store(0, std::memory_order_relaxed);
+      Running.Seconds[stage].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+std::string GetReport(const Profile &profile)
+{
+  const int NameWidth  = 20;
+  const int ValueWidth = 22;
+  std::stringstream ss;
+  ss << "Profile of the stages, the times include the nested stages"
+     << std::endl
+     << std::left << std::setw(NameWidth) << "stage" << std::right
+     << std::setw(ValueWidth) << "entries" << std::setw(ValueWidth)
+     << "seconds";
+  for (const auto &Name : CounterNames)
+  {
+    ss << std::setw(ValueWidth) << Name;
+  }
+  ss << std::endl;
+  for (std::size_t stage = 0; stage < NumberOfStages; stage++)
+  {
+    ss << std::left << std::setw(NameWidth) << StageNames.at(stage)
+       << std::right << std::setw(ValueWidth) << profile.Entries.at(stage)
+       << std::setw(ValueWidth) << profile.Seconds.at(stage);
+    for (const auto &Value : profile.Counts.at(stage))
+    {
+      ss << std::setw(ValueWidth) << Value;
+    }
+    ss << std::endl;
+  }
+  return ss.str();
+}
+
+std::string GetJSON(const Profile &profile)
+{
+  std::stringstream ss;
+  ss << std::setprecision(10) << "{";
+  for (std::size_t stage = 0; stage < NumberOfStages; stage++)
+  {
+    ss << (stage == 0 ? "" : ",") << "\n  \"" << StageNames.at(stage)
+       << "\": {\"Entries\": " << profile.Entries.at(stage)
+       << ", \"Seconds\": " << profile.Seconds.at(stage) << ", \"Counts\": {";
+    for (std::size_t counter = 0; counter < NumberOfCounters; counter++)
+    {
+      ss << (counter == 0 ? "" : ", ") << "\"" << CounterNames.at(counter)
+         << "\": " << profile.Counts.at(stage).at(counter);
+    }
+    ss << "}}";
+  }
+  ss << "\n}\n";
+  return ss.str();
+}
+
+void WriteJSON(const std::string &file, const Profile &profile)
+{
+  std::ofstream output(file);
+  if (not output.good())
+  {
+    throw std::runtime_error("Could not open " + file +
+                             " to write the profile.");
+  }
+  output << GetJSON(profile);
+}
+
+void SetJSONOutput(const std::string &file)
+{
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.JSONOutput = file;
+}
+
+} // namespace Profiler
+} // namespace BSMPT
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file
+ */
+
+#include <BSMPT/utility/Profiler.h>
+#include <BSMPT/utility/ThreadPool.h>
+
+namespace BSMPT
+{
+
+namespace
+{
+/**
+ * Pool and queue index of the worker running on this thread, nullptr for
+ * threads which are not workers
+ */
+thread_local ThreadPool *CurrentPool     = nullptr;
+thread_local std::size_t CurrentWorkerID = 0;
+
+std::mutex GlobalPoolMutex;
+std::unique_ptr<ThreadPool> GlobalPool;
+int GlobalConcurrency = 0;
+} // namespace
+
+ThreadPool::ThreadPool(int Concurrency)
+{
+  const std::size_t NumberOfWorkers = GetNumberOfThreads(Concurrency) - 1;
+  for (std::size_t i = 0; i < NumberOfWorkers; i++)
+  {
+    Queues.push_back(std::make_unique<TaskQueue>());
+  }
+  Workers.reserve(NumberOfWorkers);
+  for (std::size_t i = 0; i < NumberOfWorkers; i++)
+  {
+    Workers.emplace_back([this, i]() { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(SleepMutex);
+    Stop = true;
+  }
+  Wakeup.notify_all();
+  for (auto &worker : Workers)
+  {
+    worker.join();
+  }
+}
+
+std::size_t ThreadPool::GetConcurrency() const
+{
+  return Workers.size() + 1;
+}
+
+ThreadPool &ThreadPool::Global()
+{
+  std::lock_guard<std::mutex> lock(GlobalPoolMutex);
+  if (not GlobalPool)
+  {
+    GlobalPool = std::make_unique<ThreadPool>(GlobalConcurrency);
+  }
+  return *GlobalPool;
+}
+
+void ThreadPool::SetGlobalConcurrency(int Concurrency)
+{
+  std::lock_guard<std::mutex> lock(GlobalPoolMutex);
+  GlobalConcurrency = Concurrency;
+  if (GlobalPool and
+      GlobalPool->GetConcurrency() != GetNumberOfThreads(Concurrency))
+  {
+    GlobalPool.reset();
+  }
+}
+
+void ThreadPool::Submit(const std::shared_ptr<Task> &task)
+{
+  // Without workers the task is executed by the thread waiting for its group
+  if (Workers.empty()) return;
+
+  TaskQueue &Queue =
+      CurrentPool == this ? *Queues.at(CurrentWorkerID) : InjectionQueue;
+  {
+    std::lock_guard<std::mutex> lock(Queue.Mutex);
+    Queue.Tasks.push_back(task);
+  }
+  {
+    std::lock_guard<std::mutex> lock(SleepMutex);
+    QueuedTasks++;
+  }
+  Wakeup.notify_one();
+}
+
+std::shared_ptr<ThreadPool::Task> ThreadPool::TakeTask(std::size_t WorkerIndex)
+{
+  std::shared_ptr<Task> task;
+  auto PopFront = [&task](TaskQueue &Queue)
+  {
+    std::lock_guard<std::mutex> lock(Queue.Mutex);
+    if (Queue.Tasks.empty()) return false;
+    task = std::move(Queue.Tasks.front());
+    Queue.Tasks.pop_front();
+    return true;
+  };
+
+  bool found = false;
+  {
+    auto &Own = *Queues.at(WorkerIndex);
+    std::lock_guard<std::mutex> lock(Own.Mutex);
+    if (not Own.Tasks.empty())
+    {
+      task = std::move(Own.Tasks.back());
+      Own.Tasks.pop_back();
+      found = true;
+    }
+  }
+  if (not found) found = PopFront(InjectionQueue);
+  for (std::size_t i = 1; not found and i < Queues.size(); i++)
+  {
+    found = PopFront(*Queues.at((WorkerIndex + i) % Queues.size()));
+  }
+
+  if (found)
+  {
+    std::lock_guard<std::mutex> lock(SleepMutex);
+    QueuedTasks--;
+  }
+  return task;
+}
+
+void ThreadPool::Execute(const std::shared_ptr<Task> &task)
+{
+  // The task is also listed in its group, whoever claims it first runs it
+  if (task->Claimed.exchange(true)) return;
+  std::exception_ptr TaskError;
+  try
+  {
+    task->Function();
+  }
+  catch (...)
+  {
+    TaskError = std::current_exception();
+  }
+  // Stale copies of the task may stay in the queues for a while, the captured
+  // state is released right away
+  task->Function = nullptr;
+  task->Group->Finish(TaskError);
+}
+
+void ThreadPool::WorkerLoop(std::size_t WorkerIndex)
+{
+  CurrentPool     = this;
+  CurrentWorkerID = WorkerIndex;
+  while (true)
+  {
+    auto task = TakeTask(WorkerIndex);
+    if (task)
+    {
+      Execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(SleepMutex);
+    Wakeup.wait(lock, [this]() { return Stop or QueuedTasks > 0; });
+    if (Stop) return;
+  }
+}
+
+TaskGroup::TaskGroup(ThreadPool &pool)
+    : Pool{pool}
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  try
+  {
+    Wait();
+  }
+  catch (...)
+  {
+  }
+}
+
+void TaskGroup::Run(std::function<void()> Function)
+{
+#ifdef BSMPTEnableProfiling
+  // The evaluations of the task count for the stage which submitted it
+  Function = [stage = Profiler::GetCurrentStage(),
+              TaskFunction = std::move(Function)]()
+  {
+    Profiler::StageGuard Guard(stage);
+    TaskFunction();
+  };
+#endif
+  auto task      = std::make_shared<ThreadPool::Task>();
+  task->Function = std::move(Function);
+  task->Group    = this;
+  {
+    std::lock_guard<std::mutex> lock(Mutex);
+    Pending.push_back(task);
+    Unfinished++;
+  }
+  Pool.Submit(task);
+}
+
+void TaskGroup::Wait()
+{
+  while (true)
+  {
+    std::shared_ptr<ThreadPool::Task> task;
+    {
+      std::lock_guard<std::mutex> lock(Mutex);
+      if (Pending.empty()) break;
+      task = std::move(Pending.back());
+      Pending.pop_back();
+    }
+    ThreadPool::Execute(task);
+  }
+
+  std::unique_lock<std::mutex> lock(Mutex);
+  Finished.wait(lock, [this]() { return Unfinished == 0; });
+  if (Error)
+  {
+    auto TaskError = Error;
+    Error          = nullptr;
+    std::rethrow_exception(TaskError);
+  }
+}
+
+void TaskGroup::Finish(std::exception_ptr TaskError)
+{
+  std::lock_guard<std::mutex> lock(Mutex);
+  if (TaskError and not Error) Error = TaskError;
+  if (--Unfinished == 0) Finished.notify_all();
+}
+
+} // namespace BSMPT
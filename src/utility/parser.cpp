@@ -121,9 +121,17 @@ void parser::enable_minimizer_options()
   add_argument("useNLopt",
                "Use the NLopt library to minimize the effective potential",
                false);
+  add_argument("useGSLGradient",
+               "Use the GSL library with the analytic gradient of the "
+               "effective potential to minimize it.",
+               false);
   add_argument("useMultithreading",
                "Enables/Disables multi threading for the minimizers",
                false);
+  add_argument("threadPoolSize",
+               "Number of threads shared by the minimizers, 0 uses all cores. "
+               "Default is 0.",
+               false);
 }
 
 void parser::add_argument_only_display(const std::string &argument,
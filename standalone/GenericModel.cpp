@@ -45,6 +45,10 @@ public:
     return;
   };
   void write() const override { return; };
+  std::unique_ptr<Class_Potential_Origin> clone() const override
+  {
+    return std::make_unique<Class_Potential_OriginDerived>(*this);
+  };
   void SetCurvatureArrays() override { return; };
   bool CalculateDebyeSimplified() override { return true; };
   bool CalculateDebyeGaugeSimplified() override { return true; };
@@ -6,6 +6,7 @@
 #include <benchmark/benchmark.h>
 
 #include <BSMPT/baryo_calculation/CalculateEtaInterface.h>
+#include <BSMPT/baryo_calculation/transport_equations.h>
 #include <BSMPT/minimizer/Minimizer.h>
 #include <BSMPT/models/ClassPotentialOrigin.h>
 #include <BSMPT/models/IncludeAllModels.h>
@@ -76,4 +77,40 @@ static void BM_EWBG(benchmark::State &state)
   }
 }
 
+static void BM_TransportEquation(benchmark::State &state)
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const auto WhichMin = Minimizer::WhichMinimizerDefault;
+
+  const auto EWPT = Expected.EWPTPerSetting.at(WhichMin);
+
+  std::vector<double> vevsymmetricSolution, checksym, startpoint;
+  for (const auto &el : EWPT.EWMinimum)
+    startpoint.push_back(0.5 * el);
+  vevsymmetricSolution = Minimizer::Minimize_gen_all(
+      modelPointer, EWPT.Tc + 1, checksym, startpoint, WhichMin, true);
+  auto vevcritical = EWPT.EWMinimum;
+
+  Baryo::GSL_integration_mubl params;
+  params.init(Expected.testVW,
+              vevcritical,
+              vevsymmetricSolution,
+              EWPT.Tc,
+              modelPointer,
+              WhichMin);
+  const std::vector<double> parStart(8, 0);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+        Baryo::calculateTransportEquation(0, parStart, params));
+  }
+}
+
 BENCHMARK(BM_EWBG)->Repetitions(5);
+BENCHMARK(BM_TransportEquation);
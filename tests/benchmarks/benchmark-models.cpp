@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file
+ * Microbenchmarks of the potential evaluation for all implemented models and
+ * of the interpolated thermal functions
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <BSMPT/ThermalFunctions/ThermalFunctions.h>
+#include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Potential_Origin
+#include <BSMPT/models/IncludeAllModels.h>
+#include <BSMPT/utility/NumericalDerivatives.h>
+
+#include <map>
+
+namespace
+{
+using BSMPT::ModelID::ModelIDs;
+
+const std::map<ModelIDs, std::vector<double>> ExamplePoints{
+    {ModelIDs::C2HDM,
+     {/* lambda_1 = */ 3.29771,
+      /* lambda_2 = */ 0.274365,
+      /* lambda_3 = */ 4.71019,
+      /* lambda_4 = */ -2.23056,
+      /* Re(lambda_5) = */ -2.43487,
+      /* Im(lambda_5) = */ 0.124948,
+      /* Re(m_{12}^2) = */ 2706.86,
+      /* tan(beta) = */ 4.64487,
+      /* Yukawa Type = */ 1}},
+    {ModelIDs::R2HDM,
+     {/* lambda_1 = */ 2.740595,
+      /* lambda_2 = */ 0.242356,
+      /* lambda_3 = */ 5.534491,
+      /* lambda_4 = */ -2.585467,
+      /* lambda_5 = */ -2.225991,
+      /* m_{12}^2 = */ 7738.56,
+      /* tan(beta) = */ 4.63286,
+      /* Yukawa Type = */ 1}},
+    {ModelIDs::N2HDM,
+     {/* lambda_1 = */ 0.300812,
+      /* lambda_2 = */ 0.321809,
+      /* lambda_3 = */ -0.133425,
+      /* lambda_4 = */ 4.11105,
+      /* lambda_5 = */ -3.84178,
+      /* lambda_6 = */ 9.46329,
+      /* lambda_7 = */ -0.750455,
+      /* lambda_8 = */ 0.743982,
+      /* tan(beta) = */ 5.91129,
+      /* v_s = */ 293.035,
+      /* m_{12}^2 = */ 4842.28,
+      /* Yukawa Type = */ 1}},
+    {ModelIDs::CXSM,
+     {/* vh = */ 246.219651,
+      /* vs = */ 540.51152,
+      /* va = */ 0,
+      /* ms = */ -10201.707997,
+      /* lambda = */ 0.516782,
+      /* delta2 = */ -0.037398,
+      /* b2 = */ -370585.40704,
+      /* d2 = */ 2.570175,
+      /* Reb1 = */ -3722.817741,
+      /* Imb1 = */ 0,
+      /* Rea1 = */ 0,
+      /* Ima1 = */ 0}},
+    {ModelIDs::CPINTHEDARK,
+     {/* m11s = */ -7823.7540500000005,
+      /* m22s = */ 242571.64899822656,
+      /* mSs = */ 109399.20176343,
+      /* ReA = */ 93.784159581909734,
+      /* ImA = */ 126.30387933116994,
+      /* L1 = */ 0.25810698810286969,
+      /* L2 = */ 4.6911643599657609,
+      /* L3 = */ -0.21517372505705856,
+      /* L4 = */ -0.42508424793839744,
+      /* L5 = */ -0.13790431680607695,
+      /* L6 = */ 15.075540949860104,
+      /* L7 = */ 6.7788372529237835,
+      /* L8 = */ -1.8651245632976341}},
+    {ModelIDs::SM,
+     {/* muSq = */ -7823.7540500000005,
+      /* lambda = */ 0.12905349405143487}},
+    {ModelIDs::TEMPLATE,
+     {/* ms = */ -7823.7540500000005,
+      /* lambda = */ 0.77432096430860922}}};
+
+/**
+ * @brief InitialisedModel returns the model initialised with its example point
+ */
+std::shared_ptr<BSMPT::Class_Potential_Origin> InitialisedModel(ModelIDs Model)
+{
+  using namespace BSMPT;
+  std::shared_ptr<Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(Model, GetSMConstants());
+  modelPointer->initModel(ExamplePoints.at(Model));
+  return modelPointer;
+}
+
+/**
+ * @brief FieldPoint field configuration of dimension NHiggs between the
+ * symmetric and the tree-level vacuum, so that no mass vanishes
+ */
+std::vector<double>
+FieldPoint(const std::shared_ptr<BSMPT::Class_Potential_Origin> &modelPointer)
+{
+  auto v = modelPointer->MinimizeOrderVEV(modelPointer->get_vevTreeMin());
+  for (std::size_t i = 0; i < v.size(); i++)
+  {
+    v.at(i) = 0.7 * v.at(i) + 3.0 * (i + 1);
+  }
+  return v;
+}
+
+const double BenchmarkTemperature = 100;
+} // namespace
+
+static void BM_VEff(benchmark::State &state, ModelIDs Model)
+{
+  const auto modelPointer = InitialisedModel(Model);
+  const auto v            = FieldPoint(modelPointer);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(modelPointer->VEff(v, BenchmarkTemperature));
+  }
+}
+
+static void BM_HiggsMassesSquared(benchmark::State &state, ModelIDs Model)
+{
+  const auto modelPointer = InitialisedModel(Model);
+  const auto v            = FieldPoint(modelPointer);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+        modelPointer->HiggsMassesSquared(v, BenchmarkTemperature));
+  }
+}
+
+static void BM_CalculateDebye(benchmark::State &state, ModelIDs Model)
+{
+  const auto modelPointer = InitialisedModel(Model);
+  for (auto _ : state)
+  {
+    modelPointer->CalculateDebye(true);
+    modelPointer->CalculateDebyeGauge();
+  }
+}
+
+static void BM_NablaNumerical(benchmark::State &state, ModelIDs Model)
+{
+  const auto modelPointer = InitialisedModel(Model);
+  const auto v            = FieldPoint(modelPointer);
+  const std::function<double(std::vector<double>)> V =
+      [&](const std::vector<double> &vev)
+  { return modelPointer->VEff(vev, BenchmarkTemperature); };
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(BSMPT::NablaNumerical(v, V, 1e-3));
+  }
+}
+
+static void BM_JbosonInterpolated(benchmark::State &state)
+{
+  const int diff = state.range(0);
+  for (auto _ : state)
+  {
+    for (double x = -0.5; x < 50; x += 0.25)
+    {
+      benchmark::DoNotOptimize(
+          BSMPT::ThermalFunctions::JbosonInterpolated(x, diff));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 202);
+}
+
+static void BM_JfermionInterpolated(benchmark::State &state)
+{
+  const int diff = state.range(0);
+  for (auto _ : state)
+  {
+    for (double x = 0; x < 50.5; x += 0.25)
+    {
+      benchmark::DoNotOptimize(
+          BSMPT::ThermalFunctions::JfermionInterpolated(x, diff));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 202);
+}
+
+#define BSMPT_BENCHMARK_ALL_MODELS(func)                                       \
+  BENCHMARK_CAPTURE(func, C2HDM, ModelIDs::C2HDM);                             \
+  BENCHMARK_CAPTURE(func, R2HDM, ModelIDs::R2HDM);                             \
+  BENCHMARK_CAPTURE(func, N2HDM, ModelIDs::N2HDM);                             \
+  BENCHMARK_CAPTURE(func, CXSM, ModelIDs::CXSM);                               \
+  BENCHMARK_CAPTURE(func, CPINTHEDARK, ModelIDs::CPINTHEDARK);                 \
+  BENCHMARK_CAPTURE(func, SM, ModelIDs::SM);                                   \
+  BENCHMARK_CAPTURE(func, TEMPLATE, ModelIDs::TEMPLATE)
+
+BSMPT_BENCHMARK_ALL_MODELS(BM_VEff);
+BSMPT_BENCHMARK_ALL_MODELS(BM_HiggsMassesSquared);
+BSMPT_BENCHMARK_ALL_MODELS(BM_CalculateDebye);
+BSMPT_BENCHMARK_ALL_MODELS(BM_NablaNumerical);
+BENCHMARK(BM_JbosonInterpolated)->Arg(0)->Arg(1);
+BENCHMARK(BM_JfermionInterpolated)->Arg(0)->Arg(1);
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file
+ * Benchmarks of the stages of the phase transition pipeline
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <BSMPT/bounce_solution/action_calculation.h>
+#include <BSMPT/gravitational_waves/gw.h>
+#include <BSMPT/minimizer/Minimizer.h>
+#include <BSMPT/minimum_tracer/minimum_tracer.h>
+#include <BSMPT/models/ClassPotentialOrigin.h> // for Class_Potential_Origin
+#include <BSMPT/models/IncludeAllModels.h>
+#include <BSMPT/transition_tracer/transition_tracer.h>
+
+namespace
+{
+const std::vector<double> example_point_SM{/* muSq = */ -7823.7540500000005,
+                                           /* lambda = */ 0.12905349405143487};
+}
+
+static void BM_TrackPhase(benchmark::State &state)
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::SM, SMConstants);
+  modelPointer->initModel(example_point_SM);
+  MinimumTracer MinTracer(
+      modelPointer, Minimizer::WhichMinimizerDefault, false);
+  const auto start =
+      modelPointer->MinimizeOrderVEV(modelPointer->get_vevTreeMin());
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(MinTracer.TrackPhase(start, 0, 150, 1, false));
+  }
+}
+
+static void BM_CalculateAction(benchmark::State &state)
+{
+  using namespace BSMPT;
+  std::function<double(std::vector<double>)> V = [](std::vector<double> x)
+  {
+    double r1 = x[0] * x[0] + 5 * x[1] * x[1];
+    double r2 = 5 * pow(x[0] - 1, 2) + pow(x[1] - 1, 2);
+    double r3 = 80 * (0.25 * pow(x[1], 4) - pow(x[1], 3) / 3.);
+    return (r1 * r2 + r3);
+  };
+  const std::vector<double> FalseVacuum{0, 0};
+  const std::vector<double> TrueVacuum{1, 1};
+  const std::vector<std::vector<double>> path{TrueVacuum, FalseVacuum};
+  for (auto _ : state)
+  {
+    BounceActionInt bc(path, TrueVacuum, FalseVacuum, V, 0, 6);
+    bc.CalculateAction();
+    benchmark::DoNotOptimize(bc.Action);
+  }
+}
+
+static void BM_GetSNR(benchmark::State &state)
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::SM, SMConstants);
+  modelPointer->initModel(example_point_SM);
+  user_input input;
+  input.modelPointer   = modelPointer;
+  input.gw_calculation = true;
+  TransitionTracer trans(input);
+  GravitationalWave gw(trans.ListBounceSolution.at(0));
+  gw.CalcPeakCollision();
+  gw.CalcPeakSoundWave();
+  gw.CalcPeakTurbulence();
+  gw.data.collisionON = true;
+  gw.data.swON        = true;
+  gw.data.turbON      = true;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(gw.GetSNR(1e-6, 10));
+  }
+}
+
+BENCHMARK(BM_TrackPhase)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CalculateAction)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GetSNR)->Unit(benchmark::kMillisecond);
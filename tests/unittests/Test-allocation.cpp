@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2021 Philipp Basler, Margarete Mühlleitner and Jonas
+// Müller
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file
+ * Counts the heap allocations of the one-loop potential. The global operator
+ * new is replaced for the whole test executable, allocations are only counted
+ * on the thread which enabled the counter.
+ */
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Approx = Catch::Approx;
+
+#include <BSMPT/models/ClassPotentialOrigin.h>
+#include <BSMPT/models/IncludeAllModels.h>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local bool CountAllocations         = false;
+thread_local std::size_t NumberAllocations = 0;
+
+/**
+ * @brief AllocationCounter counts the allocations of the calling thread during
+ * its lifetime
+ */
+class AllocationCounter
+{
+public:
+  AllocationCounter()
+  {
+    NumberAllocations = 0;
+    CountAllocations  = true;
+  }
+  ~AllocationCounter() { CountAllocations = false; }
+  std::size_t Stop()
+  {
+    CountAllocations = false;
+    return NumberAllocations;
+  }
+};
+
+const std::vector<double> example_point_C2HDM{/* lambda_1 = */ 3.29771,
+                                              /* lambda_2 = */ 0.274365,
+                                              /* lambda_3 = */ 4.71019,
+                                              /* lambda_4 = */ -2.23056,
+                                              /* Re(lambda_5) = */ -2.43487,
+                                              /* Im(lambda_5) = */ 0.124948,
+                                              /* Re(m_{12}^2) = */ 2706.86,
+                                              /* tan(beta) = */ 4.64487,
+                                              /* Yukawa Type = */ 1};
+} // namespace
+
+void *operator new(std::size_t size)
+{
+  if (CountAllocations) NumberAllocations++;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+TEST_CASE("Check that V1Loop does not allocate", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const std::vector<double> v{12, 25, 48, 110, 7, 195, 36, 15};
+  const std::vector<double> w{0, 0, 0, 0, 0, 246, 0, 0};
+  const double Temp = 80;
+
+  // the first calls size the buffers
+  const double expected_v = modelPointer->V1Loop(v, Temp, 0);
+  const double expected_w = modelPointer->V1Loop(w, 0, 0);
+  Class_Potential_Origin::MassSpectrumBuffers Buffers;
+  modelPointer->V1Loop(v, Temp, Buffers);
+
+  AllocationCounter Counter;
+  const double res_v         = modelPointer->V1Loop(v, Temp, 0);
+  const double res_w         = modelPointer->V1Loop(w, 0, 0);
+  const double res_buffers   = modelPointer->V1Loop(v, Temp, Buffers);
+  const std::size_t NumAlloc = Counter.Stop();
+
+  REQUIRE(NumAlloc == 0);
+  REQUIRE(res_v == expected_v);
+  REQUIRE(res_w == expected_w);
+  REQUIRE(res_buffers == expected_v);
+
+  // the allocating overload gives the same spectrum
+  modelPointer->HiggsMassesSquared(Buffers.Higgs, v, Temp);
+  const auto HiggsMasses = modelPointer->HiggsMassesSquared(v, Temp);
+  REQUIRE(Buffers.Higgs.size() == HiggsMasses.size());
+  for (std::size_t i = 0; i < HiggsMasses.size(); i++)
+  {
+    REQUIRE(Buffers.Higgs.at(i) == Approx(HiggsMasses.at(i)));
+  }
+}
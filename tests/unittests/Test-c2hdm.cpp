@@ -65,6 +65,268 @@ TEST_CASE("Checking NLOVEV for C2HDM", "[c2hdm]")
   }
 }
 
+TEST_CASE("Checking NLOVEV for C2HDM with the analytic gradient", "[c2hdm]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+  const int WhichMinimizer =
+      Minimizer::CalcWhichMinimizer(false, false, false, true);
+  std::vector<double> Check;
+  auto sol = Minimizer::Minimize_gen_all(modelPointer,
+                                         0,
+                                         Check,
+                                         modelPointer->get_vevTreeMin(),
+                                         WhichMinimizer);
+  for (std::size_t i{0}; i < sol.size(); ++i)
+  {
+    auto expected = std::abs(modelPointer->get_vevTreeMin(i));
+    auto res      = std::abs(sol.at(i));
+    REQUIRE(res == Approx(expected).margin(1e-4));
+  }
+
+  std::vector<double> start;
+  for (std::size_t i{0}; i < sol.size(); ++i)
+  {
+    start.push_back(modelPointer->get_vevTreeMin(i) + 5);
+  }
+  auto LocalMinima = Minimizer::FindNextLocalMinima(
+      modelPointer, start, 0, WhichMinimizer);
+  REQUIRE(LocalMinima.size() == 1);
+  for (std::size_t i{0}; i < sol.size(); ++i)
+  {
+    REQUIRE(LocalMinima.at(0).at(i) ==
+            Approx(modelPointer->get_vevTreeMin(i)).margin(1e-4));
+  }
+}
+
+TEST_CASE("Checking the seeding strategies of the GSL minimizer for C2HDM",
+          "[c2hdm]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+  const auto dim = modelPointer->get_nVEV();
+
+  Minimizer::GSL_MultistartOptions Multistart;
+  Multistart.WarmStarts.push_back(std::vector<double>(dim, 10));
+  Multistart.UseTreeLevelVacuum = true;
+  Multistart.SymmetryElements.push_back(-Eigen::MatrixXd::Identity(dim, dim));
+
+  for (auto Strategy : {Minimizer::GSLSeedingStrategy::Random,
+                        Minimizer::GSLSeedingStrategy::Halton,
+                        Minimizer::GSLSeedingStrategy::Sobol})
+  {
+    Multistart.Strategy = Strategy;
+    const auto StartingPoints =
+        Minimizer::GSL_StartingPoints(*modelPointer, 5, Multistart, 100);
+    REQUIRE(StartingPoints.size() == 103);
+    REQUIRE(StartingPoints.at(0) == Multistart.WarmStarts.at(0));
+    REQUIRE(StartingPoints.at(1) == modelPointer->get_vevTreeMin());
+    for (std::size_t i{0}; i < dim; ++i)
+    {
+      REQUIRE(StartingPoints.at(2).at(i) == -modelPointer->get_vevTreeMin(i));
+    }
+    for (const auto &point : StartingPoints)
+    {
+      REQUIRE(point.size() == dim);
+      for (const auto &el : point)
+      {
+        REQUIRE(std::abs(el) <= 500);
+      }
+    }
+    REQUIRE(StartingPoints ==
+            Minimizer::GSL_StartingPoints(*modelPointer, 5, Multistart, 100));
+
+    // The minima do not depend on the number of threads
+    std::vector<std::vector<double>> MinimaSerial, MinimaParallel;
+    auto sol = Minimizer::GSL_Minimize_gen_all(
+        *modelPointer, 0, 5, Multistart, MinimaSerial, 10, false);
+    Minimizer::GSL_Minimize_gen_all(
+        *modelPointer, 0, 5, Multistart, MinimaParallel, 10, true);
+    REQUIRE(sol.second);
+    REQUIRE(MinimaSerial == MinimaParallel);
+    for (std::size_t i{0}; i < dim; ++i)
+    {
+      REQUIRE(std::abs(sol.first.at(i)) ==
+              Approx(std::abs(modelPointer->get_vevTreeMin(i))).margin(1e-4));
+    }
+  }
+}
+
+TEST_CASE("Checking the clustering of the GSL minima for C2HDM", "[c2hdm]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+  const auto dim = modelPointer->get_nVEV();
+
+  // The potential is invariant under a sign flip of both doublets
+  Minimizer::GSL_MultistartOptions Multistart;
+  Multistart.UseTreeLevelVacuum = true;
+  Multistart.SymmetryElements.push_back(-Eigen::MatrixXd::Identity(dim, dim));
+  Multistart.ClusterMinima              = true;
+  Multistart.MaxStartsWithoutNewMinimum = 20;
+
+  std::vector<std::vector<double>> MinimaSerial, MinimaParallel;
+  auto sol = Minimizer::GSL_Minimize_gen_all(
+      *modelPointer, 0, 5, Multistart, MinimaSerial, 50, false);
+  Minimizer::GSL_Minimize_gen_all(
+      *modelPointer, 0, 5, Multistart, MinimaParallel, 50, true);
+  REQUIRE(sol.second);
+  REQUIRE(MinimaSerial == MinimaParallel);
+  REQUIRE(MinimaSerial.size() < 50);
+
+  // the tree-level vacuum and its image are the same minimum
+  REQUIRE(MinimaSerial.at(0).at(dim + 2) >= 2);
+  for (std::size_t i{0}; i < MinimaSerial.size(); ++i)
+  {
+    const std::vector<double> a(MinimaSerial.at(i).begin(),
+                                MinimaSerial.at(i).begin() + dim);
+    for (std::size_t j{i + 1}; j < MinimaSerial.size(); ++j)
+    {
+      const std::vector<double> b(MinimaSerial.at(j).begin(),
+                                  MinimaSerial.at(j).begin() + dim);
+      REQUIRE(Minimizer::GSL_MinimumDistance(
+                  a, b, Multistart.SymmetryElements) >
+              Multistart.BasinTolerance);
+    }
+  }
+  for (std::size_t i{0}; i < dim; ++i)
+  {
+    REQUIRE(std::abs(sol.first.at(i)) ==
+            Approx(std::abs(modelPointer->get_vevTreeMin(i))).margin(1e-4));
+  }
+
+  // in the order of completion the global minimum is found as well
+  Multistart.DeterministicOrder = false;
+  std::vector<std::vector<double>> MinimaUnordered;
+  auto solUnordered = Minimizer::GSL_Minimize_gen_all(
+      *modelPointer, 0, 5, Multistart, MinimaUnordered, 50, true);
+  REQUIRE(solUnordered.second);
+  for (std::size_t i{0}; i < dim; ++i)
+  {
+    REQUIRE(std::abs(solUnordered.first.at(i)) ==
+            Approx(std::abs(modelPointer->get_vevTreeMin(i))).margin(1e-4));
+  }
+}
+
+TEST_CASE("Checking the minimizer budget for C2HDM", "[c2hdm]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+  const auto dim         = modelPointer->get_nVEV();
+  const int UseGSLOnly   = Minimizer::CalcWhichMinimizer(true, false, false);
+  const double VSymmetry = modelPointer->VEff(
+      std::vector<double>(modelPointer->get_NHiggs(), 0), 0);
+
+  Minimizer::MinimizerBudget Budget;
+  Budget.MaxEvaluations = 300;
+  Minimizer::MinimizerBudgetTracker EvaluationTracker(Budget);
+  std::vector<double> Check;
+  auto sol = Minimizer::Minimize_gen_all(modelPointer,
+                                         0,
+                                         Check,
+                                         std::vector<double>(dim, 0),
+                                         UseGSLOnly,
+                                         false,
+                                         Minimizer::GSL_MultistartOptions(),
+                                         &EvaluationTracker);
+  REQUIRE(EvaluationTracker.GetStatus() ==
+          Minimizer::MinimizerBudgetStatus::EvaluationsExhausted);
+  // the running simplex iteration is finished after the budget is used up
+  REQUIRE(EvaluationTracker.GetEvaluations() < Budget.MaxEvaluations + 10);
+  REQUIRE(sol.size() == dim);
+  REQUIRE(modelPointer->VEff(modelPointer->MinimizeOrderVEV(sol), 0) <=
+          VSymmetry);
+
+  Budget                = Minimizer::MinimizerBudget();
+  Budget.MaxSeconds     = 1e-9;
+  Minimizer::MinimizerBudgetTracker TimeTracker(Budget);
+  Check.clear();
+  sol = Minimizer::Minimize_gen_all(modelPointer,
+                                    0,
+                                    Check,
+                                    std::vector<double>(dim, 0),
+                                    UseGSLOnly,
+                                    true,
+                                    Minimizer::GSL_MultistartOptions(),
+                                    &TimeTracker);
+  REQUIRE(TimeTracker.GetStatus() ==
+          Minimizer::MinimizerBudgetStatus::TimeExhausted);
+  REQUIRE(sol.size() == dim);
+
+  // without limits the minimizers converge as before
+  Minimizer::MinimizerBudgetTracker Unlimited{Minimizer::MinimizerBudget()};
+  Check.clear();
+  sol = Minimizer::Minimize_gen_all(modelPointer,
+                                    0,
+                                    Check,
+                                    std::vector<double>(dim, 0),
+                                    UseGSLOnly,
+                                    true,
+                                    Minimizer::GSL_MultistartOptions(),
+                                    &Unlimited);
+  REQUIRE(Unlimited.GetStatus() ==
+          Minimizer::MinimizerBudgetStatus::WithinBudget);
+  REQUIRE(Unlimited.GetEvaluations() > 0);
+  for (std::size_t i{0}; i < dim; ++i)
+  {
+    REQUIRE(std::abs(sol.at(i)) ==
+            Approx(std::abs(modelPointer->get_vevTreeMin(i))).margin(1e-2));
+  }
+}
+
+TEST_CASE("Checking the Newton refinement of the C2HDM minimum", "[c2hdm]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+  const auto dim = modelPointer->get_nVEV();
+
+  std::vector<double> Check;
+  const auto sol = Minimizer::Minimize_gen_all(
+      modelPointer, 0, Check, std::vector<double>(dim, 0));
+  REQUIRE(Check.back() ==
+          static_cast<double>(Minimizer::StationaryPointType::Minimum));
+
+  // Newton steps from a displaced point lead back to the minimum
+  auto displaced = sol;
+  for (auto &v : displaced)
+  {
+    v += 1;
+  }
+  const auto Refined =
+      Minimizer::RefineStationaryPoint(*modelPointer, displaced, 0);
+  REQUIRE(Refined.Type == Minimizer::StationaryPointType::Minimum);
+  REQUIRE(Refined.Converged);
+  REQUIRE(Refined.Iterations > 0);
+  REQUIRE(Refined.Eigenvalues.size() == dim);
+  REQUIRE(Refined.Eigenvalues.front() > 0);
+  for (std::size_t i{0}; i < dim; ++i)
+  {
+    REQUIRE(Refined.Point.at(i) == Approx(sol.at(i)).margin(1e-3));
+  }
+
+  // The symmetric point is a stationary point but not a minimum at T = 0
+  const auto Symmetric = Minimizer::RefineStationaryPoint(
+      *modelPointer, std::vector<double>(dim, 0), 0);
+  REQUIRE(Symmetric.Iterations == 0);
+  REQUIRE(Symmetric.Type != Minimizer::StationaryPointType::Minimum);
+  REQUIRE(Symmetric.Point == std::vector<double>(dim, 0));
+}
+
 TEST_CASE("Checking EWPT for C2HDM", "[c2hdm]")
 {
   using namespace BSMPT;
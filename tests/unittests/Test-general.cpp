@@ -44,11 +44,16 @@ TEST_CASE("Check calculating of minimizer selection", "[general]")
     {
       for (const auto &nlopt : {true, false})
       {
-        auto whichMin = BSMPT::Minimizer::CalcWhichMinimizer(gsl, cmaes, nlopt);
-        auto minToUse = BSMPT::Minimizer::GetMinimizers(whichMin);
-        REQUIRE(minToUse.UseCMAES == cmaes);
-        REQUIRE(minToUse.UseGSL == gsl);
-        REQUIRE(minToUse.UseNLopt == nlopt);
+        for (const auto &gslgradient : {true, false})
+        {
+          auto whichMin = BSMPT::Minimizer::CalcWhichMinimizer(
+              gsl, cmaes, nlopt, gslgradient);
+          auto minToUse = BSMPT::Minimizer::GetMinimizers(whichMin);
+          REQUIRE(minToUse.UseCMAES == cmaes);
+          REQUIRE(minToUse.UseGSL == gsl);
+          REQUIRE(minToUse.UseNLopt == nlopt);
+          REQUIRE(minToUse.UseGSLGradient == gslgradient);
+        }
       }
     }
   }
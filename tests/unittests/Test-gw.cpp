@@ -18,6 +18,7 @@ using Approx = Catch::Approx;
 #include <BSMPT/models/modeltests/ModelTestfunctions.h>
 #include <BSMPT/transition_tracer/transition_tracer.h>
 #include <BSMPT/utility/Logger.h> // for Logger Class
+#include <BSMPT/utility/ThreadPool.h>
 #include <fstream>
 #include <gsl/gsl_sf_expint.h>
 
@@ -441,6 +442,101 @@ TEST_CASE("Checking phase tracking for BP1 - Mode auto", "[gw]")
   REQUIRE(vac.PhasesList.size() == 2);
 }
 
+TEST_CASE("Checking predictor-corrector phase tracking for BP1", "[gw]")
+{
+  const std::vector<double> example_point_R2HDM{
+      /* lambda_1 = */ 6.9309437685026,
+      /* lambda_2 = */ 0.26305141403285998,
+      /* lambda_3 = */ 1.2865950045595,
+      /* lambda_4 = */ 4.7721306931875001,
+      /* lambda_5 = */ 4.7275722046239004,
+      /* m_{12}^2 = */ 18933.440789693999,
+      /* tan(beta) = */ 16.577896825227999,
+      /* Yukawa Type = */ 1};
+
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::R2HDM, SMConstants);
+  modelPointer->initModel(example_point_R2HDM);
+
+  std::shared_ptr<MinimumTracer> MinTracer(
+      new MinimumTracer(modelPointer, Minimizer::WhichMinimizerDefault, false));
+  const auto start = MinTracer->ConvertToVEVDim(MinTracer->GetGlobalMinimum(0));
+
+  const auto Stepwise = MinTracer->TrackPhase(start, 0, 300, 1, false);
+  MinTracer->UsePredictorCorrector = true;
+  const auto Predicted = MinTracer->TrackPhase(start, 0, 300, 1, false);
+
+  // Both end where the broken phase disappears, with far fewer minima
+  REQUIRE(Predicted.size() * 4 < Stepwise.size());
+  REQUIRE(Predicted.back().temp == Approx(Stepwise.back().temp).margin(1e-2));
+
+  for (const auto &min : Predicted)
+  {
+    // Every stored point is a minimum
+    const auto gradient = MinTracer->GradientVEVSpace(
+        min.point, min.temp, 1 + min.temp * min.temp);
+    REQUIRE(L2NormVector(gradient) < 1e-6);
+
+    // Away from the end it agrees with the stepwise tracing
+    if (min.temp > Stepwise.back().temp - 10) continue;
+    const auto upper = std::upper_bound(Stepwise.begin(), Stepwise.end(), min);
+    if (upper == Stepwise.begin() or upper == Stepwise.end()) continue;
+    const auto lower = std::prev(upper);
+    const double t   = (min.temp - lower->temp) / (upper->temp - lower->temp);
+    const auto interpolated = (1 - t) * lower->point + t * upper->point;
+    REQUIRE(L2NormVector(min.point - interpolated) < 0.1);
+  }
+}
+
+TEST_CASE("Checking interpolation of a traced phase for BP1", "[gw]")
+{
+  const std::vector<double> example_point_R2HDM{
+      /* lambda_1 = */ 6.9309437685026,
+      /* lambda_2 = */ 0.26305141403285998,
+      /* lambda_3 = */ 1.2865950045595,
+      /* lambda_4 = */ 4.7721306931875001,
+      /* lambda_5 = */ 4.7275722046239004,
+      /* m_{12}^2 = */ 18933.440789693999,
+      /* tan(beta) = */ 16.577896825227999,
+      /* Yukawa Type = */ 1};
+
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::R2HDM, SMConstants);
+  modelPointer->initModel(example_point_R2HDM);
+
+  std::shared_ptr<MinimumTracer> MinTracer(
+      new MinimumTracer(modelPointer, Minimizer::WhichMinimizerDefault, false));
+  const auto start = MinTracer->ConvertToVEVDim(MinTracer->GetGlobalMinimum(0));
+  Phase phase(start, 0, 300, MinTracer);
+  REQUIRE(phase.MinimumPhaseVector.size() > 2);
+
+  const std::size_t NumberOfMinima = phase.MinimumPhaseVector.size();
+  for (double T = 0.25; T < phase.T_high - 10; T += 10)
+  {
+    double error     = 0;
+    const auto guess = phase.Interpolate(T, error);
+    REQUIRE(error <= phase.InterpolationTolerance);
+
+    // Agrees with the minimum traced to T
+    const auto lower = std::prev(std::upper_bound(
+        phase.MinimumPhaseVector.begin(), phase.MinimumPhaseVector.end(),
+        guess));
+    const auto traced = MinTracer->TrackPhase(
+        lower->point, lower->temp, T, T - lower->temp, false, true);
+    REQUIRE(traced.back().temp == Approx(T));
+    REQUIRE(L2NormVector(guess.point - traced.back().point) <= 1e-2);
+    REQUIRE(guess.potential == Approx(traced.back().potential).epsilon(1e-5));
+
+    // Get returns the interpolant without tracing again
+    REQUIRE(L2NormVector(phase.Get(T).point - guess.point) == 0);
+  }
+  REQUIRE(phase.MinimumPhaseVector.size() == NumberOfMinima);
+}
+
 TEST_CASE("Checking phase tracking for BP1 - Mode 0", "[gw]")
 {
   const std::vector<double> example_point_R2HDM{
@@ -540,6 +636,47 @@ TEST_CASE("Checking phase tracking for BP2 - Mode auto", "[gw]")
   REQUIRE(vac.PhasesList.size() == 2);
 }
 
+TEST_CASE("Checking phase discovery is independent of the thread count",
+          "[gw]")
+{
+  const std::vector<double> example_point_R2HDM{
+      /* lambda_1 = */ 6.8467197321288999,
+      /* lambda_2 = */ 0.25889890874393001,
+      /* lambda_3 = */ 1.4661775278406,
+      /* lambda_4 = */ 4.4975594646125998,
+      /* lambda_5 = */ 4.4503516057569996,
+      /* m_{12}^2 = */ 6629.9728323804002,
+      /* tan(beta) = */ 45.319927369307997,
+      /* Yukawa Type = */ 1};
+
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::R2HDM, SMConstants);
+  modelPointer->initModel(example_point_R2HDM);
+
+  auto TracePhases = [&](int Concurrency)
+  {
+    ThreadPool::SetGlobalConcurrency(Concurrency);
+    std::shared_ptr<MinimumTracer> MinTracer(new MinimumTracer(
+        modelPointer, Minimizer::WhichMinimizerDefault, false));
+    Vacuum vac(0, 300, MinTracer, modelPointer, -1, 10, true);
+    return vac.PhasesList;
+  };
+
+  const auto Serial   = TracePhases(1);
+  const auto Parallel = TracePhases(4);
+  ThreadPool::SetGlobalConcurrency(0);
+
+  REQUIRE(Serial.size() == 2);
+  REQUIRE(Parallel.size() == Serial.size());
+  for (std::size_t i = 0; i < Serial.size(); i++)
+  {
+    REQUIRE(Parallel.at(i).T_low == Approx(Serial.at(i).T_low).margin(1e-3));
+    REQUIRE(Parallel.at(i).T_high == Approx(Serial.at(i).T_high).margin(1e-3));
+  }
+}
+
 TEST_CASE("Checking phase tracking for BP2 - Mode 0", "[gw]")
 {
   const std::vector<double> example_point_R2HDM{
@@ -18,6 +18,7 @@ using Approx = Catch::Approx;
 #include <BSMPT/models/IncludeAllModels.h>
 #include <BSMPT/models/modeltests/ModelTestfunctions.h>
 #include <BSMPT/utility/Logger.h>
+#include <thread>
 namespace
 {
 
@@ -120,4 +121,337 @@ TEST_CASE("Check f_{abcd}", "[origin]")
         0, std::pow(100, 2), std::pow(200, 2), std::pow(50, 2));
     REQUIRE(result == Approx(expected).margin(1e-4));
   }
-}
\ No newline at end of file
+}
+TEST_CASE("Check VEffBatch against VEff", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const auto NHiggs = modelPointer->get_NHiggs();
+  std::vector<std::vector<double>> vevs;
+  vevs.push_back(
+      modelPointer->MinimizeOrderVEV(modelPointer->get_vevTreeMin()));
+  vevs.push_back(std::vector<double>(NHiggs, 0));
+  for (std::size_t p = 0; p < 5; p++)
+  {
+    std::vector<double> v(NHiggs);
+    for (std::size_t i = 0; i < NHiggs; i++)
+      v.at(i) = 40.0 * std::sin(1.3 * (p + 1) + 0.7 * i) * (p + 1);
+    vevs.push_back(v);
+  }
+  std::vector<double> points;
+  for (const auto &v : vevs)
+    points.insert(points.end(), v.begin(), v.end());
+
+  for (const double Temp : {0.0, 120.0})
+  {
+    for (const int Order : {0, 1})
+    {
+      std::vector<double> batch;
+      modelPointer->VEffBatch(points, Temp, batch, Order);
+      REQUIRE(batch.size() == vevs.size());
+      for (std::size_t p = 0; p < vevs.size(); p++)
+      {
+        REQUIRE(batch.at(p) ==
+                Approx(modelPointer->VEff(vevs.at(p), Temp, 0, Order))
+                    .epsilon(1e-10)
+                    .margin(1e-6));
+      }
+    }
+  }
+
+  std::vector<double> batch;
+  REQUIRE_THROWS_AS(modelPointer->VEffBatch(
+                        std::vector<double>(NHiggs + 1, 0), 0, batch),
+                    std::runtime_error);
+}
+
+TEST_CASE("Check VEffGradient against numerical derivatives", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  // slightly displaced from the EW minimum to have a non-vanishing gradient
+  const auto &VevOrder = modelPointer->Get_VevOrder();
+  auto v = modelPointer->MinimizeOrderVEV(modelPointer->get_vevTreeMin());
+  v.at(VevOrder.at(0)) += 4;
+  v.at(VevOrder.at(1)) -= 6;
+  v.at(VevOrder.at(2)) += 2;
+  const double eps = 1e-3;
+
+  for (const double Temp : {0.0, 120.0})
+  {
+    const auto gradient = modelPointer->VEffGradient(v, Temp);
+    REQUIRE(gradient.size() == modelPointer->get_NHiggs());
+
+    for (std::size_t i = 0; i < gradient.size(); i++)
+    {
+      const double perDirection = modelPointer->VEff(v, Temp, i + 1);
+      REQUIRE(gradient.at(i) ==
+              Approx(perDirection).epsilon(1e-6).margin(1e-6));
+    }
+
+    // VTreeSimplified only depends on the VEV directions
+    for (const auto &i : VevOrder)
+    {
+      auto vp = v, vm = v;
+      vp.at(i) += eps;
+      vm.at(i) -= eps;
+      const double numerical =
+          (modelPointer->VEff(vp, Temp) - modelPointer->VEff(vm, Temp)) /
+          (2 * eps);
+      REQUIRE(gradient.at(i) == Approx(numerical).epsilon(1e-5).margin(1e-2));
+    }
+  }
+}
+
+TEST_CASE("Check VEffHessian against numerical derivatives", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const std::size_t NHiggs = modelPointer->get_NHiggs();
+
+  // a generic point and the symmetric point with degenerate masses. At the
+  // latter the stencil has to keep the fermion masses above the threshold for
+  // vanishing masses and converges slowly due to the m^4 log(m^2) terms.
+  const std::vector<std::vector<double>> points{
+      {12, 25, 48, 110, 7, 195, 36, 15}, std::vector<double>(NHiggs, 0)};
+  const std::vector<double> steps{1e-3, 1e-2};
+  const std::vector<double> margins{1e-1, 5e-1};
+  for (std::size_t p = 0; p < points.size(); p++)
+  {
+    const auto &v    = points.at(p);
+    const double eps = steps.at(p);
+    for (const double Temp : {0.0, 100.0})
+    {
+      const auto Hessian = modelPointer->VEffHessian(v, Temp);
+      REQUIRE(static_cast<std::size_t>(Hessian.rows()) == NHiggs);
+      REQUIRE(static_cast<std::size_t>(Hessian.cols()) == NHiggs);
+
+      for (std::size_t j = 0; j < NHiggs; j++)
+      {
+        auto vp = v, vm = v;
+        vp.at(j) += eps;
+        vm.at(j) -= eps;
+        const auto gp = modelPointer->VEffGradient(vp, Temp);
+        const auto gm = modelPointer->VEffGradient(vm, Temp);
+        for (std::size_t i = 0; i < NHiggs; i++)
+        {
+          const double numerical = (gp.at(i) - gm.at(i)) / (2 * eps);
+          REQUIRE(Hessian(i, j) ==
+                  Approx(numerical).epsilon(1e-4).margin(margins.at(p)));
+          REQUIRE(Hessian(i, j) == Approx(Hessian(j, i)).margin(1e-6));
+        }
+      }
+    }
+  }
+
+  // the tree-level Hessian is the Higgs mass matrix
+  const auto TreeHessian = modelPointer->VEffHessian(points.front(), 0, 0);
+  const auto MassMatrix  = modelPointer->HiggsMassMatrix(points.front(), 0);
+  REQUIRE((TreeHessian - MassMatrix).norm() == Approx(0).margin(1e-8));
+}
+
+TEST_CASE("Check packed mass matrices against the curvature tensors",
+          "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const std::size_t NHiggs = modelPointer->get_NHiggs();
+  const std::vector<double> v{12, 25, 48, 110, 7, 195, 36, 15};
+  const double Temp = 80;
+
+  const auto &L2    = modelPointer->Get_Curvature_Higgs_L2();
+  const auto &L3    = modelPointer->Get_Curvature_Higgs_L3();
+  const auto &L4    = modelPointer->Get_Curvature_Higgs_L4();
+  const auto &Debye = modelPointer->get_DebyeHiggs();
+  const auto Higgs  = modelPointer->HiggsMassMatrix(v, Temp);
+  for (std::size_t i = 0; i < NHiggs; i++)
+  {
+    for (std::size_t j = 0; j < NHiggs; j++)
+    {
+      double expected = L2[i][j] + Debye[i][j] * std::pow(Temp, 2);
+      for (std::size_t k = 0; k < NHiggs; k++)
+      {
+        expected += L3[i][j][k] * v[k];
+        for (std::size_t l = 0; l < NHiggs; l++)
+        {
+          expected += 0.5 * L4[i][j][k][l] * v[k] * v[l];
+        }
+      }
+      REQUIRE(Higgs(i, j) == Approx(expected).margin(1e-8));
+    }
+  }
+
+  const std::size_t NGauge = modelPointer->get_NGauge();
+  const auto &G2H2         = modelPointer->Get_Curvature_Gauge_G2H2();
+  const auto Gauge         = modelPointer->GaugeMassMatrix(v);
+  for (std::size_t a = 0; a < NGauge; a++)
+  {
+    for (std::size_t b = 0; b < NGauge; b++)
+    {
+      double expected = 0;
+      for (std::size_t i = 0; i < NHiggs; i++)
+      {
+        for (std::size_t j = 0; j < NHiggs; j++)
+        {
+          expected += 0.5 * G2H2[a][b][i][j] * v[i] * v[j];
+        }
+      }
+      REQUIRE(Gauge(a, b) == Approx(expected).margin(1e-8));
+    }
+  }
+}
+
+TEST_CASE("Check prepared model snapshot", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  REQUIRE_THROWS_AS(modelPointer->Prepare(), std::runtime_error);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const std::vector<double> v{12, 25, 48, 110, 7, 195, 36, 15};
+  const double Temp     = 80;
+  const double expected = modelPointer->VEff(v, Temp);
+  const auto snapshot   = modelPointer->Prepare();
+  REQUIRE(snapshot->get_Model() == modelPointer->get_Model());
+  REQUIRE(snapshot->get_parStored() == modelPointer->get_parStored());
+  REQUIRE(snapshot->VEff(v, Temp) == expected);
+
+  // the snapshot keeps its parameter point
+  auto other_point = example_point_C2HDM;
+  other_point.at(0) += 0.5;
+  modelPointer->initModel(other_point);
+  REQUIRE(modelPointer->VEff(v, Temp) != Approx(expected));
+  REQUIRE(snapshot->VEff(v, Temp) == expected);
+
+  // concurrent evaluations of the same snapshot
+  std::vector<double> results(4);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < results.size(); i++)
+  {
+    threads.emplace_back(
+        [&, i]()
+        {
+          for (int k = 0; k < 20; k++)
+          {
+            results.at(i) = snapshot->VEff(v, Temp);
+          }
+        });
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  for (const auto &res : results)
+  {
+    REQUIRE(res == expected);
+  }
+}
+
+TEST_CASE("Check mass spectrum cache", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const std::vector<double> v{12, 25, 48, 110, 7, 195, 36, 15};
+  const double Temp      = 80;
+  const double expected  = modelPointer->VEff(v, Temp);
+  const auto HiggsMasses = modelPointer->HiggsMassesSquared(v, Temp);
+
+  Class_Potential_Origin::ResetMassCacheStatistics();
+  REQUIRE(not modelPointer->GetUseMassCache());
+  modelPointer->SetUseMassCache(true);
+  REQUIRE(modelPointer->VEff(v, Temp) == expected);
+  auto Statistics = Class_Potential_Origin::GetMassCacheStatistics();
+  REQUIRE(Statistics.Hits == 0);
+  REQUIRE(Statistics.Misses > 0);
+
+  REQUIRE(modelPointer->VEff(v, Temp) == expected);
+  REQUIRE(modelPointer->HiggsMassesSquared(v, Temp) == HiggsMasses);
+  const auto Misses = Statistics.Misses;
+  Statistics        = Class_Potential_Origin::GetMassCacheStatistics();
+  REQUIRE(Statistics.Misses == Misses);
+  REQUIRE(Statistics.Hits == Misses + 1);
+
+  // derivatives are not cached
+  modelPointer->HiggsMassesSquared(v, Temp, 1);
+  REQUIRE(Class_Potential_Origin::GetMassCacheStatistics().Hits ==
+          Statistics.Hits);
+
+  // a new parameter point invalidates the cache
+  auto other_point = example_point_C2HDM;
+  other_point.at(0) += 0.5;
+  modelPointer->initModel(other_point);
+  modelPointer->SetUseMassCache(false);
+  const double expected_other = modelPointer->VEff(v, Temp);
+  modelPointer->SetUseMassCache(true, 1);
+  REQUIRE(modelPointer->VEff(v, Temp) == expected_other);
+  REQUIRE(modelPointer->VEff(v, Temp) == expected_other);
+
+  modelPointer->SetUseMassCache(false);
+  Class_Potential_Origin::ResetMassCacheStatistics();
+  REQUIRE(Class_Potential_Origin::GetMassCacheStatistics().Hits == 0);
+}
+
+TEST_CASE("Check fixed-size mass spectra against dynamic matrices", "[origin]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<BSMPT::Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::C2HDM, SMConstants);
+  modelPointer->initModel(example_point_C2HDM);
+
+  const std::vector<double> v{12, 25, 48, 110, 7, 195, 36, 15};
+  const double Temp = 80;
+
+  auto Compare = [](const std::vector<double> &calculated,
+                    const Eigen::VectorXd &expected,
+                    const double &ZeroMass)
+  {
+    REQUIRE(calculated.size() == static_cast<std::size_t>(expected.size()));
+    for (std::size_t i = 0; i < calculated.size(); i++)
+    {
+      const double value = std::abs(expected[i]) < ZeroMass ? 0 : expected[i];
+      REQUIRE(calculated.at(i) == Approx(value).epsilon(1e-10).margin(1e-8));
+    }
+  };
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> Boson(
+      modelPointer->HiggsMassMatrix(v, Temp), Eigen::EigenvaluesOnly);
+  Compare(
+      modelPointer->HiggsMassesSquared(v, Temp), Boson.eigenvalues(), 1e-5);
+
+  Boson.compute(modelPointer->GaugeMassMatrix(v, Temp),
+                Eigen::EigenvaluesOnly);
+  Compare(
+      modelPointer->GaugeMassesSquared(v, Temp), Boson.eigenvalues(), 1e-5);
+
+  Eigen::MatrixXcd MIJ = modelPointer->QuarkMassMatrix(v);
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> Fermion(
+      MIJ.conjugate() * MIJ, Eigen::EigenvaluesOnly);
+  Compare(modelPointer->QuarkMassesSquared(v), Fermion.eigenvalues(), 1e-10);
+
+  MIJ = modelPointer->LeptonMassMatrix(v);
+  Fermion.compute(MIJ.conjugate() * MIJ, Eigen::EigenvaluesOnly);
+  Compare(modelPointer->LeptonMassesSquared(v), Fermion.eigenvalues(), 1e-10);
+}
@@ -461,3 +461,34 @@ TEST_CASE("Check symmetric properties of the quark tensor in the R2HDM",
           ModelTests::CheckSymmetricTensorQuarksThird(
               modelPointer->Get_Curvature_Quark_F2H1()));
 }
+
+TEST_CASE("Checking VEffBatch for R2HDM", "[r2hdm]")
+{
+  using namespace BSMPT;
+  const auto SMConstants = GetSMConstants();
+  std::shared_ptr<Class_Potential_Origin> modelPointer =
+      ModelID::FChoose(ModelID::ModelIDs::R2HDM, SMConstants);
+  modelPointer->initModel(example_point_R2HDM);
+
+  const auto NHiggs = modelPointer->get_NHiggs();
+  std::vector<double> points;
+  for (std::size_t p = 0; p < 6; p++)
+  {
+    for (std::size_t i = 0; i < NHiggs; i++)
+      points.push_back(50.0 * std::cos(0.9 * (p + 1) + 1.1 * i) * (p + 1));
+  }
+
+  for (const double Temp : {0.0, 150.0})
+  {
+    std::vector<double> batch;
+    modelPointer->VEffBatch(points, Temp, batch);
+    REQUIRE(batch.size() == 6);
+    for (std::size_t p = 0; p < batch.size(); p++)
+    {
+      const std::vector<double> v(points.begin() + p * NHiggs,
+                                  points.begin() + (p + 1) * NHiggs);
+      REQUIRE(batch.at(p) ==
+              Approx(modelPointer->VEff(v, Temp)).epsilon(1e-10).margin(1e-6));
+    }
+  }
+}
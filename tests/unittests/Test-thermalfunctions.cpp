@@ -7,6 +7,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 using Approx = Catch::Approx;
+#include <BSMPT/ThermalFunctions/ThermalFunctions.h>
 #include <BSMPT/ThermalFunctions/thermalcoefficientcalculator.h>
 #include <cmath>
 #include <gsl/gsl_sf_gamma.h>
@@ -98,3 +99,84 @@ TEST_CASE("Check JInterpolatedHighCoefficientCalculator", "[thermal]")
                 el.first) == Approx(el.second).margin(1e-4));
   }
 }
+
+TEST_CASE("Check derivatives of the interpolated thermal functions",
+          "[thermal]")
+{
+  using namespace BSMPT::ThermalFunctions;
+  // points away from the matching points of the separate interpolations and
+  // from the knots of the spline for x < 0
+  const std::vector<double> points{
+      -300, -45, -5, -0.3, 0.05, 0.7, 1.5, 4, 8, 20, 60};
+  for (const auto &x : points)
+  {
+    const double h = 1e-5 * std::max(1.0, std::abs(x));
+    const double dBoson =
+        (JbosonInterpolated(x + h) - JbosonInterpolated(x - h)) / (2 * h);
+    const double ddBoson =
+        (JbosonInterpolated(x + h, 1) - JbosonInterpolated(x - h, 1)) /
+        (2 * h);
+    REQUIRE(JbosonInterpolated(x, 1) ==
+            Approx(dBoson).epsilon(1e-5).margin(1e-9));
+    REQUIRE(JbosonInterpolated(x, 2) ==
+            Approx(ddBoson).epsilon(1e-4).margin(1e-9));
+    if (x > 0)
+    {
+      const double dFermion =
+          (JfermionInterpolated(x + h) - JfermionInterpolated(x - h)) / (2 * h);
+      const double ddFermion =
+          (JfermionInterpolated(x + h, 1) - JfermionInterpolated(x - h, 1)) /
+          (2 * h);
+      REQUIRE(JfermionInterpolated(x, 1) ==
+              Approx(dFermion).epsilon(1e-5).margin(1e-9));
+      REQUIRE(JfermionInterpolated(x, 2) ==
+              Approx(ddFermion).epsilon(1e-4).margin(1e-9));
+    }
+  }
+}
+
+TEST_CASE("Check interpolated derivatives against numerical integration",
+          "[thermal]")
+{
+  using namespace BSMPT::ThermalFunctions;
+  for (const auto &x : std::vector<double>{0.05, 0.7, 1.5, 100, 400})
+  {
+    REQUIRE(JbosonInterpolated(x, 1) ==
+            Approx(JbosonNumericalIntegration(x, 1)).epsilon(1e-3));
+    REQUIRE(JfermionInterpolated(x, 1) ==
+            Approx(JfermionNumericalIntegration(x, 1)).epsilon(1e-3));
+  }
+}
+
+TEST_CASE("Check batch evaluation of the interpolated thermal functions",
+          "[thermal]")
+{
+  using namespace BSMPT::ThermalFunctions;
+  const std::vector<double> points{-500,
+                                   -12.3,
+                                   -0.01,
+                                   0,
+                                   1e-6,
+                                   0.4,
+                                   C_FermionTheta,
+                                   5,
+                                   C_BosonTheta,
+                                   30,
+                                   250};
+  const Eigen::ArrayXd x =
+      Eigen::Map<const Eigen::ArrayXd>(points.data(), points.size());
+  const auto Boson   = JbosonInterpolatedBatch(x);
+  const auto Fermion = JfermionInterpolatedBatch(x);
+  REQUIRE(Boson.size() == x.size());
+  for (Eigen::Index i = 0; i < x.size(); i++)
+  {
+    REQUIRE(Boson(i) ==
+            Approx(JbosonInterpolated(x(i))).epsilon(1e-12).margin(1e-12));
+    if (x(i) >= 0)
+    {
+      REQUIRE(Fermion(i) == Approx(JfermionInterpolated(x(i)))
+                                .epsilon(1e-12)
+                                .margin(1e-12));
+    }
+  }
+}
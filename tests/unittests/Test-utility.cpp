@@ -10,7 +10,14 @@
 
 using Approx = Catch::Approx;
 
+#include <BSMPT/utility/ParallelLineProcessor.h>
+#include <BSMPT/utility/Profiler.h>
+#include <BSMPT/utility/ThreadPool.h>
 #include <BSMPT/utility/utility.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 TEST_CASE("Check ModelID name generation", "[utility]")
 {
@@ -1408,4 +1415,202 @@ TEST_CASE("Check Incomplete elliptic integral of the second kind", "[utility]")
   REQUIRE(EllipIntSecond(9.98) == Approx(15266.05734).margin(1e-10));
   REQUIRE(EllipIntSecond(9.99) == Approx(15419.48979).margin(1e-10));
   REQUIRE(EllipIntSecond(10.) == Approx(15574.46426).margin(1e-10));
-}
\ No newline at end of file
+}
+TEST_CASE("Check parallel line processing", "[utility]")
+{
+  using namespace BSMPT;
+  std::stringstream input;
+  for (int i = 2; i <= 200; i++)
+  {
+    input << i << "\n";
+  }
+
+  for (std::size_t threads : {1, 4})
+  {
+    input.clear();
+    input.seekg(0);
+    std::vector<int> lines;
+    std::vector<std::string> results;
+    std::atomic<std::size_t> running{0}, maxRunning{0};
+    ProcessLinesParallel<std::string>(
+        input,
+        2,
+        10,
+        150,
+        threads,
+        [&]() -> std::function<std::string(int, const std::string &)>
+        {
+          return [&](int line, const std::string &linestr)
+          {
+            auto now = ++running;
+            auto max = maxRunning.load();
+            while (now > max and not maxRunning.compare_exchange_weak(max, now))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(line % 7));
+            running--;
+            return std::to_string(line) + ":" + linestr;
+          };
+        },
+        [&](int line, std::string &&result)
+        {
+          lines.push_back(line);
+          results.push_back(result);
+        });
+    REQUIRE(lines.size() == 141);
+    REQUIRE(maxRunning.load() <= threads);
+    for (std::size_t i = 0; i < lines.size(); i++)
+    {
+      REQUIRE(lines.at(i) == static_cast<int>(i) + 10);
+      REQUIRE(results.at(i) == std::to_string(lines.at(i)) + ":" +
+                                   std::to_string(lines.at(i)));
+    }
+  }
+}
+
+TEST_CASE("Check error in parallel line processing", "[utility]")
+{
+  using namespace BSMPT;
+  std::stringstream input;
+  for (int i = 2; i <= 100; i++)
+  {
+    input << i << "\n";
+  }
+  auto Processor = []() -> std::function<int(int, const std::string &)>
+  {
+    return [](int line, const std::string &)
+    {
+      if (line == 42) throw std::runtime_error("Failed line");
+      return line;
+    };
+  };
+  REQUIRE_THROWS_AS(ProcessLinesParallel<int>(
+                        input, 2, 2, 100, 4, Processor, [](int, int &&) {}),
+                    std::runtime_error);
+}
+
+TEST_CASE("Check nested task groups of the thread pool", "[utility]")
+{
+  using namespace BSMPT;
+  for (int concurrency : {1, 4})
+  {
+    ThreadPool pool(concurrency);
+    REQUIRE(pool.GetConcurrency() == static_cast<std::size_t>(concurrency));
+
+    std::vector<std::thread::id> ids(1000);
+    std::vector<int> results(1000, 0);
+    TaskGroup outer(pool);
+    for (int i = 0; i < 10; i++)
+    {
+      outer.Run(
+          [&, i]()
+          {
+            TaskGroup inner(pool);
+            for (int j = 0; j < 100; j++)
+            {
+              inner.Run(
+                  [&, i, j]()
+                  {
+                    results.at(100 * i + j) = 100 * i + j;
+                    ids.at(100 * i + j)     = std::this_thread::get_id();
+                  });
+            }
+            inner.Wait();
+          });
+    }
+    outer.Wait();
+
+    std::sort(ids.begin(), ids.end());
+    const auto NumberOfIds = static_cast<std::size_t>(
+        std::unique(ids.begin(), ids.end()) - ids.begin());
+    REQUIRE(NumberOfIds <= pool.GetConcurrency());
+    for (int i = 0; i < 1000; i++)
+    {
+      REQUIRE(results.at(i) == i);
+    }
+  }
+}
+
+TEST_CASE("Check error in task group of the thread pool", "[utility]")
+{
+  using namespace BSMPT;
+  ThreadPool pool(4);
+  std::atomic<int> finished{0};
+  TaskGroup group(pool);
+  for (int i = 0; i < 50; i++)
+  {
+    group.Run(
+        [&, i]()
+        {
+          if (i == 17) throw std::runtime_error("Failed task");
+          finished++;
+        });
+  }
+  REQUIRE_THROWS_AS(group.Wait(), std::runtime_error);
+  REQUIRE(finished.load() == 49);
+
+  // the group can be reused after the error
+  group.Run([&]() { finished++; });
+  REQUIRE_NOTHROW(group.Wait());
+  REQUIRE(finished.load() == 50);
+}
+
+TEST_CASE("Check counters and stage timers of the profiler", "[utility]")
+{
+  using namespace BSMPT;
+  using Profiler::Counter;
+  using Profiler::Stage;
+  Profiler::Reset();
+  {
+    Profiler::ScopedTimer Timer(Stage::Bounce);
+    Profiler::Count(Counter::VEff);
+    Profiler::Count(Counter::VEff);
+    {
+      // Nested entries of the same stage are not timed twice
+      Profiler::ScopedTimer Nested(Stage::Bounce);
+      Profiler::Count(Counter::VEffGradient);
+    }
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    for (int i = 0; i < 10; i++)
+    {
+      group.Run([]() { Profiler::Count(Counter::HiggsMassesSquared); });
+    }
+    group.Wait();
+    Profiler::Count(Counter::CalculateDebye);
+  }
+  REQUIRE(Profiler::GetCurrentStage() == Stage::Other);
+  Profiler::Count(Counter::VEff);
+
+  const auto profile  = Profiler::GetProfile();
+  const auto bounce   = static_cast<std::size_t>(Stage::Bounce);
+  const auto other    = static_cast<std::size_t>(Stage::Other);
+  const auto veff     = static_cast<std::size_t>(Counter::VEff);
+  const auto gradient = static_cast<std::size_t>(Counter::VEffGradient);
+  const auto debye    = static_cast<std::size_t>(Counter::CalculateDebye);
+  REQUIRE(profile.Counts.at(bounce).at(veff) == 2);
+  REQUIRE(profile.Counts.at(bounce).at(gradient) == 1);
+  REQUIRE(profile.Counts.at(bounce).at(debye) == 1);
+  REQUIRE(profile.Counts.at(other).at(veff) == 1);
+  REQUIRE(profile.Entries.at(bounce) == 1);
+  REQUIRE(profile.Seconds.at(bounce) >= 0);
+
+  // The tasks only inherit the stage of the submitting thread if the profiling
+  // is enabled, otherwise it depends on the thread running them
+  const auto masses = static_cast<std::size_t>(Counter::HiggsMassesSquared);
+  REQUIRE(profile.Counts.at(bounce).at(masses) +
+              profile.Counts.at(other).at(masses) ==
+          10);
+  if (Profiler::IsEnabled())
+  {
+    REQUIRE(profile.Counts.at(bounce).at(masses) == 10);
+  }
+
+  const auto json = Profiler::GetJSON(profile);
+  REQUIRE(json.find("\"Bounce\": {\"Entries\": 1") != std::string::npos);
+  REQUIRE(Profiler::GetReport(profile).find("GravitationalWaves") !=
+          std::string::npos);
+
+  Profiler::Reset();
+  REQUIRE(Profiler::GetProfile().Counts.at(bounce).at(veff) == 0);
+}